@@ -0,0 +1,86 @@
+"""
+Plots the output of ambrosia_simulate like balancing.py plotted its model:
+    - wins-<strategy>.png: the rounds taken by every game of a batch, yellow for victories and purple for defeats
+    - <strategy>-<result>.png: the HP of the players and the Potato at the start of every round of one game,
+      and the skill each of them used in that round
+
+Usage: python plot.py <simulator output directory> [batch]
+The plots are written to the current directory, with the names used by balancing.md.
+"""
+import csv
+import os
+import sys
+
+import matplotlib
+matplotlib.use("Agg")
+import matplotlib.pyplot as plt
+
+# The names of the old script's plots
+PLOT_NAMES = {"random": "random", "strategic": "strategic1", "super-strategic": "strategic2"}
+PLAYERS = ["raoul", "ember", "taji", "chia"]
+
+
+def read_csv(path):
+    with open(path, newline="") as file:
+        return list(csv.DictReader(file))
+
+
+def plot_wins(games, policy, batch):
+    games = [game for game in games if game["policy"] == policy and int(game["batch"]) == batch]
+    if not games:
+        return
+
+    fig, plot = plt.subplots()
+    plot.scatter([int(game["game"]) for game in games], [int(game["rounds"]) for game in games], s=100,
+                 c=[1 if game["result"] == "victory" else 0 for game in games], vmin=0, vmax=1)
+    plot.set_xlabel("Game")
+    plot.set_ylabel("Rounds Taken")
+    fig.tight_layout()
+    fig.savefig(f"wins-{PLOT_NAMES.get(policy, policy)}.png")
+    plt.close(fig)
+
+
+def plot_game(games, rounds, policy, batch):
+    rounds = [row for row in rounds if row["policy"] == policy and int(row["batch"]) == batch]
+    if not rounds:
+        return
+    game = rounds[0]["game"]
+    rounds = [row for row in rounds if row["game"] == game]
+    result = next(row["result"] for row in games
+                  if row["policy"] == policy and int(row["batch"]) == batch and row["game"] == game)
+
+    # The Potato's name has its entity id after it, unlike the players'
+    names = PLAYERS + sorted({row["entity"] for row in rounds if row["entity"].startswith("potato#")})
+    fig, hpplot = plt.subplots()
+    skillplot = hpplot.twinx()
+    for name in names:
+        rows = [row for row in rounds if row["entity"] == name]
+        if not rows:
+            continue
+        label = name.split("#")[0].capitalize()
+        hpplot.plot([int(row["round"]) for row in rows], [float(row["hp"]) for row in rows], label=label)
+        used = [row for row in rows if 0 < int(row["skill"]) <= 4]
+        skillplot.scatter([int(row["round"]) for row in used], [int(row["skill"]) for row in used], label=label)
+
+    hpplot.set_xlabel("Round")
+    hpplot.set_ylabel("HP")
+    hpplot.legend()
+    skillplot.set_ylabel("Skill")
+    skillplot.set_ylim(0.5, 4.5)
+    fig.tight_layout()
+    fig.savefig(f"{PLOT_NAMES.get(policy, policy)}-{result}.png")
+    plt.close(fig)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    directory = sys.argv[1]
+    batch = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+    games = read_csv(os.path.join(directory, "games.csv"))
+    rounds = read_csv(os.path.join(directory, "rounds.csv"))
+    for policy in sorted({game["policy"] for game in games}):
+        plot_wins(games, policy, batch)
+        plot_game(games, rounds, policy, batch)
@@ -5,14 +5,15 @@
 #include "physics/physics.hpp"
 #include "game/turn_system.hpp"
 #include "game/game_state_system.hpp"
+#include "replay/input_replay.hpp"
 
 #include <iostream>
 
 AISystem::AISystem(PathFindingSystem& pfs)
 	: pathFindingSystem(pfs)
 {
-	// Seeding rng with random device
-	rng = std::default_random_engine(std::random_device()());
+	// Seeding rng with random device, or with the seed of the recorded session
+	rng = std::default_random_engine(InputReplay::instance().seedFor("ai"));
 
 	startMobMoveListener = EventSystem<StartMobMoveEvent>::instance().registerListener(
 		std::bind(&AISystem::onStartMobMoveEvent, this, std::placeholders::_1));
@@ -53,7 +54,7 @@ bool AISystem::setTargetToClosestPlayer(ECS::Entity & mob)
 	auto& mobComponent = mob.get<MobComponent>();
 	auto& mobMotion = mob.get<Motion>();
 
-	auto& playerContainer = ECS::registry<PlayerComponent>;
+	auto& playerContainer = ECS::registry<PlayerComponent>();
 	// There should always be at least one player in a game
 	assert(!playerContainer.entities.empty());
 
@@ -91,7 +92,7 @@ bool AISystem::setTargetToFarthestPlayer(ECS::Entity& mob)
 	auto& mobComponent = mob.get<MobComponent>();
 	auto& mobMotion = mob.get<Motion>();
 
-	auto& playerContainer = ECS::registry<PlayerComponent>;
+	auto& playerContainer = ECS::registry<PlayerComponent>();
 	// There should always be at least one player in a game
 	assert(!playerContainer.entities.empty());
 
@@ -128,7 +129,7 @@ bool AISystem::setTargetToWeakestPlayer(ECS::Entity& mob)
 	assert(mob.has<MobComponent>());
 	auto& mobComponent = mob.get<MobComponent>();
 
-	auto& playerContainer = ECS::registry<PlayerComponent>;
+	auto& playerContainer = ECS::registry<PlayerComponent>();
 	// There should always be at least one player in a game
 	assert(!playerContainer.entities.empty());
 
@@ -161,7 +162,7 @@ bool AISystem::setTargetToRandomPlayer(ECS::Entity& mob)
 	assert(mob.has<MobComponent>());
 	auto& mobComponent = mob.get<MobComponent>();
 
-	auto& playerContainer = ECS::registry<PlayerComponent>;
+	auto& playerContainer = ECS::registry<PlayerComponent>();
 	assert(!playerContainer.entities.empty());
 
 	std::vector<ECS::Entity> playerEntities(playerContainer.entities);
@@ -186,7 +187,7 @@ bool AISystem::setTargetToWeakestMob(ECS::Entity& mob)
 	assert(mob.has<MobComponent>());
 	auto& mobComponent = mob.get<MobComponent>();
 
-	auto& mobContainer = ECS::registry<MobComponent>;
+	auto& mobContainer = ECS::registry<MobComponent>();
 	// When called, there should always be current active mob and one ally
 	assert(mobContainer.entities.size() > 1);
 
@@ -221,7 +222,7 @@ bool AISystem::setTargetToDeadPotato(ECS::Entity& mob)
 	auto& mobComponent = mob.get<MobComponent>();
 
 	//// set target as dead potato
-	mobComponent.setTarget(ECS::registry<ActivePotatoChunks>.get(mob).potato);
+	mobComponent.setTarget(ECS::registry<ActivePotatoChunks>().get(mob).potato);
 	ECS::Entity target = mobComponent.getTarget();
 
 	return true;
@@ -4,12 +4,32 @@
 #include "game/game_state_system.hpp"
 #include "swarm_behaviour.hpp"
 #include "ai/ai.hpp"
+#include "replay/input_replay.hpp"
+
+#include <random>
 
 const float MOB_LOW_HEALTH = 25.f;
 
+namespace
+{
+	// The random skill choices of the mobs of a world. Unlike rand(), which the game's particles also
+	// draw from, it only depends on the seed of the session, so that replays pick the same skills.
+	struct SkillChoices
+	{
+		std::default_random_engine rng{ InputReplay::instance().seedFor("behaviour tree") };
+	};
+
+	// A skill index below numSkills
+	int randomSkill(int numSkills)
+	{
+		auto& rng = ECS::World::current().resource<SkillChoices>().rng;
+		return std::uniform_int_distribution<int>(0, numSkills - 1)(rng);
+	}
+}
+
 void StateSystem::onStartMobTurnEvent()
 {
-	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 	assert(mob.has<BehaviourTreeType>());
 	auto mobBTreeType = mob.get<BehaviourTreeType>().mobType;
 
@@ -60,6 +80,12 @@ void StateSystem::step(float elapsed_ms)
 	if (!GameStateSystem::instance().inGameState()) {
 		return;
 	}
+	// A mob can die during its own turn (e.g. potato chunks merging), then the turn moves on without it
+	auto& activeEntities = ECS::registry<TurnSystem::TurnComponentIsActive>().entities;
+	if (activeTree != nullptr && (activeEntities.empty() || !activeEntities[0].has<BehaviourTreeType>()))
+	{
+		activeTree = nullptr;
+	}
 	if (activeTree != nullptr && activeTree->root != nullptr)
 	{
 		if (activeTree->root->getStatus() == Status::INVALID)
@@ -279,7 +305,7 @@ PotatoSkillSelector::PotatoSkillSelector()
 void PotatoSkillSelector::run()
 {
 	Node::run();
-	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 	auto& mobStats = mob.get<StatsComponent>();
 	float hp = mobStats.getStatValue(StatType::HP);
 	float maxHP = mobStats.getStatValue(StatType::MAX_HP);
@@ -332,7 +358,7 @@ EggMoveSelector::EggMoveSelector()
 void EggMoveSelector::run()
 {
 	Node::run();
-	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 	float hp = mob.get<StatsComponent>().getStatValue(StatType::HP);
 	std::shared_ptr<Node> moveToClosestPlayer = children.front();
 	std::shared_ptr<Node> runAway = children.back();
@@ -360,7 +386,7 @@ void PepperMoveSelector::run()
 	Node::run(); 
 	std::shared_ptr<Node> moveToWeakestPlayer = children.front();
 	std::shared_ptr<Node> moveToFarthestPlayer = children.back();
-	auto& players = ECS::registry<PlayerComponent>.entities;
+	auto& players = ECS::registry<PlayerComponent>().entities;
 	bool weakPlayerExists = false;
 	for (ECS::Entity player : players)
 	{
@@ -382,7 +408,7 @@ void PepperMoveSelector::run()
 
 MilkMoveConditional::MilkMoveConditional()
 {
-	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 	float hp = mob.get<StatsComponent>().getStatValue(StatType::HP);
 	setConditional(std::make_shared<RunAwayTask>(RunAwayTask()), hp < MOB_LOW_HEALTH);
 }
@@ -395,10 +421,10 @@ void MilkMoveConditional::run()
 
 PotatoChunkMoveConditional::PotatoChunkMoveConditional()
 {
-	ECS::Entity chunk = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
-	auto chunk_pos = ECS::registry<Motion>.get(chunk).position;
-	auto potato = ECS::registry<ActivePotatoChunks>.get(chunk).potato;
-	auto potato_pos = ECS::registry<Motion>.get(potato).position;
+	ECS::Entity chunk = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
+	auto chunk_pos = ECS::registry<Motion>().get(chunk).position;
+	auto potato = ECS::registry<ActivePotatoChunks>().get(chunk).potato;
+	auto potato_pos = ECS::registry<Motion>().get(potato).position;
 
 	// get grid positions
 	auto chunk_grid_pos = vec2(round(chunk_pos.x / 32), round(chunk_pos.y / 32));
@@ -426,7 +452,7 @@ void MilkSkillSelector::run()
 	std::shared_ptr<Node> healMob = children.front();
 	std::shared_ptr<Node> attackPlayer = children.back();
 	bool shouldHeal = false;
-	auto& entities = ECS::registry<TurnSystem::TurnComponent>.entities;
+	auto& entities = ECS::registry<TurnSystem::TurnComponent>().entities;
 	for (ECS::Entity entity : entities)
 	{
 		auto& allyStats = entity.get<StatsComponent>();
@@ -454,7 +480,7 @@ MeleeSkillSelector::MeleeSkillSelector()
 
 void MeleeSkillSelector::run()
 {
-	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	ECS::Entity mob = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 	assert(mob.has<AISystem::MobComponent>() && mob.has<Motion>());
 	auto& mobM = mob.get<Motion>();
 
@@ -591,7 +617,7 @@ void MoveToClosestPlayerTask::run()
 		taskCompletedListener = EventSystem<FinishedMovementEvent>::instance().registerListener(
 			std::bind(&MoveToClosestPlayerTask::onFinishedTaskEvent, this));
 		StartMobMoveEvent event;
-		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		event.movement.moveType = MoveType::TO_CLOSEST_PLAYER;
 		EventSystem<StartMobMoveEvent>::instance().sendEvent(event);
 	}
@@ -606,7 +632,7 @@ void MoveToFarthestPlayerTask::run()
 		taskCompletedListener = EventSystem<FinishedMovementEvent>::instance().registerListener(
 			std::bind(&MoveToFarthestPlayerTask::onFinishedTaskEvent, this));
 		StartMobMoveEvent event;
-		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		event.movement.moveType = MoveType::TO_FARTHEST_PLAYER;
 		EventSystem<StartMobMoveEvent>::instance().sendEvent(event);
 	}
@@ -622,7 +648,7 @@ void MoveToWeakestPlayerTask::run()
 		taskCompletedListener = EventSystem<FinishedMovementEvent>::instance().registerListener(
 			std::bind(&MoveToWeakestPlayerTask::onFinishedTaskEvent, this));
 		StartMobMoveEvent event;
-		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		event.movement.moveType = MoveType::TO_WEAKEST_PLAYER;
 		EventSystem<StartMobMoveEvent>::instance().sendEvent(event);
 	}
@@ -638,7 +664,7 @@ void MoveToRandomPlayerTask::run()
 		taskCompletedListener = EventSystem<FinishedMovementEvent>::instance().registerListener(
 			std::bind(&MoveToRandomPlayerTask::onFinishedTaskEvent, this));
 		StartMobMoveEvent event;
-		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		event.movement.moveType = MoveType::TO_RANDOM_PLAYER;
 		EventSystem<StartMobMoveEvent>::instance().sendEvent(event);
 	}
@@ -653,7 +679,7 @@ void MoveToDeadPotato::run()
 		taskCompletedListener = EventSystem<FinishedMovementEvent>::instance().registerListener(
 			std::bind(&MoveToDeadPotato::onFinishedTaskEvent, this));
 		StartMobMoveEvent event;
-		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		event.movement.moveType = MoveType::TO_DEAD_POTATO;
 		EventSystem<StartMobMoveEvent>::instance().sendEvent(event);
 	}
@@ -669,7 +695,7 @@ void MoveToWeakestMobTask::run()
 		taskCompletedListener = EventSystem<FinishedMovementEvent>::instance().registerListener(
 			std::bind(&MoveToWeakestMobTask::onFinishedTaskEvent, this));
 		StartMobMoveEvent event;
-		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		event.movement.moveType = MoveType::TO_WEAKEST_MOB;
 		EventSystem<StartMobMoveEvent>::instance().sendEvent(event);
 	}
@@ -684,7 +710,7 @@ void RunAwayTask::run()
 		taskCompletedListener = EventSystem<FinishedMovementEvent>::instance().registerListener(
 			std::bind(&RunAwayTask::onFinishedTaskEvent, this));
 		StartMobMoveEvent event;
-		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		event.entity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		event.movement.moveType = MoveType::AWAY_CLOSEST_PLAYER;
 		EventSystem<StartMobMoveEvent>::instance().sendEvent(event);
 	}
@@ -701,7 +727,7 @@ void BasicAttackTask::run()
 		taskCompletedListener = EventSystem<FinishedSkillEvent>::instance().registerListener(
 			std::bind(&BasicAttackTask::onFinishedTaskEvent, this));
 
-		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		SetActiveSkillEvent activeEvent;
 		activeEvent.entity = activeEntity;
 		auto& mobType = activeEntity.get<BehaviourTreeType>().mobType;
@@ -739,7 +765,7 @@ void UltimateAttackTask::run()
 		Node::run();
 		taskCompletedListener = EventSystem<FinishedSkillEvent>::instance().registerListener(
 			std::bind(&UltimateAttackTask::onFinishedTaskEvent, this));
-		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		SetActiveSkillEvent activeEvent;
 		activeEvent.entity = activeEntity;
 		
@@ -773,7 +799,7 @@ void RangedAttackTask::run()
 		Node::run();
 		taskCompletedListener = EventSystem<FinishedSkillEvent>::instance().registerListener(
 			std::bind(&RangedAttackTask::onFinishedTaskEvent, this));
-		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		SetActiveSkillEvent activeEvent;
 		activeEvent.entity = activeEntity;
 		auto& mobType = activeEntity.get<BehaviourTreeType>().mobType;
@@ -805,14 +831,14 @@ void RngAttackTask::run()
 		Node::run();
 		taskCompletedListener = EventSystem<FinishedSkillEvent>::instance().registerListener(
 			std::bind(&RngAttackTask::onFinishedTaskEvent, this));
-		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		SetActiveSkillEvent activeEvent;
 		activeEvent.entity = activeEntity;
 		auto& mobType = activeEntity.get<BehaviourTreeType>().mobType;
 
 		if (mobType == MobType::SALTNPEPPER)
 		{
-			int skill = rand() % 2; // 0 or 1
+			int skill = randomSkill(2); // 0 or 1
 			if (skill == 0)
 			{
 				std::cout << "Attacking with randomly chosen skill 1\n";
@@ -826,7 +852,7 @@ void RngAttackTask::run()
 		}
 		else if (mobType == MobType::CHICKEN)
 		{
-			int skill = rand() % 3; // 0 to 2
+			int skill = randomSkill(3); // 0 to 2
 			if (skill == 0) // 33% chance of activating Strength Buff
 			{
 				std::cout << "Using big strength buff\n";
@@ -864,7 +890,7 @@ void HealTask::run()
 		Node::run();
 		taskCompletedListener = EventSystem<FinishedSkillEvent>::instance().registerListener(
 			std::bind(&HealTask::onFinishedTaskEvent, this));
-		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+		ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 		SetActiveSkillEvent activeEvent;
 		activeEvent.entity = activeEntity;
 		auto& mobType = activeEntity.get<BehaviourTreeType>().mobType;
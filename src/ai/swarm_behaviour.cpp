@@ -4,6 +4,7 @@
 #include "maps/map.hpp"
 #include "game/stats_system.hpp"
 
+#include <climits>
 #include <math.h>
 #include <iostream>
 #include <maps/path_finding_system.hpp>
@@ -16,7 +17,7 @@ vec2 getWorldPosition(vec2 gridPosition, MapComponent map) {
 }
 // simple way of getting the closest point in the grid
 vec2 getClosestValidPoint(vec2 point) {
-	auto map = ECS::registry<MapComponent>.components.front();
+	auto map = ECS::registry<MapComponent>().components.front();
 	vec2 grid_point = vec2(floor(point.x / map.tileSize), floor(point.y / map.tileSize));
 
 	float min_displacement = INT_MAX;
@@ -41,7 +42,7 @@ vec2 getClosestValidPoint(vec2 point) {
 
 std::vector<vec2> getPointsAroundCentre(int radius, vec2 centre, int totalPoints) {
 	float theta = 6.28318530718 / totalPoints;
-	auto map = ECS::registry<MapComponent>.components.front();
+	auto map = ECS::registry<MapComponent>().components.front();
 
 	vector<vec2> res;
 	PathFindingSystem pathFindingSystem;
@@ -71,8 +72,8 @@ std::vector<vec2> getPointsAroundCentre(int radius, vec2 centre, int totalPoints
 void SwarmBehaviour::spawnExplodedChunks(ECS::Entity potato)
 {
 	std::cout << "Spawning potato chunks";
-	auto potato_pos = ECS::registry<Motion>.get(potato).position;
-	auto map = ECS::registry<MapComponent>.components.front();
+	auto potato_pos = ECS::registry<Motion>().get(potato).position;
+	auto map = ECS::registry<MapComponent>().components.front();
 	auto points = getPointsAroundCentre(200, potato_pos, num_chunks);
 
 	for (int i = 0; i < num_chunks; i++) {
@@ -87,16 +88,16 @@ void SwarmBehaviour::startWait(ECS::Entity potato) {
 
 void SwarmBehaviour::step(float elapsed_ms, vec2 window_size_in_game_units) {
 
-	auto chunks = ECS::registry<ActivePotatoChunks>.entities;
+	auto chunks = ECS::registry<ActivePotatoChunks>().entities;
 
 	// chunks exist, and arent currently dying
-	if (chunks.size() > 0 && !ECS::registry<DeathTimer>.has(chunks[0])) {
-		auto potato = ECS::registry<ActivePotatoChunks>.get(chunks[0]).potato;
-		auto potato_pos = ECS::registry<Motion>.get(potato).position;
+	if (chunks.size() > 0 && !ECS::registry<DeathTimer>().has(chunks[0])) {
+		auto potato = ECS::registry<ActivePotatoChunks>().get(chunks[0]).potato;
+		auto potato_pos = ECS::registry<Motion>().get(potato).position;
 
 		// check if all chunks are within some distance d from potato;
 		for (auto chunk : chunks) {
-			auto chunk_pos = ECS::registry<Motion>.get(chunk).position;
+			auto chunk_pos = ECS::registry<Motion>().get(chunk).position;
 			// if not, return
 			if (!(chunk_pos.x < potato_pos.x + 50 &&
 				chunk_pos.y < potato_pos.y + 50 &&
@@ -109,7 +110,7 @@ void SwarmBehaviour::step(float elapsed_ms, vec2 window_size_in_game_units) {
 		auto remaining_hp = 0.f;
 		for (auto chunk : chunks) {
 			remaining_hp += chunk.get<StatsComponent>().getStatValue(StatType::HP);
-			ECS::registry<DeathTimer>.emplace(chunk).CustomDeathTimer(100.f);
+			ECS::registry<DeathTimer>().emplace(chunk).CustomDeathTimer(100.f);
 		}
 
 		auto mashed_potato_hp = remaining_hp / max_hp;
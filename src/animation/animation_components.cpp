@@ -1,9 +1,22 @@
 #pragma once
 #include "animation_components.hpp"
+#include "animation_loader.hpp"
+#include "rendering/resource_manager.hpp"
+
+AnimationClip::AnimationClip(const std::string& key, const std::string& path, int animNumFrames, int animDelay, bool animHasExitTime, bool animIsCycle, vec2 animOffset)
+	: textureId(internResource(key))
+	, path(path)
+	, hasExitTime(animHasExitTime)
+	, isCycle(animIsCycle)
+	, numFrames(animNumFrames)
+	, delay(animDelay)
+	, offset(animOffset)
+{
+	assert(animNumFrames > 0);
+}
 
 AnimationData::AnimationData()
 {
-	texture_key = "static";
 	hasExitTime = false;
 	isCycle = true;
 	numFrames = 1;
@@ -11,13 +24,29 @@ AnimationData::AnimationData()
 	delay = 3;
 	delayTimer = delay;
 	offset = vec2(0.f);
+	clip = nullptr;
 }
 
-AnimationData::AnimationData(const std::string& key, const std::string& path, int animNumFrames, int animDelay, bool animHasExitTime, bool animIsCycle, vec2 animOffset)
+AnimationData::AnimationData(const AnimationClip& clip)
 {
-	assert(animNumFrames > 0);
+	textureId = clip.textureId;
+	hasExitTime = clip.hasExitTime;
+	isCycle = clip.isCycle;
+	numFrames = clip.numFrames;
+	currFrame = 0;
+	delay = clip.delay;
+	delayTimer = delay;
+	offset = clip.offset;
+	this->clip = &clip;
+
+	// Record the group being created now, since the frames may only be loaded much later
+	ResourceManager::instance().tag(textureId);
+	pollLoaded();
+}
 
-	texture_key = key;
+AnimationData::AnimationData(const std::string& key, const std::string& path, int animNumFrames, int animDelay, bool animHasExitTime, bool animIsCycle, vec2 animOffset)
+{
+	textureId = internResource(key);
 	hasExitTime = animHasExitTime;
 	isCycle = animIsCycle;
 	numFrames = animNumFrames;
@@ -25,25 +54,59 @@ AnimationData::AnimationData(const std::string& key, const std::string& path, in
 	delay = animDelay;
 	delayTimer = delay;
 	offset = animOffset;
+	clip = nullptr;
+
+	updateTexMeshCache(path);
+}
+
+void AnimationData::load()
+{
+	if (isLoaded())
+	{
+		return;
+	}
+
+	assert(clip);
+	AnimationLoader::instance().load(*clip);
+	mesh = ShadedMeshRef(textureId);
+}
+
+void AnimationData::prefetch()
+{
+	if (!isLoaded() && clip)
+	{
+		AnimationLoader::instance().prefetch(*clip);
+	}
+}
 
-	updateTexMeshCache(key, path);
+bool AnimationData::pollLoaded()
+{
+	if (!isLoaded() && clip && AnimationLoader::instance().isLoaded(*clip))
+	{
+		mesh = ShadedMeshRef(textureId);
+	}
+	return isLoaded();
 }
 
 AnimationsComponent::AnimationsComponent(AnimationType type, const std::shared_ptr<AnimationData>& anim)
 {
+	anim->load();
 	anims[type] = anim;
 	currentAnim = type;
 	currAnimData = anims[type];
-	referenceToCache = &cacheResource(anim->texture_key);
+	displayedAnimData = currAnimData;
+	referenceToCache = anim->mesh.reference_to_cache;
 }
 
 void AnimationsComponent::addAnimation(AnimationType type, const std::shared_ptr<AnimationData>& anim)
 {
 	if (anims.size() == 0)
 	{
+		anim->load();
 		currAnimData = anim;
+		displayedAnimData = anim;
 		currentAnim = type;
-		referenceToCache = &cacheResource(anim->texture_key);
+		referenceToCache = anim->mesh.reference_to_cache;
 	}
 	anims[type] = anim;
 }
@@ -61,8 +124,42 @@ void AnimationsComponent::changeAnimation(AnimationType newAnim)
 	currAnimData = anims.at(currentAnim);
 	currAnimData->currFrame = 0;
 
-	// point the mesh ref to the new texture
-	referenceToCache = &cacheResource(currAnimData->texture_key);
+	// point the mesh ref to the new texture, or keep showing the last frame until it's loaded
+	if (currAnimData->pollLoaded())
+	{
+		displayedAnimData = currAnimData;
+	}
+	else
+	{
+		currAnimData->prefetch();
+	}
+	referenceToCache = displayedAnimData->mesh.reference_to_cache;
+}
+
+void AnimationsComponent::prefetch(AnimationType type)
+{
+	auto it = anims.find(type);
+	if (it != anims.end())
+	{
+		it->second->prefetch();
+	}
+}
+
+void AnimationsComponent::prefetchAll()
+{
+	for (auto& anim : anims)
+	{
+		anim.second->prefetch();
+	}
+}
+
+void AnimationsComponent::updateDisplayedAnim()
+{
+	if (displayedAnimData != currAnimData && currAnimData->pollLoaded())
+	{
+		displayedAnimData = currAnimData;
+		referenceToCache = displayedAnimData->mesh.reference_to_cache;
+	}
 }
 
 AnimationType AnimationsComponent::getCurrAnim()
@@ -80,11 +177,12 @@ float AnimationsComponent::getCurrAnimProgress()
 	return 0.f;
 }
 
-void AnimationData::updateTexMeshCache(const std::string& key, const std::string& path)
+void AnimationData::updateTexMeshCache(const std::string& path)
 {
-	ShadedMesh& resource = cacheResource(key);
-	if (resource.effect.program.resource == 0)
+	ShadedMesh& resource = cacheResource(textureId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createAnimatedSprite(resource, numFrames, path, "animated_sprite");
 	}
+	mesh = ShadedMeshRef(textureId);
 }
\ No newline at end of file
@@ -6,9 +6,25 @@
 
 enum class AnimationType { STATIC, IDLE, MOVE, ATTACK1, ATTACK2, ATTACK3, HIT, DEFEAT, ACTIVE, INACTIVE, DISABLED, EFFECT };
 
+// Static description of an animation. Entity creators keep these as function-local statics,
+// so that the texture key is interned once and spawning doesn't build or hash any strings.
+// Clips are loaded lazily, so they have to outlive the AnimationData created from them.
+struct AnimationClip
+{
+	ResourceId textureId;
+	std::string path;
+	bool hasExitTime;
+	bool isCycle;
+	int numFrames;
+	int delay;
+	vec2 offset;
+
+	AnimationClip(const std::string& key, const std::string& path, int animNumFrames, int animDelay = 1, bool animHasExitTime = false, bool animIsCycle = true, vec2 animOffset = vec2(0.f));
+};
+
 struct AnimationData
 {
-	std::string texture_key;
+	ResourceId textureId;
 	bool hasExitTime;
 	bool isCycle;
 	int numFrames;
@@ -16,17 +32,31 @@ struct AnimationData
 	int delay;
 	int delayTimer;
 	vec2 offset;
+	ShadedMeshRef mesh; // empty until the clip is loaded
+	const AnimationClip* clip;
 
 	AnimationData();
+	// Doesn't load the clip's frames, see load() and prefetch()
+	AnimationData(const AnimationClip& clip);
+	// Loads the frames right away, for animations whose key is only known at runtime
 	AnimationData(const std::string& key, const std::string& path, int animNumFrames, int animDelay = 1, bool animHasExitTime = false, bool animIsCycle = true, vec2 animOffset = vec2(0.f));
-	void updateTexMeshCache(const std::string& key, const std::string& path);
+	void updateTexMeshCache(const std::string& path);
+
+	inline bool isLoaded() const { return mesh.reference_to_cache != nullptr; }
+	void load();
+	void prefetch();
+	// Picks up the mesh once a prefetch has completed, returns whether the clip is loaded
+	bool pollLoaded();
 };
 
+// Only the first animation is loaded up front. The others are loaded when the entity is about
+// to need them (see AnimationSystem), and until then the last loaded frame stays on screen.
 struct AnimationsComponent
 {
 	std::unordered_map<AnimationType, std::shared_ptr<AnimationData>> anims;
 	AnimationType currentAnim;
 	std::shared_ptr<AnimationData> currAnimData;
+	std::shared_ptr<AnimationData> displayedAnimData; // currAnimData once it's loaded
 	ShadedMesh* referenceToCache;
 
 	AnimationsComponent(AnimationType type, const std::shared_ptr<AnimationData>& anim);
@@ -34,4 +64,9 @@ struct AnimationsComponent
 	void changeAnimation(AnimationType newAnim);
 	AnimationType getCurrAnim();
 	float getCurrAnimProgress();
+
+	void prefetch(AnimationType type);
+	void prefetchAll();
+	// Switches to the current animation's frames once they're loaded
+	void updateDisplayedAnim();
 };
\ No newline at end of file
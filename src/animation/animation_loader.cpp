@@ -0,0 +1,161 @@
+#include "animation_loader.hpp"
+#include "rendering/image_cache.hpp"
+#include "rendering/resource_manager.hpp"
+#include "profiling/profiler.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+AnimationLoader::AnimationLoader()
+{
+	// The jobs decode into the ImageCache, so it has to outlive this loader
+	ImageCache::instance();
+	JobSystem::instance();
+}
+
+AnimationLoader::~AnimationLoader()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& entry : pending)
+	{
+		JobSystem::instance().wait(*entry.second.decoded);
+	}
+}
+
+void AnimationLoader::prefetch(const AnimationClip& clip)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (pending.count(clip.textureId.index) > 0 || failed.count(clip.textureId.index) > 0 || isLoaded(clip))
+	{
+		return;
+	}
+
+	if (synchronous)
+	{
+		// Failures are handled as a failed prefetch's, so the synchronous load when it's used reports it again
+		try
+		{
+			build(clip);
+		}
+		catch (...)
+		{
+			fail(clip, std::current_exception());
+		}
+		return;
+	}
+
+	PendingClip entry{ &clip, std::make_shared<JobCounter>(), std::make_shared<std::exception_ptr>() };
+	const std::string path = clip.path;
+	const int numFrames = clip.numFrames;
+	auto decoded = entry.decoded;
+	auto error = entry.error;
+	JobSystem::instance().submit([path, numFrames, decoded, error]() {
+		try
+		{
+			for (int i = 0; i < numFrames; ++i)
+			{
+				ImageCache::instance().load(Texture::framePath(path, i));
+			}
+		}
+		catch (...)
+		{
+			*error = std::current_exception();
+		}
+	}, entry.decoded.get());
+	pending.emplace(clip.textureId.index, std::move(entry));
+}
+
+void AnimationLoader::load(const AnimationClip& clip)
+{
+	PROFILE_SCOPE("load animation");
+	std::unique_lock<std::mutex> lock(mutex);
+	auto it = pending.find(clip.textureId.index);
+	if (it != pending.end())
+	{
+		auto decoded = it->second.decoded;
+		auto error = it->second.error;
+		pending.erase(it);
+
+		// Not locked while waiting, since the thread runs other jobs in the meantime
+		lock.unlock();
+		JobSystem::instance().wait(*decoded);
+		lock.lock();
+
+		// e.g. a missing frame. The synchronous load below reports it again, if it's still missing.
+		if (*error)
+		{
+			fail(clip, *error);
+		}
+	}
+	build(clip);
+}
+
+bool AnimationLoader::isLoaded(const AnimationClip& clip) const
+{
+	return ResourceManager::instance().isBuilt(clip.textureId);
+}
+
+void AnimationLoader::step()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto it = pending.begin(); it != pending.end();)
+	{
+		auto& entry = it->second;
+		if (!entry.decoded->isDone())
+		{
+			++it;
+			continue;
+		}
+
+		auto error = entry.error;
+		const AnimationClip& clip = *entry.clip;
+		it = pending.erase(it);
+		// Not fatal in the middle of a frame, the clip gets loaded synchronously when it's used
+		if (*error)
+		{
+			fail(clip, *error);
+			continue;
+		}
+		build(clip);
+	}
+}
+
+void AnimationLoader::setSynchronous(bool synchronous)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	this->synchronous = synchronous;
+}
+
+size_t AnimationLoader::numPending() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return pending.size();
+}
+
+void AnimationLoader::build(const AnimationClip& clip)
+{
+	PROFILE_SCOPE("build animation");
+	// The resource was tagged with its group when the AnimationData was created
+	ShadedMesh& resource = ResourceManager::instance().getDeferred(clip.textureId);
+	if (resource.effect.program == 0)
+	{
+		RenderSystem::createAnimatedSprite(resource, clip.numFrames, clip.path, "animated_sprite");
+	}
+}
+
+void AnimationLoader::fail(const AnimationClip& clip, const std::exception_ptr& error)
+{
+	failed.insert(clip.textureId.index);
+	try
+	{
+		std::rethrow_exception(error);
+	}
+	catch (const std::exception& exception)
+	{
+		std::cout << "AnimationLoader: failed to prefetch " << clip.path << ": " << exception.what() << std::endl;
+	}
+	catch (...)
+	{
+		std::cout << "AnimationLoader: failed to prefetch " << clip.path << std::endl;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "animation_components.hpp"
+#include "jobs/job_system.hpp"
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+// Loads animation clips on demand. Prefetched clips have their frames decoded by a JobSystem
+// worker (into the ImageCache), so that the main thread only has to upload the texture.
+// A prefetch that fails (e.g. a missing frame) is logged and not retried, the clip is then loaded
+// synchronously when it's used.
+//
+// The clips are shared by every ECS::World, so the loader is locked for battles simulated on other
+// threads. Whichever world's AnimationSystem steps first builds the clips that finished decoding.
+//
+// A synchronous loader loads prefetched clips right away instead, on the calling thread, e.g. for
+// ambrosia_bench, whose timings shouldn't depend on when a worker gets to decode the frames.
+class AnimationLoader
+{
+public:
+	// Returns the singleton instance of this loader
+	static AnimationLoader& instance()
+	{
+		static AnimationLoader animationLoader;
+		return animationLoader;
+	}
+
+	~AnimationLoader();
+
+	// Starts decoding the clip's frames in the background, unless it's already loaded or pending
+	void prefetch(const AnimationClip& clip);
+	// Loads the clip right away, waiting for a pending prefetch if there is one
+	void load(const AnimationClip& clip);
+	bool isLoaded(const AnimationClip& clip) const;
+
+	// Whether prefetch() loads the clip right away. Clips that are already pending keep loading in the background.
+	void setSynchronous(bool synchronous);
+
+	// Uploads the clips whose frames finished decoding, call once per frame
+	void step();
+	size_t numPending() const;
+
+private:
+	AnimationLoader();
+	AnimationLoader(const AnimationLoader&) = delete;
+	AnimationLoader& operator=(const AnimationLoader&) = delete;
+
+	// Called with the mutex held
+	void build(const AnimationClip& clip);
+	// Logs the error of a failed prefetch. Called with the mutex held.
+	void fail(const AnimationClip& clip, const std::exception_ptr& error);
+
+	struct PendingClip
+	{
+		const AnimationClip* clip;
+		std::shared_ptr<JobCounter> decoded;
+		std::shared_ptr<std::exception_ptr> error;
+	};
+	std::unordered_map<uint32_t, PendingClip> pending; // by texture id
+	std::unordered_set<uint32_t> failed; // by texture id
+	bool synchronous = false;
+	mutable std::mutex mutex;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "animation_system.hpp"
 #include "animation_components.hpp"
+#include "animation_loader.hpp"
 #include "game/game_state_system.hpp"
 
 AnimationSystem::AnimationSystem()
@@ -10,6 +11,12 @@ AnimationSystem::AnimationSystem()
 
 	prepForNextMapListener = EventSystem<PrepForNextMapEvent>::instance().registerListener(
 			std::bind(&AnimationSystem::onPrepForNextMapEvent, this, std::placeholders::_1));
+
+	playerChangeListener = EventSystem<PlayerChangeEvent>::instance().registerListener(
+			std::bind(&AnimationSystem::onPlayerChangeEvent, this, std::placeholders::_1));
+
+	setActiveSkillListener = EventSystem<SetActiveSkillEvent>::instance().registerListener(
+			std::bind(&AnimationSystem::onSetActiveSkillEvent, this, std::placeholders::_1));
 }
 
 AnimationSystem::~AnimationSystem()
@@ -22,6 +29,14 @@ AnimationSystem::~AnimationSystem()
 	{
 		EventSystem<PrepForNextMapEvent>::instance().unregisterListener(prepForNextMapListener);
 	}
+	if (playerChangeListener.isValid())
+	{
+		EventSystem<PlayerChangeEvent>::instance().unregisterListener(playerChangeListener);
+	}
+	if (setActiveSkillListener.isValid())
+	{
+		EventSystem<SetActiveSkillEvent>::instance().unregisterListener(setActiveSkillListener);
+	}
 }
 
 void AnimationSystem::updateOrientation(Motion& motion, const vec2 direction)
@@ -53,8 +68,11 @@ void AnimationSystem::updateOrientation(Motion& motion, const vec2 direction)
 // call this every frame
 void AnimationSystem::step()
 {
+	// upload the animations that finished loading in the background
+	AnimationLoader::instance().step();
+
 	// for each Animation component...
-	for (auto& entity : ECS::registry<AnimationsComponent>.entities)
+	for (auto& entity : ECS::registry<AnimationsComponent>().entities)
 	{
 		if (!entity.has<Motion>())
 		{
@@ -62,6 +80,7 @@ void AnimationSystem::step()
 		}
 
 		auto& anims = entity.get<AnimationsComponent>();
+		anims.updateDisplayedAnim();
 		// get the data for the current animation
 		std::shared_ptr<AnimationData>& currAnim = anims.currAnimData;
 
@@ -163,3 +182,37 @@ void AnimationSystem::onPrepForNextMapEvent(const PrepForNextMapEvent& event)
 		entity.get<AnimationsComponent>().changeAnimation(AnimationType::IDLE);
 	}
 }
+
+// The active entity is about to move and attack, so start loading the rest of its animations
+void AnimationSystem::onPlayerChangeEvent(const PlayerChangeEvent& event)
+{
+	auto entity = event.newActiveEntity;
+	if (entity.has<AnimationsComponent>())
+	{
+		entity.get<AnimationsComponent>().prefetchAll();
+	}
+}
+
+// Once a skill is selected, load its animation along with the reactions of whoever it may hit
+void AnimationSystem::onSetActiveSkillEvent(const SetActiveSkillEvent& event)
+{
+	auto entity = event.entity;
+	if (entity.has<AnimationsComponent>() && entity.has<SkillComponent>())
+	{
+		std::shared_ptr<Skill> skill = entity.get<SkillComponent>().getSkill(event.type);
+		if (skill)
+		{
+			entity.get<AnimationsComponent>().prefetch(skill->getAnimationType());
+		}
+	}
+
+	for (auto& other : ECS::registry<AnimationsComponent>().entities)
+	{
+		if (other.id != entity.id)
+		{
+			auto& anims = other.get<AnimationsComponent>();
+			anims.prefetch(AnimationType::HIT);
+			anims.prefetch(AnimationType::DEFEAT);
+		}
+	}
+}
@@ -21,7 +21,11 @@ public:
 private:
 	void onPerformSkillEvent(const PerformActiveSkillEvent& event);
 	void onPrepForNextMapEvent(const PrepForNextMapEvent& event);
+	void onPlayerChangeEvent(const PlayerChangeEvent& event);
+	void onSetActiveSkillEvent(const SetActiveSkillEvent& event);
 
 	EventListenerInfo performSkillListener;
 	EventListenerInfo prepForNextMapListener;
+	EventListenerInfo playerChangeListener;
+	EventListenerInfo setActiveSkillListener;
 };
@@ -3,6 +3,7 @@
 #include "effects/effect_system.hpp"
 #include "entities/enemies.hpp"
 #include "entities/tiny_ecs.hpp"
+#include "entities/command_buffer.hpp"
 #include "game/game_state_system.hpp"
 
 namespace
@@ -52,10 +53,10 @@ void EffectSystem::step() {
 		return;
 	}
 
-	for (int i = ECS::registry<SkillFXData>.entities.size() - 1; i >= 0; i--)
+	for (size_t i = 0; i < ECS::registry<SkillFXData>().entities.size(); i++)
 	{
-		auto fxEntity = ECS::registry<SkillFXData>.entities[i];
-		auto& fxData = ECS::registry<SkillFXData>.components[i];
+		auto fxEntity = ECS::registry<SkillFXData>().entities[i];
+		auto& fxData = ECS::registry<SkillFXData>().components[i];
 
 		// If the animation doesn't cycle, check whether it's done
 		if (!fxData.doesCycle && fxEntity.has<AnimationsComponent>())
@@ -64,7 +65,7 @@ void EffectSystem::step() {
 			auto& anim = fxEntity.get<AnimationsComponent>();
 			if (anim.getCurrAnim() != AnimationType::EFFECT || anim.getCurrAnimProgress() >= 1.f)
 			{
-				ECS::ContainerInterface::removeAllComponentsOf(fxEntity);
+				ECS::CommandBuffer::instance().destroy(fxEntity);
 				continue;
 			}
 		}
@@ -87,7 +88,7 @@ void EffectSystem::onStartFX(const StartFXEvent& event) {
 
 	if (event.fxType == FXType::BUFFED)
 	{
-		auto& fxEntities = ECS::registry<BuffedFX>.entities;
+		auto& fxEntities = ECS::registry<BuffedFX>().entities;
 		if (getFXEntity(fxEntities, refEntity) == fxEntities.end())
 		{
 			auto fxEntity = BuffedFX::createBuffedFX(refEntity, refMotion.position);
@@ -96,7 +97,7 @@ void EffectSystem::onStartFX(const StartFXEvent& event) {
 	}
 	else if (event.fxType == FXType::DEBUFFED)
 	{
-		auto& fxEntities = ECS::registry<DebuffedFX>.entities;
+		auto& fxEntities = ECS::registry<DebuffedFX>().entities;
 		if (getFXEntity(fxEntities, refEntity) == fxEntities.end())
 		{
 			auto fxEntity = DebuffedFX::createDebuffedFX(refEntity, refMotion.position);
@@ -105,14 +106,14 @@ void EffectSystem::onStartFX(const StartFXEvent& event) {
 	}
 	else if (event.fxType == FXType::HEALED)
 	{
-		findAndRemoveFX(ECS::registry<HealedFX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<HealedFX>().entities, refEntity);
 
 		auto fxEntity = HealedFX::createHealedFX(refEntity, refMotion.position);
 		setBuffedOffsetAndScale(fxEntity);
 	}
 	else if (event.fxType == FXType::SHIELDED)
 	{
-		auto& fxEntities = ECS::registry<ShieldedFX>.entities;
+		auto& fxEntities = ECS::registry<ShieldedFX>().entities;
 		if (getFXEntity(fxEntities, refEntity) == fxEntities.end())
 		{
 			auto fxEntity = ShieldedFX::createShieldedFX(refEntity, refMotion.position);
@@ -121,21 +122,21 @@ void EffectSystem::onStartFX(const StartFXEvent& event) {
 	}
 	else if (event.fxType == FXType::CANDY1)
 	{
-		findAndRemoveFX(ECS::registry<Candy1FX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<Candy1FX>().entities, refEntity);
 
 		auto fxEntity = Candy1FX::createCandy1FX(refEntity, refMotion.position);
 		setCandyOffset(fxEntity);
 	}
 	else if (event.fxType == FXType::CANDY2)
 	{
-		findAndRemoveFX(ECS::registry<Candy2FX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<Candy2FX>().entities, refEntity);
 
 		auto fxEntity = Candy2FX::createCandy2FX(refEntity, refMotion.position);
 		setCandyOffset(fxEntity);
 	}
 	else if (event.fxType == FXType::BLUEBERRIED)
 	{
-		findAndRemoveFX(ECS::registry<BlueberriedFX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<BlueberriedFX>().entities, refEntity);
 
 		auto fxEntity = BlueberriedFX::createBlueberriedFX(refEntity, refMotion.position);
 		setBlueberriedOffset(fxEntity);
@@ -144,7 +145,7 @@ void EffectSystem::onStartFX(const StartFXEvent& event) {
 	{
 		if (!refEntity.has<CCImmunityComponent>())
 		{
-			auto& fxEntities = ECS::registry<StunnedFX>.entities;
+			auto& fxEntities = ECS::registry<StunnedFX>().entities;
 			if (getFXEntity(fxEntities, refEntity) == fxEntities.end())
 			{
 				auto fxEntity = StunnedFX::createStunnedFX(refEntity, refMotion.position);
@@ -159,11 +160,11 @@ void EffectSystem::onStopFX(const StopFXEvent& event) {
 
 	if (event.fxType == FXType::BUFFED)
 	{
-		findAndRemoveFX(ECS::registry<BuffedFX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<BuffedFX>().entities, refEntity);
 	}
 	else if (event.fxType == FXType::DEBUFFED)
 	{
-		findAndRemoveFX(ECS::registry<DebuffedFX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<DebuffedFX>().entities, refEntity);
 	}
 	else if (event.fxType == FXType::HEALED)
 	{
@@ -171,7 +172,7 @@ void EffectSystem::onStopFX(const StopFXEvent& event) {
 	}
 	else if (event.fxType == FXType::SHIELDED)
 	{
-		findAndRemoveFX(ECS::registry<ShieldedFX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<ShieldedFX>().entities, refEntity);
 	}
 	else if (event.fxType == FXType::CANDY1)
 	{
@@ -187,7 +188,7 @@ void EffectSystem::onStopFX(const StopFXEvent& event) {
 	}
 	else if (event.fxType == FXType::STUNNED)
 	{
-		findAndRemoveFX(ECS::registry<StunnedFX>.entities, refEntity);
+		findAndRemoveFX(ECS::registry<StunnedFX>().entities, refEntity);
 	}
 }
 
@@ -1,35 +1,37 @@
 #include "effects.hpp"
 #include "animation/animation_components.hpp"
+#include "memory/level_arena.hpp"
 
 ECS::Entity MouseClickFX::createMouseClickFX()
 {
 	// There should only ever be one of this type of entity
 	while (!ECS::ComponentContainer<MouseClickFX>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<MouseClickFX>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<MouseClickFX>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
-	ShadedMesh& resource = cacheResource("mouseclick_static");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("mouseclick_static");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("mouseclick_fx/mouseclick_fx_005.png"), "textured");
 	}
 
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::CLICK_FX);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = vec2(0.f);
 	motion.angle = 0.f;
 	motion.velocity = vec2(0.f);
 	motion.scale = vec2(1.f);
 	motion.boundingBox = vec2(0.f);
 
-	auto effect_anim = AnimationData("fx_mouseclick", uiPath("mouseclick_fx/mouseclick_fx"), 12, 1, false, false);
-	AnimationsComponent& anims = entity.emplace<AnimationsComponent>(AnimationType::EFFECT, std::make_shared<AnimationData>(effect_anim));
+	static const AnimationClip effect_anim("fx_mouseclick", uiPath("mouseclick_fx/mouseclick_fx"), 12, 1, false, false);
+	AnimationsComponent& anims = entity.emplace<AnimationsComponent>(AnimationType::EFFECT, makeLevelShared<AnimationData>(effect_anim));
 	anims.currAnimData->currFrame = 11; // start with the animation finished
 
 	entity.emplace<MouseClickFX>();
@@ -42,14 +44,14 @@ ECS::Entity ActiveSkillFX::createActiveSkillFX()
 	// There should only ever be one of this type of entity
 	while (!ECS::ComponentContainer<ActiveSkillFX>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ActiveSkillFX>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ActiveSkillFX>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	std::string key = "fx_activeskill";
 	ShadedMesh& resource = cacheResource(key);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("skill_buttons/active_fx.png"), "dynamic_texture");
 	}
@@ -60,7 +62,7 @@ ECS::Entity ActiveSkillFX::createActiveSkillFX()
 	entity.emplace<ButtonStateComponent>(true, false);
 	entity.emplace<VisibilityComponent>().isVisible = true;
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = vec2(100, 1024 - 80);
 	motion.angle = 0.f;
 	motion.velocity = vec2(0.f);
@@ -75,10 +77,10 @@ ECS::Entity ActiveSkillFX::createActiveSkillFX()
 ECS::Entity commonInitFX(const std::string& key, const int numFrames, const bool doesCycle,
 												 ECS::Entity refEntity, vec2 position, vec2 scale)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource(key);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, fxPath(key + "/" + key + "_000.png"), "textured");
 	}
@@ -87,9 +89,9 @@ ECS::Entity commonInitFX(const std::string& key, const int numFrames, const bool
 	entity.emplace<SkillFXData>(refEntity, doesCycle);
 
 	auto effect_anim = AnimationData(key + "_anim", fxPath(key + "/" + key), numFrames, 1, false, doesCycle);
-	AnimationsComponent& anims = entity.emplace<AnimationsComponent>(AnimationType::EFFECT, std::make_shared<AnimationData>(effect_anim));
+	AnimationsComponent& anims = entity.emplace<AnimationsComponent>(AnimationType::EFFECT, makeLevelShared<AnimationData>(effect_anim));
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 	motion.scale = scale;
 
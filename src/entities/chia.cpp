@@ -7,34 +7,35 @@ void Chia::initialize(ECS::Entity entity)
 {
 	//////////////////////////////////////////////////////////////////////////////
 	// Create sprite
-	ShadedMesh& resource = cacheResource("chia_static");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("chia_static");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, spritePath("players/chia/chia_static.png"), "textured");
 	}
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Set up animations
-	auto idle_anim = AnimationData("chia_idle", spritePath("players/chia/idle/idle"), 61);
+	static const AnimationClip idle_anim("chia_idle", spritePath("players/chia/idle/idle"), 61);
 	auto& anims = entity.emplace<AnimationsComponent>(AnimationType::IDLE, std::make_shared<AnimationData>(idle_anim));
 
-	auto move_anim = AnimationData("chia_move", spritePath("players/chia/move/move"), 32);
+	static const AnimationClip move_anim("chia_move", spritePath("players/chia/move/move"), 32);
 	anims.addAnimation(AnimationType::MOVE, std::make_shared<AnimationData>(move_anim));
 
-	auto hit = AnimationData("chia_hit", spritePath("players/chia/hit/hit"), 34, 1, true, false);
+	static const AnimationClip hit("chia_hit", spritePath("players/chia/hit/hit"), 34, 1, true, false);
 	anims.addAnimation(AnimationType::HIT, std::make_shared<AnimationData>(hit));
 
-	auto defeat = AnimationData("chia_defeat", spritePath("players/chia/defeat/defeat"), 41, 1, true, false);
+	static const AnimationClip defeat("chia_defeat", spritePath("players/chia/defeat/defeat"), 41, 1, true, false);
 	anims.addAnimation(AnimationType::DEFEAT, std::make_shared<AnimationData>(defeat));
 
-	auto attack1 = AnimationData("chia_attack1", spritePath("players/chia/attack1/attack1"), 41, 1, true, false, vec2({ 0.08f, 0.f }));
+	static const AnimationClip attack1("chia_attack1", spritePath("players/chia/attack1/attack1"), 41, 1, true, false, vec2({ 0.08f, 0.f }));
 	anims.addAnimation(AnimationType::ATTACK1, std::make_shared<AnimationData>(attack1));
 
-	auto attack2 = AnimationData("chia_attack2", spritePath("players/chia/attack2/attack2"), 64, 1, true, false, vec2({ -0.f, 0.04f }));
+	static const AnimationClip attack2("chia_attack2", spritePath("players/chia/attack2/attack2"), 64, 1, true, false, vec2({ -0.f, 0.04f }));
 	anims.addAnimation(AnimationType::ATTACK2, std::make_shared<AnimationData>(attack2));
 
-	auto attack3 = AnimationData("chia_attack3", spritePath("players/chia/attack3/attack3"), 64, 1, true, false, vec2({ -0.f, 0.04f }));
+	static const AnimationClip attack3("chia_attack3", spritePath("players/chia/attack3/attack3"), 64, 1, true, false, vec2({ -0.f, 0.04f }));
 	anims.addAnimation(AnimationType::ATTACK3, std::make_shared<AnimationData>(attack3));
 
 	//////////////////////////////////////////////////////////////////////////////
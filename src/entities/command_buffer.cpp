@@ -0,0 +1,41 @@
+#include "command_buffer.hpp"
+
+using namespace ECS;
+
+void CommandBuffer::playback()
+{
+	// Components constructed during playback may record new commands, so don't hold on to iterators
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		Command command = std::move(commands[i]);
+		if (command.type == CommandType::DESTROY)
+		{
+			pendingDestroys.push_back(command.entity);
+			continue;
+		}
+
+		if (!pendingDestroys.empty())
+		{
+			ContainerInterface::removeAllComponentsOf(pendingDestroys);
+			pendingDestroys.clear();
+		}
+
+		if (EntityManager::isAlive(command.entity))
+		{
+			command.apply();
+		}
+	}
+
+	if (!pendingDestroys.empty())
+	{
+		ContainerInterface::removeAllComponentsOf(pendingDestroys);
+		pendingDestroys.clear();
+	}
+	commands.clear();
+}
+
+void CommandBuffer::clear()
+{
+	commands.clear();
+	pendingDestroys.clear();
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "tiny_ecs.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ECS {
+	// Records structural changes (creating and destroying entities, adding and removing components)
+	// so that they can be applied later, at a point where no system is iterating over the registries.
+	// The main loop plays back the shared instance() after every update step; every World has its own.
+	//
+	// Commands are applied in the order they were recorded. Consecutive destroys are applied as one
+	// batch (see ContainerInterface::removeAllComponentsOf). Commands that target an entity that has
+	// been destroyed in the meantime are dropped.
+	class CommandBuffer
+	{
+	public:
+		// Returns the buffer of the current World, for the main world the one played back by the main loop
+		static CommandBuffer& instance()
+		{
+			return World::current().resource<CommandBuffer>();
+		}
+
+		CommandBuffer() = default;
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+		// The id is reserved right away, so the new entity can be referenced by later commands
+		Entity create()
+		{
+			return Entity::create();
+		}
+
+		// The component is constructed now and moved into its container during playback
+		template<class Component, class... Args>
+		void emplace(Entity e, Args&&... args)
+		{
+			auto component = std::make_shared<Component>(std::forward<Args>(args)...);
+			commands.push_back({ CommandType::EMPLACE, e, [e, component]() {
+				registry<Component>().insert(e, std::move(*component));
+			} });
+		}
+
+		template<class Component>
+		void remove(Entity e)
+		{
+			commands.push_back({ CommandType::REMOVE, e, [e]() {
+				registry<Component>().remove(e);
+			} });
+		}
+
+		void destroy(Entity e)
+		{
+			commands.push_back({ CommandType::DESTROY, e, nullptr });
+		}
+
+		// Applies and clears the recorded commands. Commands recorded during playback are applied too.
+		void playback();
+
+		inline bool empty() const { return commands.empty(); }
+		inline size_t size() const { return commands.size(); }
+		void clear();
+
+	private:
+		enum class CommandType { EMPLACE, REMOVE, DESTROY };
+
+		struct Command
+		{
+			CommandType type;
+			Entity entity;
+			std::function<void()> apply;
+		};
+
+		std::vector<Command> commands;
+		std::vector<Entity> pendingDestroys;
+	};
+}
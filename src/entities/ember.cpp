@@ -7,34 +7,35 @@ void Ember::initialize(ECS::Entity entity)
 {
 	//////////////////////////////////////////////////////////////////////////////
 	// Create sprite
-	ShadedMesh& resource = cacheResource("ember_static");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("ember_static");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, spritePath("players/ember/ember_static.png"), "textured");
 	}
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Set up animations
-	auto idle_anim = AnimationData("ember_idle", spritePath("players/ember/idle/idle"), 60);
+	static const AnimationClip idle_anim("ember_idle", spritePath("players/ember/idle/idle"), 60);
 	auto& anims = entity.emplace<AnimationsComponent>(AnimationType::IDLE, std::make_shared<AnimationData>(idle_anim));
 
-	auto move_anim = AnimationData("ember_move", spritePath("players/ember/move/move"), 32);
+	static const AnimationClip move_anim("ember_move", spritePath("players/ember/move/move"), 32);
 	anims.addAnimation(AnimationType::MOVE, std::make_shared<AnimationData>(move_anim));
 
-	auto attack1 = AnimationData("ember_attack1", spritePath("players/ember/attack1/attack1"), 50, 1, true, false, vec2({ -0.02f, 0.37f }));
+	static const AnimationClip attack1("ember_attack1", spritePath("players/ember/attack1/attack1"), 50, 1, true, false, vec2({ -0.02f, 0.37f }));
 	anims.addAnimation(AnimationType::ATTACK1, std::make_shared<AnimationData>(attack1));
 
-	auto attack2 = AnimationData("ember_attack2", spritePath("players/ember/attack2/attack2"), 61, 1, true, false, vec2({ -0.02f, 0.37f }));
+	static const AnimationClip attack2("ember_attack2", spritePath("players/ember/attack2/attack2"), 61, 1, true, false, vec2({ -0.02f, 0.37f }));
 	anims.addAnimation(AnimationType::ATTACK2, std::make_shared<AnimationData>(attack2));
 
-	auto attack3 = AnimationData("ember_attack3", spritePath("players/ember/attack3/attack3"), 61, 1, true, false, vec2({ -0.02f, 0.3f }));
+	static const AnimationClip attack3("ember_attack3", spritePath("players/ember/attack3/attack3"), 61, 1, true, false, vec2({ -0.02f, 0.3f }));
 	anims.addAnimation(AnimationType::ATTACK3, std::make_shared<AnimationData>(attack3));
 
-	auto defeat = AnimationData("ember_defeat", spritePath("players/ember/defeat/defeat"), 57, 1, true, false, vec2({ -0.1f, 0.06f }));
+	static const AnimationClip defeat("ember_defeat", spritePath("players/ember/defeat/defeat"), 57, 1, true, false, vec2({ -0.1f, 0.06f }));
 	anims.addAnimation(AnimationType::DEFEAT, std::make_shared<AnimationData>(defeat));
 
-	auto hit = AnimationData("ember_hit", spritePath("players/ember/hit/hit"), 34, 1, true, false);
+	static const AnimationClip hit("ember_hit", spritePath("players/ember/hit/hit"), 34, 1, true, false);
 	anims.addAnimation(AnimationType::HIT, std::make_shared<AnimationData>(hit));
 
 	//////////////////////////////////////////////////////////////////////////////
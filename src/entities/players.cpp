@@ -6,6 +6,7 @@
 
 #include "rendering/render.hpp"
 #include "game/turn_system.hpp"
+#include "game/game_snapshot.hpp"
 #include "ui/ui_entities.hpp"
 
 namespace
@@ -19,8 +20,8 @@ namespace
 		auto& statsComponent = entity.get<StatsComponent>();
 
 		statsComponent.healthBar = HPBar::createHPBar({motion.position.x, motion.position.y - 225.0f});
-		ECS::registry<HPBar>.get(statsComponent.healthBar).offset = {0.0f,-225.0f};
-		ECS::registry<HPBar>.get(statsComponent.healthBar).statsCompEntity = entity;
+		ECS::registry<HPBar>().get(statsComponent.healthBar).offset = {0.0f,-225.0f};
+		ECS::registry<HPBar>().get(statsComponent.healthBar).statsCompEntity = entity;
 	}
 
 	void createMotion(PlayerType type, ECS::Entity entity, const json& configValues)
@@ -69,11 +70,15 @@ namespace
 
 ECS::Entity Player::create(PlayerType type, const json& configValues)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	entity.emplace<TurnSystem::TurnComponent>();
 	entity.emplace<PlayerComponent>().player = type;
 
+	auto& spawnOrigin = entity.emplace<SpawnOrigin>();
+	spawnOrigin.kind = SpawnOrigin::Kind::PLAYER;
+	spawnOrigin.index = static_cast<uint32_t>(type);
+
 	if (type == PlayerType::RAOUL)
 	{
 		Raoul::initialize(entity);
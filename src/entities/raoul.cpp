@@ -7,34 +7,35 @@ void Raoul::initialize(ECS::Entity entity)
 {
 	//////////////////////////////////////////////////////////////////////////////
 	// Create sprite
-	ShadedMesh& resource = cacheResource("raoul_static");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("raoul_static");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, spritePath("players/raoul/raoul_static.png"), "textured");
 	}
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Set up animations
-	auto idle_anim = AnimationData("raoul_idle", spritePath("players/raoul/idle/idle"), 62);
+	static const AnimationClip idle_anim("raoul_idle", spritePath("players/raoul/idle/idle"), 62);
 	auto& anims = entity.emplace<AnimationsComponent>(AnimationType::IDLE, std::make_shared<AnimationData>(idle_anim));
 
-	auto move_anim = AnimationData("raoul_move", spritePath("players/raoul/move/move"), 32);
+	static const AnimationClip move_anim("raoul_move", spritePath("players/raoul/move/move"), 32);
 	anims.addAnimation(AnimationType::MOVE, std::make_shared<AnimationData>(move_anim));
 
-	auto attack1 = AnimationData("raoul_attack1", spritePath("players/raoul/attack1/attack1"), 59, 1, true, false, vec2({ 0.03f, 0.f }));
+	static const AnimationClip attack1("raoul_attack1", spritePath("players/raoul/attack1/attack1"), 59, 1, true, false, vec2({ 0.03f, 0.f }));
 	anims.addAnimation(AnimationType::ATTACK1, std::make_shared<AnimationData>(attack1));
 
-	auto attack2 = AnimationData("raoul_attack2", spritePath("players/raoul/attack2/attack2"), 64, 1, true, false, vec2({ 0.03f, 0.f }));
+	static const AnimationClip attack2("raoul_attack2", spritePath("players/raoul/attack2/attack2"), 64, 1, true, false, vec2({ 0.03f, 0.f }));
 	anims.addAnimation(AnimationType::ATTACK2, std::make_shared<AnimationData>(attack2));
 
-	auto attack3 = AnimationData("raoul_attack3", spritePath("players/raoul/attack3/attack3"), 40, 1, true, false);
+	static const AnimationClip attack3("raoul_attack3", spritePath("players/raoul/attack3/attack3"), 40, 1, true, false);
 	anims.addAnimation(AnimationType::ATTACK3, std::make_shared<AnimationData>(attack3));
 
-	auto hit = AnimationData("raoul_hit", spritePath("players/raoul/hit/hit"), 49, 1, true, false);
+	static const AnimationClip hit("raoul_hit", spritePath("players/raoul/hit/hit"), 49, 1, true, false);
 	anims.addAnimation(AnimationType::HIT, std::make_shared<AnimationData>(hit));
 
-	auto defeat = AnimationData("raoul_defeat", spritePath("players/raoul/defeat/defeat"), 61, 1, true, false, vec2({ 0.16f, 0.055f }));
+	static const AnimationClip defeat("raoul_defeat", spritePath("players/raoul/defeat/defeat"), 61, 1, true, false, vec2({ 0.16f, 0.055f }));
 	anims.addAnimation(AnimationType::DEFEAT, std::make_shared<AnimationData>(defeat));
 
 	//////////////////////////////////////////////////////////////////////////////
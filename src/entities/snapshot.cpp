@@ -0,0 +1,228 @@
+#include "snapshot.hpp"
+#include "command_buffer.hpp"
+
+#include <iostream>
+#include <unordered_map>
+
+using namespace ECS;
+
+namespace
+{
+	struct Chunk
+	{
+		std::string name;
+		uint32_t version;
+		uint32_t count;
+		size_t offset; // start of the records
+		size_t size;
+	};
+
+	// Checks the layout of a snapshot, before anything in the world changes
+	void parse(const std::vector<uint8_t>& data, std::vector<Entity>& entities, std::vector<Chunk>& chunks)
+	{
+		BinaryReader in(data.data(), data.size());
+
+		if (in.read<uint32_t>() != Snapshot::MAGIC)
+			throw std::runtime_error("not a snapshot");
+		const auto formatVersion = in.read<uint32_t>();
+		if (formatVersion != Snapshot::FORMAT_VERSION)
+			throw std::runtime_error("unsupported snapshot format version " + std::to_string(formatVersion));
+
+		std::unordered_set<unsigned int> entityIds;
+		const auto numEntities = in.read<uint32_t>();
+		for (uint32_t i = 0; i < numEntities; i++)
+		{
+			const Entity e = Entity::fromId(in.read<unsigned int>());
+			if (e.index() == 0 || !entityIds.insert(e.id).second)
+				throw std::runtime_error("snapshot has an invalid entity id");
+			entities.push_back(e);
+		}
+
+		const auto numChunks = in.read<uint32_t>();
+		for (uint32_t i = 0; i < numChunks; i++)
+		{
+			Chunk chunk;
+			chunk.name = in.readString();
+			chunk.version = in.read<uint32_t>();
+			chunk.size = static_cast<size_t>(in.read<uint64_t>());
+			chunk.offset = in.offset();
+			in.skip(chunk.size);
+			chunks.push_back(chunk);
+		}
+		if (!in.atEnd())
+			throw std::runtime_error("snapshot has trailing data");
+	}
+}
+
+constexpr uint32_t Snapshot::MAGIC;
+constexpr uint32_t Snapshot::FORMAT_VERSION;
+
+std::vector<Snapshot::ComponentType>& Snapshot::componentTypes()
+{
+	static std::vector<ComponentType> types;
+	return types;
+}
+
+std::vector<uint8_t> Snapshot::capture()
+{
+	std::vector<uint8_t> data;
+	BinaryWriter out(data);
+
+	out.write(MAGIC);
+	out.write(FORMAT_VERSION);
+
+	const auto alive = EntityManager::allAlive();
+	out.write(static_cast<uint32_t>(alive.size()));
+	for (auto e : alive)
+	{
+		out.write(e.id);
+	}
+
+	const auto& types = componentTypes();
+	out.write(static_cast<uint32_t>(types.size()));
+	for (const auto& type : types)
+	{
+		out.writeString(type.name);
+		out.write(type.version);
+
+		// The size is patched in once the records are written
+		const size_t sizeOffset = out.size();
+		out.write(static_cast<uint64_t>(0));
+		type.write(out);
+
+		const uint64_t size = out.size() - sizeOffset - sizeof(uint64_t);
+		std::memcpy(out.at(sizeOffset), &size, sizeof(size));
+	}
+
+	return data;
+}
+
+void Snapshot::restore(const std::vector<uint8_t>& data)
+{
+	std::vector<Entity> entities;
+	std::vector<Chunk> chunks;
+	parse(data, entities, chunks);
+
+	std::unordered_set<unsigned int> entityIds;
+	for (auto e : entities)
+	{
+		entityIds.insert(e.id);
+	}
+
+	// Whatever was deferred belongs to the state being replaced
+	CommandBuffer::instance().clear();
+
+	// Make the live entities match, two entities can't share a slot so the extra ones go first
+	std::vector<Entity> extra;
+	for (auto e : EntityManager::allAlive())
+	{
+		if (entityIds.count(e.id) == 0)
+			extra.push_back(e);
+	}
+	ContainerInterface::removeAllComponentsOf(extra);
+
+	size_t numRevived = 0;
+	for (auto e : entities)
+	{
+		if (!EntityManager::isAlive(e))
+		{
+			if (!EntityManager::revive(e))
+				throw std::runtime_error("snapshot entity " + std::to_string(e.id) + " can't be revived");
+			numRevived++;
+		}
+	}
+
+	// Then the components, one chunk at a time
+	std::unordered_map<std::string, const ComponentType*> typesByName;
+	for (const auto& type : componentTypes())
+	{
+		typesByName[type.name] = &type;
+	}
+
+	size_t numSkipped = 0;
+	for (const auto& chunk : chunks)
+	{
+		const auto it = typesByName.find(chunk.name);
+		if (it == typesByName.end() || it->second->version != chunk.version)
+		{
+			numSkipped++;
+			continue;
+		}
+
+		BinaryReader records(data.data() + chunk.offset, chunk.size);
+		const auto count = records.read<uint32_t>();
+		it->second->restore(records, count);
+		if (!records.atEnd())
+			throw std::runtime_error("snapshot component " + chunk.name + " doesn't match its serializer");
+	}
+
+	std::cout << "Snapshot::restore: " << entities.size() << " entities (" << extra.size() << " destroyed, "
+		<< numRevived << " revived), " << chunks.size() - numSkipped << " component types restored, "
+		<< numSkipped << " skipped" << std::endl;
+}
+
+void Snapshot::overlay(const std::vector<uint8_t>& data, const std::unordered_map<unsigned int, Entity>& entityMap)
+{
+	std::vector<Entity> entities;
+	std::vector<Chunk> chunks;
+	parse(data, entities, chunks);
+
+	std::unordered_set<unsigned int> entityIds;
+	for (auto e : entities)
+	{
+		entityIds.insert(e.id);
+	}
+	for (const auto& mapped : entityMap)
+	{
+		if (entityIds.count(mapped.first) == 0)
+			throw std::runtime_error("snapshot entity " + std::to_string(mapped.first) + " isn't in the snapshot");
+	}
+
+	std::unordered_map<std::string, const ComponentType*> typesByName;
+	for (const auto& type : componentTypes())
+	{
+		typesByName[type.name] = &type;
+	}
+
+	size_t numSkipped = 0;
+	for (const auto& chunk : chunks)
+	{
+		const auto it = typesByName.find(chunk.name);
+		if (it == typesByName.end() || it->second->version != chunk.version)
+		{
+			numSkipped++;
+			continue;
+		}
+
+		BinaryReader records(data.data() + chunk.offset, chunk.size);
+		const auto count = records.read<uint32_t>();
+		it->second->overlay(records, count, entityMap);
+		if (!records.atEnd())
+			throw std::runtime_error("snapshot component " + chunk.name + " doesn't match its serializer");
+	}
+
+	std::cout << "Snapshot::overlay: " << entityMap.size() << " of " << entities.size() << " entities, "
+		<< chunks.size() - numSkipped << " component types restored, " << numSkipped << " skipped" << std::endl;
+}
+
+BinaryReader Snapshot::findChunk(const std::vector<uint8_t>& data, unsigned int typeId)
+{
+	const ComponentType* type = nullptr;
+	for (const auto& registered : componentTypes())
+	{
+		if (registered.typeId == typeId)
+			type = &registered;
+	}
+	if (type == nullptr)
+		throw std::runtime_error("component type isn't registered for snapshots");
+
+	std::vector<Entity> entities;
+	std::vector<Chunk> chunks;
+	parse(data, entities, chunks);
+	for (const auto& chunk : chunks)
+	{
+		if (chunk.name == type->name && chunk.version == type->version)
+			return BinaryReader(data.data() + chunk.offset, chunk.size);
+	}
+	return BinaryReader(data.data(), 0);
+}
@@ -0,0 +1,333 @@
+#pragma once
+#include "tiny_ecs.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ECS {
+	// Appends plain values to a byte buffer, in the native byte order
+	class BinaryWriter
+	{
+	public:
+		explicit BinaryWriter(std::vector<uint8_t>& data) : data(data) {}
+
+		void writeBytes(const void* bytes, size_t size)
+		{
+			const auto begin = static_cast<const uint8_t*>(bytes);
+			data.insert(data.end(), begin, begin + size);
+		}
+
+		template<class T>
+		void write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written as bytes");
+			writeBytes(&value, sizeof(T));
+		}
+
+		void writeString(const std::string& str)
+		{
+			write(static_cast<uint32_t>(str.size()));
+			writeBytes(str.data(), str.size());
+		}
+
+		// For the entity references inside components, see BinaryReader::readEntity
+		void writeEntity(Entity e)
+		{
+			write(e.id);
+		}
+
+		inline size_t size() const { return data.size(); }
+		// For patching a size that is only known once the data after it has been written
+		inline uint8_t* at(size_t offset) { return data.data() + offset; }
+
+	private:
+		std::vector<uint8_t>& data;
+	};
+
+	// Reads back what a BinaryWriter wrote. Throws std::runtime_error instead of reading past the end.
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const uint8_t* data, size_t size) : data(data), size(size), position(0), entityMap(nullptr) {}
+
+		void readBytes(void* bytes, size_t count)
+		{
+			require(count);
+			std::memcpy(bytes, data + position, count);
+			position += count;
+		}
+
+		template<class T>
+		T read()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read as bytes");
+			T value;
+			readBytes(&value, sizeof(T));
+			return value;
+		}
+
+		std::string readString()
+		{
+			const auto length = read<uint32_t>();
+			require(length);
+			std::string str(reinterpret_cast<const char*>(data + position), length);
+			position += length;
+			return str;
+		}
+
+		// An entity reference, translated through the entity map if there is one. Entities that the map
+		// doesn't have come back as the null entity.
+		Entity readEntity()
+		{
+			const Entity e = Entity::fromId(read<unsigned int>());
+			if (entityMap == nullptr)
+				return e;
+			const auto it = entityMap->find(e.id);
+			return it != entityMap->end() ? it->second : Entity();
+		}
+
+		void skip(size_t count)
+		{
+			require(count);
+			position += count;
+		}
+
+		// From the snapshot's entity ids to the live entities they stand for, see Snapshot::overlay
+		inline void setEntityMap(const std::unordered_map<unsigned int, Entity>* map) { entityMap = map; }
+
+		inline size_t offset() const { return position; }
+		inline bool atEnd() const { return position == size; }
+
+	private:
+		void require(size_t count) const
+		{
+			if (count > size - position)
+				throw std::runtime_error("snapshot is truncated");
+		}
+
+		const uint8_t* data;
+		size_t size;
+		size_t position;
+		const std::unordered_map<unsigned int, Entity>* entityMap;
+	};
+
+	// How a component type is written to a snapshot. Trivially copyable components are copied as they
+	// are; other types need a specialization with the same two functions, e.g.
+	//
+	//   template<> struct ECS::Serializer<Motion>
+	//   {
+	//       static void write(BinaryWriter& out, const Motion& motion);
+	//       static void read(BinaryReader& in, Motion& motion);
+	//   };
+	//
+	// read() is given either the entity's current component, or a new default constructed one. Entity
+	// references have to go through writeEntity() and readEntity(), so that an overlay can translate them.
+	template<class Component, class Enable = void>
+	struct Serializer;
+
+	template<class Component>
+	struct Serializer<Component, typename std::enable_if<std::is_trivially_copyable<Component>::value>::type>
+	{
+		static void write(BinaryWriter& out, const Component& component) { out.writeBytes(&component, sizeof(Component)); }
+		static void read(BinaryReader& in, Component& component) { in.readBytes(&component, sizeof(Component)); }
+	};
+
+	// A binary copy of the entities and of every component type registered with registerComponent().
+	//
+	// Layout: the header (magic, format version, live entity ids), then one chunk per registered
+	// component type with its name, its version, and its (entity id, component) records. Chunks are
+	// prefixed with their size, so a restore can skip the types it doesn't know or whose version
+	// changed. Snapshots use the native byte order and aren't meant to move between platforms.
+	//
+	// A restore makes the set of live entities match the snapshot (destroying the extra ones and
+	// reviving the missing ones with the same ids), and the registered components match it in a single
+	// pass over each chunk. Components that aren't registered, e.g. GPU resources, are left as they are,
+	// which means entities revived by a restore only get the registered ones.
+	//
+	// An overlay is for worlds whose entities also have components that can't be serialized: the
+	// entities are created again first (e.g. from the level data), then the snapshot's state is applied
+	// to them through a map from the snapshot's entity ids to the new entities.
+	//
+	// Both work on the current World, so a snapshot of one world can be restored into another, e.g. a
+	// scratch world for looking ahead without touching the game.
+	class Snapshot
+	{
+	public:
+		static constexpr uint32_t MAGIC = 0x53424d41; // "AMBS" in little endian
+		static constexpr uint32_t FORMAT_VERSION = 1;
+
+		// Bump the version when the layout of a component changes, so that older snapshots skip it
+		template<class Component>
+		static void registerComponent(const std::string& name, uint32_t version = 1)
+		{
+			for (const auto& type : componentTypes())
+			{
+				if (type.name == name)
+					throw std::runtime_error("component " + name + " is already registered for snapshots");
+			}
+			componentTypes().push_back({ name, version, componentTypeId<Component>(), &writeAll<Component>,
+				&restoreAll<Component>, &overlayAll<Component> });
+		}
+
+		static std::vector<uint8_t> capture();
+		// Throws std::runtime_error if the data isn't a valid snapshot. The layout is checked before
+		// anything changes, so only a corrupted component payload can leave the world half restored.
+		static void restore(const std::vector<uint8_t>& data);
+
+		// Applies the registered components of the mapped entities to the live entities they map to. The
+		// records of unmapped entities are skipped, and the mapped entities lose the registered components
+		// that they didn't have in the snapshot. Other entities are left as they are. Throws like restore().
+		static void overlay(const std::vector<uint8_t>& data, const std::unordered_map<unsigned int, Entity>& entityMap);
+
+		// The snapshot's components of a registered type, by entity id, e.g. to find out which entities
+		// to create before an overlay. None if the type's chunk was skipped or missing.
+		template<class Component>
+		static std::vector<std::pair<unsigned int, Component>> components(const std::vector<uint8_t>& data)
+		{
+			std::vector<std::pair<unsigned int, Component>> result;
+			BinaryReader records = findChunk(data, componentTypeId<Component>());
+			if (records.atEnd())
+				return result;
+
+			const auto count = records.read<uint32_t>();
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const auto id = records.read<unsigned int>();
+				Component component = makeComponent<Component>();
+				Serializer<Component>::read(records, component);
+				result.push_back({ id, std::move(component) });
+			}
+			return result;
+		}
+
+	private:
+		struct ComponentType
+		{
+			std::string name;
+			uint32_t version;
+			unsigned int typeId;
+			void (*write)(BinaryWriter& out);
+			void (*restore)(BinaryReader& in, uint32_t count);
+			void (*overlay)(BinaryReader& in, uint32_t count, const std::unordered_map<unsigned int, Entity>& entityMap);
+		};
+		static std::vector<ComponentType>& componentTypes();
+
+		// The records of the registered type's chunk, an empty reader if the snapshot doesn't have them
+		static BinaryReader findChunk(const std::vector<uint8_t>& data, unsigned int typeId);
+
+		template<class Component>
+		static void writeAll(BinaryWriter& out)
+		{
+			auto& container = registry<Component>();
+			out.write(static_cast<uint32_t>(container.size()));
+			for (size_t i = 0; i < container.size(); i++)
+			{
+				out.write(container.entities[i].id);
+				Serializer<Component>::write(out, container.components[i]);
+			}
+		}
+
+		template<class Component>
+		static void restoreAll(BinaryReader& in, uint32_t count)
+		{
+			auto& container = registry<Component>();
+			std::unordered_set<unsigned int> restored;
+			restored.reserve(count);
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const Entity e = Entity::fromId(in.read<unsigned int>());
+				if (!EntityManager::isAlive(e) || !restored.insert(e.id).second)
+					throw std::runtime_error("snapshot has a component for an unknown entity");
+
+				if (container.has(e))
+				{
+					Serializer<Component>::read(in, container.get(e));
+				}
+				else
+				{
+					Component component = makeComponent<Component>();
+					Serializer<Component>::read(in, component);
+					container.insert(e, std::move(component));
+				}
+			}
+
+			// Then drop the components that didn't exist when the snapshot was taken
+			std::unordered_set<unsigned int> stale;
+			for (auto e : container.entities)
+			{
+				if (restored.count(e.id) == 0)
+					stale.insert(e.id);
+			}
+			if (!stale.empty())
+				container.removeEntities(stale);
+		}
+
+		template<class Component>
+		static void overlayAll(BinaryReader& in, uint32_t count, const std::unordered_map<unsigned int, Entity>& entityMap)
+		{
+			auto& container = registry<Component>();
+			std::unordered_set<unsigned int> restored;
+			in.setEntityMap(&entityMap);
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const auto it = entityMap.find(in.read<unsigned int>());
+				if (it == entityMap.end())
+				{
+					// Read all the same, the serializer knows how long the record is
+					Component skipped = makeComponent<Component>();
+					Serializer<Component>::read(in, skipped);
+					continue;
+				}
+
+				const Entity e = it->second;
+				if (!EntityManager::isAlive(e) || !restored.insert(e.id).second)
+					throw std::runtime_error("snapshot overlay has a component for an unknown entity");
+
+				if (container.has(e))
+				{
+					Serializer<Component>::read(in, container.get(e));
+				}
+				else
+				{
+					Component component = makeComponent<Component>();
+					Serializer<Component>::read(in, component);
+					container.insert(e, std::move(component));
+				}
+			}
+
+			// The mapped entities only keep the components they had in the snapshot
+			std::unordered_set<unsigned int> stale;
+			for (const auto& mapped : entityMap)
+			{
+				if (restored.count(mapped.second.id) == 0 && container.has(mapped.second))
+					stale.insert(mapped.second.id);
+			}
+			if (!stale.empty())
+				container.removeEntities(stale);
+		}
+
+		// Trivially copyable components are overwritten as a whole, so they skip their constructor,
+		// which could have side effects
+		template<class Component>
+		static typename std::enable_if<std::is_trivially_copyable<Component>::value, Component>::type makeComponent()
+		{
+			typename std::aligned_storage<sizeof(Component), alignof(Component)>::type storage;
+			std::memset(&storage, 0, sizeof(storage));
+			return *reinterpret_cast<Component*>(&storage);
+		}
+
+		template<class Component>
+		static typename std::enable_if<!std::is_trivially_copyable<Component>::value, Component>::type makeComponent()
+		{
+			return Component();
+		}
+	};
+}
@@ -7,34 +7,35 @@ void Taji::initialize(ECS::Entity entity)
 {
 	//////////////////////////////////////////////////////////////////////////////
 	// Create sprite
-	ShadedMesh& resource = cacheResource("taji_static");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("taji_static");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, spritePath("players/taji/taji_static.png"), "textured");
 	}
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Set up animations
-	auto idle_anim = AnimationData("taji_idle", spritePath("players/taji/idle/idle"), 62);
+	static const AnimationClip idle_anim("taji_idle", spritePath("players/taji/idle/idle"), 62);
 	auto& anims = entity.emplace<AnimationsComponent>(AnimationType::IDLE, std::make_shared<AnimationData>(idle_anim));
 
-	auto move_anim = AnimationData("taji_move", spritePath("players/taji/move/move"), 32);
+	static const AnimationClip move_anim("taji_move", spritePath("players/taji/move/move"), 32);
 	anims.addAnimation(AnimationType::MOVE, std::make_shared<AnimationData>(move_anim));
 
-	auto hit = AnimationData("taji_hit", spritePath("players/taji/hit/hit"), 49, 1, true, false);
+	static const AnimationClip hit("taji_hit", spritePath("players/taji/hit/hit"), 49, 1, true, false);
 	anims.addAnimation(AnimationType::HIT, std::make_shared<AnimationData>(hit));
 
-	auto defeat = AnimationData("taji_defeat", spritePath("players/taji/defeat/defeat"), 61, 1, true, false);
+	static const AnimationClip defeat("taji_defeat", spritePath("players/taji/defeat/defeat"), 61, 1, true, false);
 	anims.addAnimation(AnimationType::DEFEAT, std::make_shared<AnimationData>(defeat));
 
-	auto attack1 = AnimationData("taji_attack1", spritePath("players/taji/attack1/attack1"), 55, 1, true, false);
+	static const AnimationClip attack1("taji_attack1", spritePath("players/taji/attack1/attack1"), 55, 1, true, false);
 	anims.addAnimation(AnimationType::ATTACK1, std::make_shared<AnimationData>(attack1));
 
-	auto attack2 = AnimationData("taji_attack2", spritePath("players/taji/attack2/attack2"), 55, 1, true, false);
+	static const AnimationClip attack2("taji_attack2", spritePath("players/taji/attack2/attack2"), 55, 1, true, false);
 	anims.addAnimation(AnimationType::ATTACK2, std::make_shared<AnimationData>(attack2));
 
-	auto attack3 = AnimationData("taji_attack3", spritePath("players/taji/attack3/attack3"), 83, 1, true, false);
+	static const AnimationClip attack3("taji_attack3", spritePath("players/taji/attack3/attack3"), 83, 1, true, false);
 	anims.addAnimation(AnimationType::ATTACK3, std::make_shared<AnimationData>(attack3));
 
 	//////////////////////////////////////////////////////////////////////////////
@@ -1,28 +1,191 @@
 #include "tiny_ecs.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
-// We store a list of all Component containers to be able to inspect the number of components and entities in each and to remove entities across containers
+// Every World stores a list of all Component containers to be able to inspect the number of components and entities in each and to remove entities across containers
 using namespace ECS;
 
-std::vector<ContainerInterface*>& ContainerInterface::registryListSingleton() {
+namespace {
+	thread_local World* currentWorld = nullptr;
+}
+
+World::~World() {
+	// The world is current while it's torn down, so that destructors unregister from its own event buses.
+	// The per-world objects (e.g. the CommandBuffer) may still hold components, so they go first, newest
+	// first since they may use the ones that existed when they were created.
+	Scope scope(*this);
+	while (!ownedResources.empty()) {
+		auto resource = std::move(ownedResources.back());
+		ownedResources.pop_back();
+		resources[resource.first] = nullptr;
+		resource.second.reset();
+	}
+	containers.clear();
+}
+
+World& World::main() {
 	// This is a Meyer's singleton, i.e., a function returning a static local variable by reference to solve SIOF
-	static std::vector<ContainerInterface*> singleton; // constructed during first call
-	return singleton;
+	static World world; // constructed during first call
+	return world;
+}
+
+World& World::current() {
+	return currentWorld ? *currentWorld : main();
+}
+
+World::Scope::Scope(World& world)
+	: previous(currentWorld) {
+	currentWorld = &world;
+}
+
+World::Scope::~Scope() {
+	currentWorld = previous;
+}
+
+unsigned int World::nextComponentTypeId() {
+	static std::atomic<unsigned int> nextId(0);
+	const unsigned int id = nextId++;
+	assert(id < MAX_COMPONENT_TYPES);
+	return id;
+}
+
+unsigned int World::nextResourceTypeId() {
+	static std::atomic<unsigned int> nextId(0);
+	return nextId++;
+}
+
+EntityManager& EntityManager::current() {
+	return World::current().entityManager;
+}
+
+unsigned int EntityManager::create() {
+	auto& allSlots = current().slots;
+	auto& free = current().freeList;
+
+	unsigned int index;
+	if (!free.empty()) {
+		index = free.back();
+		free.pop_back();
+	}
+	else {
+		index = static_cast<unsigned int>(allSlots.size());
+		// A larger index would spill into the generation bits and alias another entity
+		if (index > INDEX_MASK)
+			throw std::runtime_error("EntityManager: out of entity ids, " + std::to_string(index) + " entities alive");
+		allSlots.emplace_back();
+	}
+
+	auto& slot = allSlots[index];
+	slot.alive = true;
+	return index | (slot.generation << INDEX_BITS);
+}
+
+void EntityManager::destroy(Entity e) {
+	if (!isAlive(e))
+		return;
+
+	auto& slot = current().slots[e.index()];
+	slot.alive = false;
+	slot.generation = (slot.generation + 1) & GENERATION_MASK;
+	current().freeList.push_back(e.index());
+}
+
+bool EntityManager::isAlive(Entity e) {
+	const auto& allSlots = current().slots;
+	return e.index() < allSlots.size() && allSlots[e.index()].alive && allSlots[e.index()].generation == e.generation();
+}
+
+size_t EntityManager::destroyOrphans() {
+	auto& allSlots = current().slots;
+	size_t numDestroyed = 0;
+	for (unsigned int index = 1; index < allSlots.size(); index++) {
+		Entity e = Entity::fromId(index | (allSlots[index].generation << INDEX_BITS));
+		if (allSlots[index].alive && ContainerInterface::signatureOf(e).none()) {
+			destroy(e);
+			numDestroyed++;
+		}
+	}
+	return numDestroyed;
+}
+
+std::vector<Entity> EntityManager::allAlive() {
+	const auto& allSlots = current().slots;
+	std::vector<Entity> alive;
+	alive.reserve(numAlive());
+	for (unsigned int index = 1; index < allSlots.size(); index++) {
+		if (allSlots[index].alive)
+			alive.push_back(Entity::fromId(index | (allSlots[index].generation << INDEX_BITS)));
+	}
+	return alive;
+}
+
+bool EntityManager::revive(Entity e) {
+	if (e.index() == 0 || e.index() > INDEX_MASK)
+		return false;
+
+	auto& allSlots = current().slots;
+	auto& free = current().freeList;
+
+	// Slots past the end are created as free ones, then claimed like any free slot
+	while (allSlots.size() <= e.index()) {
+		free.push_back(static_cast<unsigned int>(allSlots.size()));
+		allSlots.emplace_back();
+	}
+
+	auto& slot = allSlots[e.index()];
+	if (slot.alive)
+		return slot.generation == e.generation();
+
+	const auto it = std::find(free.begin(), free.end(), e.index());
+	assert(it != free.end());
+	*it = free.back();
+	free.pop_back();
+
+	slot.alive = true;
+	slot.generation = e.generation();
+	return true;
+}
+
+size_t EntityManager::numAlive() {
+	return current().slots.size() - 1 - current().freeList.size();
+}
+
+size_t EntityManager::capacity() {
+	return current().slots.size();
+}
+
+void ContainerInterface::setOwnedBy(Entity e, bool owned) {
+	auto& signatures = world->signatures;
+	if (e.index() >= signatures.size())
+	{
+		if (!owned)
+			return;
+		signatures.resize(world->entityManager.slots.size());
+	}
+	signatures[e.index()].set(typeId, owned);
+}
+
+Signature ContainerInterface::signatureOf(Entity e) {
+	const auto& signatures = World::current().signatures;
+	if (!EntityManager::isAlive(e) || e.index() >= signatures.size())
+		return Signature();
+	return signatures[e.index()];
 }
 
 void ContainerInterface::clearAllComponents() {
-	for (auto reg : registryListSingleton()) {
-		reg->clear();
+	for (auto& reg : World::current().containers) {
+		if (reg)
+			reg->clear();
     }
 }
 void ContainerInterface::listAllComponents() {
 	std::cout << "Debug info on all registry entries:\n";
-	const auto& singleton = registryListSingleton();
-	for (auto reg : singleton) {
-        assert(reg); // Must not be null
-		if (reg->size() > 0) {
+	for (auto& reg : World::current().containers) {
+		if (reg && reg->size() > 0) {
 			std::cout
                 << "  " << reg->size() << " components of type "
                 << typeid(*reg).name() << "\n    ";
@@ -34,11 +197,18 @@ void ContainerInterface::listAllComponents() {
 	}
     std::cout.flush();
 }
+std::vector<ContainerInterface*> ContainerInterface::allContainers() {
+	std::vector<ContainerInterface*> result;
+	for (auto& reg : World::current().containers) {
+		if (reg)
+			result.push_back(reg.get());
+	}
+	return result;
+}
 void ContainerInterface::list_all_components_of(Entity e) {
 	std::cout << "Debug info on components of entity " << e.id << ":\n";
-	for (auto reg : registryListSingleton()) {
-        assert(reg); // Must not be null
-		if (reg->has(e)) {
+	for (auto& reg : World::current().containers) {
+		if (reg && reg->has(e)) {
 			std::cout
                 << "  type " << typeid(*reg).name() << ", stored at location "
                 << reg->map_entity_component_index[e.id] << '\n';
@@ -46,8 +216,34 @@ void ContainerInterface::list_all_components_of(Entity e) {
     }
 }
 void ContainerInterface::removeAllComponentsOf(Entity e) {
-	for (auto reg : registryListSingleton()) {
-        assert(reg); // Must not be null
-		reg->remove(e);
+	// Only visit the containers that actually hold a component of this entity
+	const Signature signature = signatureOf(e);
+	const auto& byTypeId = World::current().containers;
+	for (size_t i = 0; i < byTypeId.size(); i++) {
+		if (signature.test(i) && byTypeId[i])
+			byTypeId[i]->remove(e);
     }
+	EntityManager::destroy(e);
+}
+void ContainerInterface::removeAllComponentsOf(const std::vector<Entity>& entities) {
+	// Copy the entities first, the list may be a registry's own entity list
+	Signature touched;
+	std::unordered_set<unsigned int> entityIds;
+	std::vector<Entity> toDestroy;
+	entityIds.reserve(entities.size());
+	toDestroy.reserve(entities.size());
+	for (auto e : entities) {
+		touched |= signatureOf(e);
+		if (entityIds.insert(e.id).second)
+			toDestroy.push_back(e);
+	}
+
+	const auto& byTypeId = World::current().containers;
+	for (size_t i = 0; i < byTypeId.size(); i++) {
+		if (touched.test(i) && byTypeId[i])
+			byTypeId[i]->removeEntities(entityIds);
+	}
+
+	for (auto e : toDestroy)
+		EntityManager::destroy(e);
 }
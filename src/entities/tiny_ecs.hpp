@@ -2,64 +2,137 @@
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
+#include <bitset>
 #include <cassert>
+#include <memory>
+#include <utility>
 
 namespace ECS {
 	// Declare the ComponentContainer upfront, such that we can define the registry and use it in the Entity class definition
 	template <typename Component> // A template class, the Component can be any class
 	class ComponentContainer;
 
-	// Instanciate one component container for each desired class
-	template<class Component> // this is a variable template (c++14) that is created once per class and ECS instance https://en.cppreference.com/w/cpp/language/variable_template
-	ComponentContainer<Component> registry;
+	class World;
+	struct Entity;
+
+	// The container of each component type in the current World (see World::current), created on first use
+	template<class Component>
+	ComponentContainer<Component>& registry();
+
+	// Index of a component type, the same in every World. Also its bit in a Signature.
+	template<class Component>
+	unsigned int componentTypeId();
+
+	// Hands out entity ids. An id packs a slot index (low bits) and the slot's generation (high bits).
+	// Destroyed slots are recycled through a free list with their generation bumped, so the index
+	// space stays bounded by the number of live entities while stale handles to a destroyed entity
+	// never compare equal to (or find the components of) the entity that reuses its slot.
+	class EntityManager
+	{
+	public:
+		static constexpr unsigned int INDEX_BITS = 20;
+		static constexpr unsigned int INDEX_MASK = (1u << INDEX_BITS) - 1;
+		static constexpr unsigned int GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+		static unsigned int create();
+		// Releases the entity's id, called by ContainerInterface::removeAllComponentsOf
+		static void destroy(Entity e);
+		static bool isAlive(Entity e);
+
+		// Destroys live entities that don't have any components, e.g. ones that were created but never
+		// given any. Only safe where no system is still about to add components to an entity it created
+		// earlier.
+		static size_t destroyOrphans();
+
+		// Every live entity, in slot order
+		static std::vector<Entity> allAlive();
+		// Makes a destroyed id live again, so that a Snapshot can be restored with the same ids.
+		// Fails if the slot is used by a live entity of another generation.
+		static bool revive(Entity e);
+
+		static size_t numAlive();
+		static size_t capacity(); // number of slots, the bound for arrays indexed by Entity::index()
+
+	private:
+		// Every World has its own ids, the static functions above work on the current one
+		friend class World;
+		friend struct ContainerInterface;
+		EntityManager() = default;
+		static EntityManager& current();
+
+		struct Slot
+		{
+			unsigned int generation = 0;
+			bool alive = false;
+		};
+		// Slot 0 is never handed out, so that id 0 can't refer to a live entity
+		std::vector<Slot> slots = std::vector<Slot>(1);
+		std::vector<unsigned int> freeList;
+	};
 
 	// Unique identifyer for all entities
 	struct Entity
 	{
-		Entity()
-		{
-			id = nextId();
-			// Note, indices of already deleted entities arent re-used in this simple implementation.
+		// A null handle (id 0), which never refers to a live entity. Use create() for a new entity.
+		Entity() : id(0) {}
+
+		// Creates a new entity in the current World
+		static Entity create() {
+			return Entity(EntityManager::create(), ExistingId());
 		}
 
 		// The ID defines an entity
 		unsigned int id;
 
+		inline bool isNull() const { return id == 0; }
+
+		inline unsigned int index() const { return id & EntityManager::INDEX_MASK; }
+		inline unsigned int generation() const { return id >> EntityManager::INDEX_BITS; }
+
 		// An example wrapper
 		template<class Component>
 		void insert(Component c) {
-			registry<Component>.insert(*this, c);
+			registry<Component>().insert(*this, c);
 		};
 
 		template<class Component, class... Args>
 		Component& emplace(Args &&... args) {
-			return registry<Component>.emplace(*this, std::forward<Args>(args)...);
+			return registry<Component>().emplace(*this, std::forward<Args>(args)...);
 		}
 
 		template<typename Component>
 		Component& get() {
-			return registry<Component>.get(*this);
+			return registry<Component>().get(*this);
 		};
 
 		template<typename Component>
 		bool has() {
-			return registry<Component>.has(*this);
+			return registry<Component>().has(*this);
 		};
 
 		template<typename Component>
 		void remove() {
-			registry<Component>.remove(*this);
+			registry<Component>().remove(*this);
 		};
 
-	private:
-		// yields ids from 1; entity 0 is the default initialization
-		static unsigned int nextId() {
-			static unsigned int id_count = 1;
-			return id_count++;
+		// A handle to an existing id, unlike create() this doesn't create an entity
+		static Entity fromId(unsigned int id) {
+			return Entity(id, ExistingId());
 		}
+
+	private:
+		struct ExistingId {};
+		Entity(unsigned int existingId, ExistingId) : id(existingId) {}
 	};
 
+	// Upper bound on the number of component types, i.e. the number of bits in a Signature
+	constexpr size_t MAX_COMPONENT_TYPES = 256;
+
+	// The set of component types an entity has, one bit per ComponentContainer::typeId
+	using Signature = std::bitset<MAX_COMPONENT_TYPES>;
+
 	// Common interface to refer to all containers in the ECS registry
 	struct ContainerInterface
 	{
@@ -67,6 +140,8 @@ namespace ECS {
 		virtual size_t size() = 0;
 		virtual void remove(Entity e) = 0;
 		virtual bool has(Entity entity) = 0;
+		// Removes the components of all the given entities in a single compaction pass
+		virtual void removeEntities(const std::unordered_set<unsigned int>& entityIds) = 0;
 
 		// The entities associated to the components in the container
 		std::vector<Entity> entities;
@@ -74,12 +149,102 @@ namespace ECS {
 		// Callbacks to remove a particular or all entities in the system
 		static void clearAllComponents();
 		static void listAllComponents();
+		// The containers of the current world that were used so far, e.g. for the performance overlay
+		static std::vector<ContainerInterface*> allContainers();
+		// These destroy the entities as well, see EntityManager
 		static void removeAllComponentsOf(Entity e);
+		static void removeAllComponentsOf(const std::vector<Entity>& entities); // batched, may be passed a registry's own entity list
 		static void list_all_components_of(Entity e);
+
+		static Signature signatureOf(Entity e);
+		inline unsigned int getTypeId() const { return typeId; }
+
+		virtual ~ContainerInterface() = default;
 	protected:
+		friend class World;
+
 		// The hash map from Entity -> array index.
 		std::unordered_map<unsigned int, unsigned int> map_entity_component_index; // the entity is cast to uint to be hashable.
-		static std::vector<ContainerInterface*>& registryListSingleton();
+
+		void setOwnedBy(Entity e, bool owned);
+
+		World* world = nullptr; // the world owning this container
+		unsigned int typeId = 0;
+	};
+
+	// One isolated set of entities, component containers and per-world objects such as the event buses
+	// (see resource()). The game runs in World::main(); other worlds can be created, e.g. to simulate
+	// battles on other threads, and made current on a thread with a World::Scope. Everything that goes
+	// through registry<Component>(), EntityManager or resource() then uses that world.
+	class World
+	{
+	public:
+		World() = default;
+		~World();
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+
+		// The world of the game, current on every thread that didn't make another one current
+		static World& main();
+		static World& current();
+
+		// Makes a world current on the calling thread for the lifetime of the scope
+		class Scope
+		{
+		public:
+			explicit Scope(World& world);
+			~Scope();
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			World* previous;
+		};
+
+		template<class Component>
+		ComponentContainer<Component>& container();
+
+		// The world's own instance of T, default constructed on first use
+		template<class T>
+		T& resource()
+		{
+			const unsigned int id = resourceTypeId<T>();
+			if (id < resources.size() && resources[id])
+				return *static_cast<T*>(resources[id]);
+
+			// Constructed before it's stored, since T's constructor may create other resources
+			std::shared_ptr<T> created(new T(), [](T* resource) { delete resource; }); // T may befriend World only
+			if (id >= resources.size())
+				resources.resize(id + 1, nullptr);
+			resources[id] = created.get();
+			ownedResources.push_back({ id, std::move(created) });
+			return *static_cast<T*>(resources[id]);
+		}
+
+	private:
+		friend class EntityManager;
+		friend struct ContainerInterface;
+		template<class Component>
+		friend unsigned int componentTypeId();
+
+		static unsigned int nextComponentTypeId();
+		static unsigned int nextResourceTypeId();
+
+		template<class T>
+		static unsigned int resourceTypeId()
+		{
+			static const unsigned int id = nextResourceTypeId();
+			return id;
+		}
+
+		EntityManager entityManager;
+		// Containers indexed by their type id, null until first used in this world
+		std::vector<std::unique_ptr<ContainerInterface>> containers;
+		// Component signatures indexed by Entity::index()
+		std::vector<Signature> signatures;
+		// Per-world objects indexed by their type id, and the same objects in the order they were created
+		std::vector<void*> resources;
+		std::vector<std::pair<unsigned int, std::shared_ptr<void>>> ownedResources;
 	};
 
 	// A container that stores components of type 'Component' and associated entities
@@ -90,20 +255,8 @@ namespace ECS {
 		// Container of all components of type 'Component'
 		std::vector<Component> components;
 
-		// Constructor that registers the component type
-		ComponentContainer()
-		{
-			auto& singleton = registryListSingleton();
-			singleton.push_back(this);
-		}
-		// Destructor that frees memory from the singleton vector
-        ~ComponentContainer()
-        {
-            auto& singleton = registryListSingleton();
-            auto it = find(begin(singleton), end(singleton), this);
-            assert(it != end(singleton));
-			singleton.erase(it);
-        }
+		// Containers are created by their World, see World::container
+		ComponentContainer() = default;
 
 		// Disable copy operators
         ComponentContainer(const ComponentContainer&) = delete;
@@ -112,6 +265,9 @@ namespace ECS {
 		// Inserting a component c associated to entity e
 		inline Component& insert(Entity e, Component c, bool check_for_duplicates = true)
 		{
+			// Adding components to a destroyed entity would corrupt the signature of whoever reuses its slot
+			assert(EntityManager::isAlive(e));
+
 			// Usually, every entity should only have one instance of each component type
 			if (check_for_duplicates)
 				assert(map_entity_component_index.find(e.id) == map_entity_component_index.end());
@@ -120,6 +276,7 @@ namespace ECS {
 			map_entity_component_index[e.id] = component_index; // Note, not using insert or emplace to allow inserting multiple components for the same entity (at your own risk)
 			components.push_back(std::move(c)); // the move enforces move instead of copy constructor
 			entities.push_back(e);
+			setOwnedBy(e, true);
 			return components.back();
 		};
 
@@ -164,8 +321,36 @@ namespace ECS {
 			map_entity_component_index.erase(it);
 			components.pop_back();
 			entities.pop_back();
+			setOwnedBy(e, false);
 		};
 
+		// Remove the components of all the given entities, keeping the order of the remaining ones.
+		// Unlike remove(), this also drops any duplicates inserted with emplaceWithDuplicates.
+		void removeEntities(const std::unordered_set<unsigned int>& entityIds) override
+		{
+			unsigned int write_index = 0;
+			for (unsigned int read_index = 0; read_index < components.size(); read_index++)
+			{
+				const Entity e = entities[read_index];
+				if (entityIds.count(e.id) > 0)
+				{
+					if (map_entity_component_index.erase(e.id) > 0)
+						setOwnedBy(e, false);
+					continue;
+				}
+
+				if (write_index != read_index)
+				{
+					components[write_index] = std::move(components[read_index]);
+					entities[write_index] = e;
+					map_entity_component_index[e.id] = write_index;
+				}
+				write_index++;
+			}
+			components.erase(components.begin() + write_index, components.end());
+			entities.erase(entities.begin() + write_index, entities.end());
+		}
+
 		// Sort the components and associated entity assignment structures by the comparisonFunction that compares the order of two entities, see std::sort
 		template <class Compare>
 		void sort(Compare comparisonFunction)
@@ -184,6 +369,8 @@ namespace ECS {
 		// Remove all components of type 'Component'
 		void clear() override
 		{
+			for (auto e : entities)
+				setOwnedBy(e, false);
 			map_entity_component_index.clear();
 			components.clear();
 			entities.clear();
@@ -195,4 +382,32 @@ namespace ECS {
 			return components.size();
 		}
 	};
+
+	template<class Component>
+	unsigned int componentTypeId()
+	{
+		static const unsigned int id = World::nextComponentTypeId();
+		return id;
+	}
+
+	template<class Component>
+	ComponentContainer<Component>& World::container()
+	{
+		const unsigned int id = componentTypeId<Component>();
+		if (id >= containers.size())
+			containers.resize(id + 1);
+		if (!containers[id])
+		{
+			containers[id].reset(new ComponentContainer<Component>());
+			containers[id]->world = this;
+			containers[id]->typeId = id;
+		}
+		return static_cast<ComponentContainer<Component>&>(*containers[id]);
+	}
+
+	template<class Component>
+	ComponentContainer<Component>& registry()
+	{
+		return World::current().container<Component>();
+	}
 }
@@ -50,7 +50,7 @@ void AchievementSystem::onReachedBossEvent()
 
 void AchievementSystem::onBeatLevelEvent()
 {
-	size_t numPlayers = ECS::registry<PlayerComponent>.entities.size();
+	size_t numPlayers = ECS::registry<PlayerComponent>().entities.size();
 	if (numPlayers == 4 && isTracking(Achievement::BEAT_LEVEL_ALL_ALIVE))
 	{
 		addAchievement(Achievement::BEAT_LEVEL_ALL_ALIVE);
@@ -66,7 +66,7 @@ void AchievementSystem::onDefeatedBossEvent()
 	}
 
 	bool isLowHP = true;
-	auto& players = ECS::registry<PlayerComponent>.entities;
+	auto& players = ECS::registry<PlayerComponent>().entities;
 	// If all players have HP < 15% of their max HP, then give achievement
 	if (isTracking(Achievement::BEAT_BOSS_LOW_HP))
 	{
@@ -95,7 +95,7 @@ void AchievementSystem::createMessage(vec2 position, Achievement achievement)
 
 	std::string key = "message_box";
 	ShadedMesh& resource = cacheResource(key);
-	if (resource.effect.program.resource == 0) {
+	if (resource.effect.program == 0) {
 		// create a procedural circle
 		constexpr float z = -0.1f;
 		vec3 red = { 0.8,0.1,0.1 };
@@ -130,11 +130,11 @@ void AchievementSystem::createMessage(vec2 position, Achievement achievement)
 	}
 
 	// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
-	ECS::registry<ShadedMeshRef>.emplace(achievementEntity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(achievementEntity, resource);
 	achievementEntity.emplace<RenderableComponent>(RenderLayer::UI_TOOLTIP);
 
 	// Create motion
-	auto& motion = ECS::registry<Motion>.emplace(achievementEntity);
+	auto& motion = ECS::registry<Motion>().emplace(achievementEntity);
 	motion.angle = 0.f;
 	motion.velocity = { 0, 0 };
 	motion.position = position;
@@ -21,6 +21,8 @@ struct AchievementPopup {};
 
 class AchievementSystem {
 protected:
+	friend class ECS::World;
+
 	std::list<Achievement> achievements;
 	std::list<Achievement> tracking;
 
@@ -28,10 +30,9 @@ protected:
 	~AchievementSystem();
 
 public:
-	// Returns the singleton instance of this system
+	// Returns the instance of this system for the current ECS::World
 	static AchievementSystem& instance() {
-		static AchievementSystem achievementSystem;
-		return achievementSystem;
+		return ECS::World::current().resource<AchievementSystem>();
 	}
 
 	void addAchievement(Achievement item) 
@@ -0,0 +1,132 @@
+#include "battle_system.hpp"
+#include "event_system.hpp"
+#include "events.hpp"
+#include "game_state_system.hpp"
+
+#include "ai/ai.hpp"
+#include "ai/swarm_behaviour.hpp"
+#include "entities/command_buffer.hpp"
+#include "entities/players.hpp"
+#include "physics/physics.hpp"
+#include "physics/projectile.hpp"
+#include "rendering/render_components.hpp"
+
+#include <algorithm>
+
+void BattleSystem::step(float elapsed_ms)
+{
+	for (auto entity : ECS::registry<DeathTimer>().entities)
+	{
+		// Progress timer
+		auto& counter = ECS::registry<DeathTimer>().get(entity);
+		counter.counter_ms -= elapsed_ms;
+
+		// Remove player/mob once death timer expires
+		if (counter.counter_ms < 0)
+		{
+
+			// this has to go here, so the new chunks are added to mobs before the potato is removed
+			if (ECS::registry<HasSwarmBehaviour>().has(entity))
+			{
+				SwarmBehaviour sb;
+				sb.spawnExplodedChunks(entity);
+			}
+
+			//If the entity has a stats component get rid of the health bar too
+			if (entity.has<StatsComponent>()) {
+				ECS::CommandBuffer::instance().destroy(entity.get<StatsComponent>().healthBar);
+			}
+
+			if (entity.has<PlayerComponent>())
+			{
+				// For player deaths, disable their rendering but keep everything else
+				Player::disableRendering(entity);
+			}
+			else
+			{
+				// For mob deaths, get rid of all their components
+				ECS::CommandBuffer::instance().destroy(entity);
+			}
+
+			// Check if there are no more players left, restart game
+			auto& players = ECS::registry<PlayerComponent>().entities;
+			int numAlive = std::count_if(players.begin(), players.end(), [](ECS::Entity e)
+			{
+				return !e.has<DeathTimer>();
+			});
+
+			if (numAlive == 0 && !GameStateSystem::instance().isTransitioning)
+			{
+				GameStateSystem::instance().isTransitioning = true;
+				EventSystem<PlaySoundEffectEvent>::instance().sendEvent({ SoundEffect::GAME_OVER });
+				TransitionEvent event;
+				event.callback = []() {
+					GameStateSystem::instance().launchDefeatScreen();
+				};
+				EventSystem<TransitionEvent>::instance().sendEvent(event);
+				return;
+			}
+		}
+	}
+	// If all mobs are dead and there are no active projectiles (e.g., ambrosia
+	// projectiles), then go to the victory screen
+	if (ECS::registry<AISystem::MobComponent>().entities.empty() &&
+			ECS::registry<ProjectileComponent>().components.empty())
+	{
+		if (!GameStateSystem::instance().isTransitioning)
+		{
+			GameStateSystem::instance().isTransitioning = true;
+			TransitionEvent event;
+			event.callback = []() {
+				GameStateSystem::instance().launchVictoryScreen();
+			};
+			EventSystem<TransitionEvent>::instance().sendEvent(event);
+		}
+	}
+}
+
+// Compute collisions between entities
+void BattleSystem::handleCollisions()
+{
+	if (GameStateSystem::instance().inGameState()) 
+	{
+		// Loop over all collisions detected by the physics system
+		auto& registry = ECS::registry<PhysicsSystem::Collision>();
+		for (unsigned int i = 0; i < registry.components.size(); i++)
+		{
+			// The entity and its collider
+			auto entity = registry.entities[i];
+			auto entity_other = registry.components[i].other;
+
+			// Check for projectiles colliding with the player or mobs
+			if (ECS::registry<ProjectileComponent>().has(entity))
+			{
+				auto& projComponent = entity.get<ProjectileComponent>();
+				projComponent.processCollision(entity_other);
+			}
+		}
+
+		// Remove all collisions from this simulation step
+		ECS::registry<PhysicsSystem::Collision>().clear();
+	}
+}
+
+BattleSystem::Outcome BattleSystem::outcome()
+{
+	auto& players = ECS::registry<PlayerComponent>().entities;
+	bool playersLeft = std::any_of(players.begin(), players.end(), [](ECS::Entity e)
+	{
+		return !e.has<DeathTimer>();
+	});
+	if (!players.empty() && !playersLeft)
+	{
+		return Outcome::DEFEAT;
+	}
+
+	if (ECS::registry<AISystem::MobComponent>().entities.empty() &&
+			ECS::registry<ProjectileComponent>().components.empty())
+	{
+		return Outcome::VICTORY;
+	}
+	return Outcome::ONGOING;
+}
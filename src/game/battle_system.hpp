@@ -0,0 +1,21 @@
+#pragma once
+
+#include "common.hpp"
+#include "entities/tiny_ecs.hpp"
+
+// The rules of a battle that don't need a window: removing the entities whose death timer ran out,
+// ending the battle when one side is gone, and handling projectile collisions. The WorldSystem
+// steps it in the game, the headless build steps it directly.
+class BattleSystem
+{
+public:
+	enum class Outcome { ONGOING, VICTORY, DEFEAT };
+
+	void step(float elapsed_ms);
+
+	// Check for collisions
+	void handleCollisions();
+
+	// Victory once every mob is gone and no projectile is left, defeat once every player is dying
+	static Outcome outcome();
+};
@@ -6,12 +6,12 @@ ECS::Entity Camera::createCamera(json configValues) {
 
 ECS::Entity Camera::createCamera(vec2 position) {
 	// There should only ever be one of this type of entity
-	while(ECS::registry<CameraComponent>.size() > 0)
+	while(ECS::registry<CameraComponent>().size() > 0)
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<CameraComponent>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<CameraComponent>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 	entity.emplace<CameraComponent>().position = position;
 	return entity;
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "maps/map.hpp"
 #include "game/game_state_system.hpp"
 
+#include <cassert>
+
 CameraSystem::CameraSystem(vec2 window_size_in_px) {
 	this->window_size_in_px = window_size_in_px;
 
@@ -16,12 +18,45 @@ CameraSystem::~CameraSystem() {
 	}
 }
 
+void CameraSystem::onKey(int key, int action)
+{
+	assert(!ECS::registry<CameraComponent>().entities.empty());
+	auto camera = ECS::registry<CameraComponent>().entities[0];
+	auto& cameraComponent = camera.get<CameraComponent>();
+	if (action == GLFW_PRESS) {
+		if (key == GLFW_KEY_UP) {
+			cameraComponent.velocity.y = -cameraComponent.speed;
+		} else if (key == GLFW_KEY_DOWN) {
+			cameraComponent.velocity.y = cameraComponent.speed;
+		}
+		if (key == GLFW_KEY_LEFT) {
+			cameraComponent.velocity.x = -cameraComponent.speed;
+		} else if (key == GLFW_KEY_RIGHT) {
+			cameraComponent.velocity.x = cameraComponent.speed;
+		}
+	}
+	else if (action == GLFW_RELEASE) {
+		if (key == GLFW_KEY_LEFT && cameraComponent.velocity.x <= 0) {
+			cameraComponent.velocity.x = 0;
+		}
+		else if (key == GLFW_KEY_RIGHT && cameraComponent.velocity.x >= 0) {
+			cameraComponent.velocity.x = 0;
+		}
+		else if (key == GLFW_KEY_UP && cameraComponent.velocity.y <= 0) {
+			cameraComponent.velocity.y = 0;
+		}
+		else if (key == GLFW_KEY_DOWN && cameraComponent.velocity.y >= 0) {
+			cameraComponent.velocity.y = 0;
+		}
+	}
+}
+
 // Move camera entity
 void CameraSystem::step(float elapsed_ms) {
 	if (!GameStateSystem::instance().inGameState()) {
 		return;
 	}
-	for (auto camera : ECS::registry<CameraComponent>.entities) {
+	for (auto camera : ECS::registry<CameraComponent>().entities) {
 		auto& cameraComponent = camera.get<CameraComponent>();
 
 		float step_seconds = 1.0f * (elapsed_ms / 1000.f);
@@ -43,8 +78,8 @@ void CameraSystem::step(float elapsed_ms) {
 
 // Move camera the given distance wihout moving out of map texture
 void CameraSystem::moveCamera(vec2 distance, vec2 window_size_in_px) {
-	assert(!ECS::registry<CameraComponent>.entities.empty());
-	auto camera = ECS::registry<CameraComponent>.entities[0];
+	assert(!ECS::registry<CameraComponent>().entities.empty());
+	auto camera = ECS::registry<CameraComponent>().entities[0];
 	auto& cameraComponent = camera.get<CameraComponent>();
 
 	cameraComponent.position += distance;
@@ -53,8 +88,8 @@ void CameraSystem::moveCamera(vec2 distance, vec2 window_size_in_px) {
 
 // Move camera to view given position wihout moving out of map texture
 void CameraSystem::viewPosition(vec2 position, vec2 window_size_in_px) {
-	assert(!ECS::registry<CameraComponent>.entities.empty());
-	auto camera = ECS::registry<CameraComponent>.entities[0];
+	assert(!ECS::registry<CameraComponent>().entities.empty());
+	auto camera = ECS::registry<CameraComponent>().entities[0];
 	auto& cameraComponent = camera.get<CameraComponent>();
 
 	cameraComponent.position = { position.x - window_size_in_px.x / 2, position.y - window_size_in_px.y / 2 };
@@ -63,8 +98,8 @@ void CameraSystem::viewPosition(vec2 position, vec2 window_size_in_px) {
 
 // Returns if given position is within view of the camera
 bool CameraSystem::isPositionInView(vec2 position, vec2 window_size_in_px) {
-	assert(!ECS::registry<CameraComponent>.entities.empty());
-	auto camera = ECS::registry<CameraComponent>.entities[0];
+	assert(!ECS::registry<CameraComponent>().entities.empty());
+	auto camera = ECS::registry<CameraComponent>().entities[0];
 	auto& cameraComponent = camera.get<CameraComponent>();
 
 	// Position is out of view to the top
@@ -92,8 +127,8 @@ void CameraSystem::onPlayerChange(const PlayerChangeEvent& event) {
 	auto entity = event.newActiveEntity;
 	auto& motion = entity.get<Motion>();
 	// If camera has a delay component, set the position to move to after the delay
-	if (!ECS::registry<CameraDelayedMoveComponent>.entities.empty()) {
-		auto camera = ECS::registry<CameraDelayedMoveComponent>.entities[0];
+	if (!ECS::registry<CameraDelayedMoveComponent>().entities.empty()) {
+		auto camera = ECS::registry<CameraDelayedMoveComponent>().entities[0];
 		auto& cameraDelayedMoveComponent = camera.get<CameraDelayedMoveComponent>();
 		cameraDelayedMoveComponent.position = motion.position;
 	}
@@ -104,8 +139,8 @@ void CameraSystem::onPlayerChange(const PlayerChangeEvent& event) {
 
 // Prevent camera from moving out of map texture
 void CameraSystem::preventViewingOutOfBounds(ECS::Entity camera, vec2 window_size_in_px) {
-	assert(!ECS::registry<MapComponent>.entities.empty());
-	vec2 mapSize = ECS::registry<MapComponent>.entities[0].get<MapComponent>().mapSize;
+	assert(!ECS::registry<MapComponent>().entities.empty());
+	vec2 mapSize = ECS::registry<MapComponent>().entities[0].get<MapComponent>().mapSize;
 	auto& cameraComponent = camera.get<CameraComponent>();
 	// Prevent moving camera out of top
 	if (cameraComponent.position.y <= 0) {
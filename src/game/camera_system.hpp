@@ -12,6 +12,9 @@ public:
 
 	void step(float elapsed_ms);
 
+	// The arrow keys scroll the camera while they're held
+	static void onKey(int key, int action);
+
 	static void moveCamera(vec2 distance, vec2 window_size_in_px);
 	static void viewPosition(vec2 position, vec2 window_size_in_px);
 	static bool isPositionInView(vec2 position, vec2 window_size_in_px);
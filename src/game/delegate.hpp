@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<class Signature>
+class Delegate;
+
+// A move-only std::function with a fixed inline buffer. Bound member functions, std::bind results and
+// lambdas with a few captures are stored inline, so creating, moving and calling a delegate never
+// touches the heap. Larger callables still work, they are moved to the heap instead.
+template<class R, class... Args>
+class Delegate<R(Args...)>
+{
+public:
+	static constexpr size_t INLINE_SIZE = 48;
+
+	Delegate() : invoker(nullptr), manager(nullptr) {}
+
+	template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Delegate>::value>::type>
+	Delegate(F&& function)
+	{
+		using Callable = typename std::decay<F>::type;
+		using Ops = typename std::conditional<fitsInline<Callable>(), InlineOps<Callable>, HeapOps<Callable>>::type;
+		Ops::create(&storage, std::forward<F>(function));
+		invoker = &Ops::invoke;
+		manager = &Ops::manage;
+	}
+
+	Delegate(Delegate&& other) noexcept : invoker(nullptr), manager(nullptr)
+	{
+		moveFrom(other);
+	}
+
+	Delegate& operator=(Delegate&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			moveFrom(other);
+		}
+		return *this;
+	}
+
+	Delegate(const Delegate&) = delete;
+	Delegate& operator=(const Delegate&) = delete;
+
+	~Delegate() { reset(); }
+
+	R operator()(Args... args) const
+	{
+		return invoker(&storage, std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const { return invoker != nullptr; }
+
+	// Whether a callable of this type is stored without a heap allocation
+	template<class F>
+	static constexpr bool fitsInline()
+	{
+		return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+			std::is_nothrow_move_constructible<F>::value;
+	}
+
+private:
+	using Storage = typename std::aligned_storage<INLINE_SIZE, alignof(std::max_align_t)>::type;
+
+	enum class Operation { MOVE, DESTROY };
+
+	template<class F>
+	struct InlineOps
+	{
+		template<class G>
+		static void create(void* storage, G&& function) { new (storage) F(std::forward<G>(function)); }
+
+		static R invoke(void* storage, Args... args)
+		{
+			return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+		}
+
+		// MOVE moves the callable to `to`, then destroys it in `from`
+		static void manage(Operation operation, void* from, void* to)
+		{
+			F* function = static_cast<F*>(from);
+			if (operation == Operation::MOVE)
+				new (to) F(std::move(*function));
+			function->~F();
+		}
+	};
+
+	template<class F>
+	struct HeapOps
+	{
+		template<class G>
+		static void create(void* storage, G&& function) { *static_cast<F**>(storage) = new F(std::forward<G>(function)); }
+
+		static R invoke(void* storage, Args... args)
+		{
+			return (**static_cast<F**>(storage))(std::forward<Args>(args)...);
+		}
+
+		static void manage(Operation operation, void* from, void* to)
+		{
+			F** function = static_cast<F**>(from);
+			if (operation == Operation::MOVE)
+				*static_cast<F**>(to) = *function;
+			else
+				delete *function;
+		}
+	};
+
+	void moveFrom(Delegate& other)
+	{
+		if (other.manager)
+		{
+			other.manager(Operation::MOVE, &other.storage, &storage);
+			invoker = other.invoker;
+			manager = other.manager;
+			other.invoker = nullptr;
+			other.manager = nullptr;
+		}
+	}
+
+	void reset()
+	{
+		if (manager)
+		{
+			manager(Operation::DESTROY, &storage, nullptr);
+			invoker = nullptr;
+			manager = nullptr;
+		}
+	}
+
+	// Mutable so that callables with a non-const call operator can be called through a const delegate
+	mutable Storage storage;
+	R (*invoker)(void*, Args...);
+	void (*manager)(Operation, void*, void*);
+};
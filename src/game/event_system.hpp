@@ -1,7 +1,11 @@
 #pragma once
+#include "entities/tiny_ecs.hpp"
+#include "delegate.hpp"
 
-#include <unordered_map>
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <iostream>
 #include <vector>
 
 // Manages the unique identifier for an event listener
@@ -11,7 +15,7 @@ public:
 	EventListenerInfo() : id(INVALID_ID) {};
 
 	void initialize() {
-		static int nextID = 0;
+		static std::atomic<int> nextID(0);
 		id = nextID++;
 	}
 
@@ -25,45 +29,138 @@ private:
 	static const int INVALID_ID = -1;
 };
 
+// Type-erased view of an EventSystem, for draining the queued events of every event type at once
+class EventQueueInterface
+{
+public:
+	virtual ~EventQueueInterface() = default;
+	// Sends the events that were queued since the last call, returns how many were sent
+	virtual size_t dispatchQueued() = 0;
+};
+
+// The event types of an ECS::World that have used queueEvent
+class EventQueues
+{
+public:
+	// Sends the queued events of every event type of the current ECS::World. Events queued by the
+	// listeners are sent too, in further passes, so the queues are empty afterwards.
+	static size_t dispatchAll()
+	{
+		auto& queues = ECS::World::current().resource<EventQueues>().queues;
+		size_t numDispatched = 0;
+		for (int pass = 0; pass < MAX_PASSES; pass++)
+		{
+			size_t numInPass = 0;
+			// By index, a listener can queue the first event of another type
+			for (size_t i = 0; i < queues.size(); i++)
+			{
+				numInPass += queues[i]->dispatchQueued();
+			}
+			if (numInPass == 0)
+			{
+				return numDispatched;
+			}
+			numDispatched += numInPass;
+		}
+		std::cout << "EventQueues: events were still queued after " << MAX_PASSES << " passes, they are left for the next dispatch" << std::endl;
+		return numDispatched;
+	}
+
+	static void add(EventQueueInterface& queue)
+	{
+		ECS::World::current().resource<EventQueues>().queues.push_back(&queue);
+	}
+
+private:
+	friend class ECS::World;
+	EventQueues() = default;
+
+	static const int MAX_PASSES = 16;
+
+	// Owned by the same World as this object
+	std::vector<EventQueueInterface*> queues;
+};
+
 // SINGLETON EVENT SYSTEM
 // Can register listeners for different kinds of events. Listeners are callback
 // functions that will execute when their associated event occurs.
+// There is one instance per ECS::World, so events never cross worlds.
+//
+// Listeners are kept in a flat vector of Delegates, so sending an event doesn't allocate. Events are
+// either sent right away with sendEvent, or queued with queueEvent and sent in a batch when the main
+// loop calls EventQueues::dispatchAll.
 template <typename T>
-class EventSystem
+class EventSystem : public EventQueueInterface
 {
 public:
 	typedef std::function<void(const T&)> EventListener;
 
-	// Returns the singleton instance of this system
+	// Returns the instance of this system for the current ECS::World
 	static EventSystem& instance()
 	{
-		static EventSystem eventSystem;
-		return eventSystem;
+		return ECS::World::current().resource<EventSystem>();
+	}
+
+	// Send an event to all who are listening for that event, before returning
+	void sendEvent(const T& event)
+	{
+		// Listeners may register or unregister listeners, which only takes effect once the outermost
+		// sendEvent returns. Until then the vector is never resized, so the delegate being called stays put.
+		dispatchDepth++;
+		for (size_t i = 0; i < eventListeners.size(); i++)
+		{
+			if (eventListeners[i].id != INVALID_ID)
+			{
+				eventListeners[i].callback(event);
+			}
+		}
+		if (--dispatchDepth == 0)
+		{
+			applyListenerChanges();
+		}
+	}
+
+	// Send an event the next time the queued events are dispatched, e.g. from systems that are
+	// in the middle of iterating over components the listeners might change
+	void queueEvent(const T& event)
+	{
+		if (!isQueueAdded)
+		{
+			EventQueues::add(*this);
+			isQueueAdded = true;
+		}
+		queuedEvents.push_back(event);
 	}
 
-	// Send an event to all who are listening for that event
-	void sendEvent(T event)
+	size_t dispatchQueued() override
 	{
-   //Make sure that if we are looping through all the listeners that if someone decideds to unlisten it doesn't break everything because if we allow deletes while we are iterating over the map it breaks.
-   sendingEvents = true;
-		for (const auto& listener : eventListeners)
+		if (isDispatchingQueue || queuedEvents.empty())
+		{
+			return 0;
+		}
+
+		// Events queued by the listeners go to the other buffer, for the next batch
+		isDispatchingQueue = true;
+		dispatchingEvents.swap(queuedEvents);
+		for (const auto& event : dispatchingEvents)
 		{
-			listener.second(event);
+			sendEvent(event);
 		}
-  sendingEvents = false;
-  for (auto info : listenersToDelete) {
-    unregisterListener(info);
-  }
-  listenersToDelete.clear();
+		const size_t numDispatched = dispatchingEvents.size();
+		dispatchingEvents.clear();
+		isDispatchingQueue = false;
+		return numDispatched;
 	}
 
-	// Register a callback for events
-	EventListenerInfo registerListener(const EventListener& callback)
+	// Register a callback for events. Any callable taking `const T&` works, e.g. std::bind or a lambda.
+	template <typename Callback>
+	EventListenerInfo registerListener(Callback&& callback)
 	{
 		EventListenerInfo listenerInfo;
 		listenerInfo.initialize();
 
-		eventListeners.insert({listenerInfo.getID(), callback});
+		auto& listeners = dispatchDepth > 0 ? addedListeners : eventListeners;
+		listeners.push_back({listenerInfo.getID(), typename Listener::Callback(std::forward<Callback>(callback))});
 
 		return listenerInfo;
 	}
@@ -72,38 +169,87 @@ public:
 	// when registering it
 	void unregisterListener(EventListenerInfo& info)
 	{
-   if (!sendingEvents) {
-     eventListeners.erase(info.getID());
-     info.uninitialize();
-   }
-   else {
-     listenersToDelete.push_back(info);
-   }
+		if (removeListener(addedListeners, info.getID(), false) ||
+			removeListener(eventListeners, info.getID(), dispatchDepth > 0))
+		{
+			info.uninitialize();
+		}
 	}
 
 private:
+	friend class ECS::World;
+
+	struct Listener
+	{
+		using Callback = Delegate<void(const T&)>;
+
+		int id;
+		Callback callback;
+	};
+
+	static const int INVALID_ID = -1;
+
 	// Default constructor
 	EventSystem() = default;
 
-	// Copy constructor
-	EventSystem(const EventSystem&) = default;
-
 	// Destructor
 	~EventSystem() = default;
 
-	// Assignment operator
-	EventSystem& operator=(const EventSystem&) {return *this;}
+	EventSystem(const EventSystem&) = delete;
+	EventSystem& operator=(const EventSystem&) = delete;
 
 	// Address-of operator
 	EventSystem* operator&(const EventSystem&) {return nullptr;}
 
-	// Event listeners
-	std::unordered_map<int, EventListener> eventListeners;
+	// While sending, listeners are only marked as removed and erased afterwards
+	bool removeListener(std::vector<Listener>& listeners, int id, bool deferred)
+	{
+		for (auto it = listeners.begin(); it != listeners.end(); ++it)
+		{
+			if (it->id == id)
+			{
+				if (deferred)
+				{
+					it->id = INVALID_ID;
+					hasRemovedListeners = true;
+				}
+				else
+				{
+					listeners.erase(it);
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void applyListenerChanges()
+	{
+		if (hasRemovedListeners)
+		{
+			eventListeners.erase(std::remove_if(eventListeners.begin(), eventListeners.end(),
+				[](const Listener& listener) { return listener.id == INVALID_ID; }), eventListeners.end());
+			hasRemovedListeners = false;
+		}
+		for (auto& listener : addedListeners)
+		{
+			eventListeners.push_back(std::move(listener));
+		}
+		addedListeners.clear();
+	}
 
- //listeners to be deleted
- std::vector<EventListenerInfo> listenersToDelete;
+	// Event listeners, in the order they were registered
+	std::vector<Listener> eventListeners;
+	// Listeners registered while sending, they start receiving events once it's done
+	std::vector<Listener> addedListeners;
+	bool hasRemovedListeners = false;
+	int dispatchDepth = 0;
 
- bool sendingEvents = false;
+	// The two buffers are swapped when dispatching, so they keep their capacity
+	std::vector<T> queuedEvents;
+	std::vector<T> dispatchingEvents;
+	bool isDispatchingQueue = false;
+	bool isQueueAdded = false;
 };
 
 /**
@@ -187,4 +333,16 @@ private:
  * At some later time, unregister the listener:
  *
  * 		EventSystem<MouseClickEvent>::Instance().UnregisterListener(mouseClickListener);
+ *
+ *
+ * ---------------------------------------------------------------------------
+ * QUEUED EVENTS:
+ *
+ * Systems that send events while iterating over components (e.g. physics)
+ * can queue them instead, so the listeners run once the systems are done:
+ *
+ * 		EventSystem<FinishedMovementEvent>::instance().queueEvent(event);
+ *
+ * The main loop sends all the queued events, in the order they were queued,
+ * by calling EventQueues::dispatchAll() after the systems have stepped.
  */
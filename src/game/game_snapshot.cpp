@@ -0,0 +1,147 @@
+#include "game_snapshot.hpp"
+#include "common.hpp"
+#include "stats_component.hpp"
+#include "turn_system.hpp"
+#include "entities/snapshot.hpp"
+#include "rendering/render_components.hpp"
+#include "ai/ai.hpp"
+#include "ai/behaviour_tree.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	template<class Key, class Value>
+	void writeMap(ECS::BinaryWriter& out, const std::unordered_map<Key, Value>& map)
+	{
+		out.write(static_cast<uint32_t>(map.size()));
+		for (const auto& pair : map)
+		{
+			out.write(pair.first);
+			out.write(pair.second);
+		}
+	}
+
+	template<class Key, class Value>
+	void readMap(ECS::BinaryReader& in, std::unordered_map<Key, Value>& map)
+	{
+		map.clear();
+		const auto size = in.read<uint32_t>();
+		for (uint32_t i = 0; i < size; i++)
+		{
+			const auto key = in.read<Key>();
+			map[key] = in.read<Value>();
+		}
+	}
+}
+
+namespace ECS
+{
+	template<>
+	struct Serializer<Motion>
+	{
+		static void write(BinaryWriter& out, const Motion& motion)
+		{
+			out.write(motion.position);
+			out.write(motion.velocity);
+			out.write(motion.angle);
+			out.write(motion.prevPosition);
+			out.write(motion.prevAngle);
+			out.write(motion.renderPosition);
+			out.write(motion.renderAngle);
+			out.write(motion.scale);
+			out.write(motion.boundingBox);
+			out.write(motion.moveRange);
+			out.write(motion.mass);
+			out.write(motion.orientation);
+			out.write(motion.colliderType);
+
+			// The path from the next point to the last one
+			auto path = motion.path;
+			out.write(static_cast<uint32_t>(path.size()));
+			while (!path.empty())
+			{
+				out.write(path.top());
+				path.pop();
+			}
+		}
+
+		static void read(BinaryReader& in, Motion& motion)
+		{
+			motion.position = in.read<vec2>();
+			motion.velocity = in.read<vec2>();
+			motion.angle = in.read<float>();
+			motion.prevPosition = in.read<vec2>();
+			motion.prevAngle = in.read<float>();
+			motion.renderPosition = in.read<vec2>();
+			motion.renderAngle = in.read<float>();
+			motion.scale = in.read<vec2>();
+			motion.boundingBox = in.read<vec2>();
+			motion.moveRange = in.read<float>();
+			motion.mass = in.read<float>();
+			motion.orientation = in.read<float>();
+			motion.colliderType = in.read<CollisionGroup>();
+
+			std::vector<vec2> points(in.read<uint32_t>());
+			for (auto& point : points)
+			{
+				point = in.read<vec2>();
+			}
+			motion.path = std::stack<vec2>();
+			for (auto it = points.rbegin(); it != points.rend(); ++it)
+			{
+				motion.path.push(*it);
+			}
+		}
+	};
+
+	template<>
+	struct Serializer<StatsComponent>
+	{
+		// The health bar isn't part of it, it's created along with its entity
+		static void write(BinaryWriter& out, const StatsComponent& stats)
+		{
+			writeMap(out, stats.stats);
+			writeMap(out, stats.statModifiers);
+		}
+
+		static void read(BinaryReader& in, StatsComponent& stats)
+		{
+			readMap(in, stats.stats);
+			readMap(in, stats.statModifiers);
+		}
+	};
+
+	template<>
+	struct Serializer<AISystem::MobComponent>
+	{
+		static void write(BinaryWriter& out, const AISystem::MobComponent& mob)
+		{
+			out.writeEntity(mob.target);
+		}
+
+		static void read(BinaryReader& in, AISystem::MobComponent& mob)
+		{
+			mob.target = in.readEntity();
+		}
+	};
+}
+
+void registerSnapshotComponents()
+{
+	static std::once_flag registered;
+	std::call_once(registered, []()
+	{
+		ECS::Snapshot::registerComponent<SpawnOrigin>("spawn_origin");
+		ECS::Snapshot::registerComponent<Motion>("motion");
+		ECS::Snapshot::registerComponent<StatsComponent>("stats", 2);
+		ECS::Snapshot::registerComponent<CCImmunityComponent>("cc_immunity");
+		ECS::Snapshot::registerComponent<PlayerComponent>("player");
+		ECS::Snapshot::registerComponent<AISystem::MobComponent>("mob", 2);
+		ECS::Snapshot::registerComponent<BehaviourTreeType>("behaviour_tree_type");
+		ECS::Snapshot::registerComponent<TurnSystem::TurnComponent>("turn");
+		ECS::Snapshot::registerComponent<TurnSystem::TurnComponentIsActive>("turn_active");
+		ECS::Snapshot::registerComponent<DeathTimer>("death_timer");
+	});
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstdint>
+
+// Where an entity of the battle came from, so that a restore can create it again from the level data
+// before the rest of its state is overlaid (see GameStateSystem::restoreBattle). Players and level
+// mobs are found by their index; chunks and mashed potato are spawned during the battle, so they are
+// spawned again at the position of their potato.
+struct SpawnOrigin
+{
+	enum class Kind : uint8_t
+	{
+		PLAYER,
+		LEVEL_MOB,
+		POTATO_CHUNK,
+		MASHED_POTATO
+	};
+
+	Kind kind = Kind::LEVEL_MOB;
+	// The PlayerType of a player, or the order of a mob in the level's mob list
+	uint32_t index = 0;
+	// The potato's position for chunks and mashed potato
+	vec2 origin = { 0.f, 0.f };
+};
+
+// Registers the component types that make up the battle state with the ECS::Snapshot: positions,
+// stats, turn state, death timers, mob targets, and the SpawnOrigin of every player and mob. The
+// rest (sprites, animations, skills, health bars) comes from rebuilding the level. Safe to call more
+// than once.
+void registerSnapshotComponents();
@@ -1,4 +1,5 @@
 #include "game_state_system.hpp"
+#include "game_snapshot.hpp"
 #include "turn_system.hpp"
 #include "camera.hpp"
 #include "achievement_system.hpp"
@@ -7,22 +8,74 @@
 #include "maps/map_objects.hpp"
 #include "level_loader/level_loader.hpp"
 #include "rendering/text.hpp"
+#include "rendering/image_cache.hpp"
+#include "rendering/resource_manager.hpp"
 #include "entities/players.hpp"
 #include "entities/enemies.hpp"
+#include "entities/command_buffer.hpp"
+#include "entities/snapshot.hpp"
+#include "ai/ai.hpp"
+#include "memory/level_arena.hpp"
+#include "profiling/profiler.hpp"
 
 #include <sstream>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+	const uint32_t BATTLE_SAVE_VERSION = 1;
+
+	std::vector<uint8_t> encodeBattle(const GameStateSystem::BattleSnapshot& snapshot)
+	{
+		std::vector<uint8_t> data;
+		ECS::BinaryWriter writer(data);
+		writer.write(BATTLE_SAVE_VERSION);
+		writer.writeString(snapshot.recipe);
+		writer.write(static_cast<int32_t>(snapshot.levelIndex));
+		writer.write(static_cast<int32_t>(snapshot.ambrosia));
+		writer.write(static_cast<uint64_t>(snapshot.data.size()));
+		writer.writeBytes(snapshot.data.data(), snapshot.data.size());
+		return data;
+	}
+
+	// Returns false for an empty or unreadable battle save, or one of another version
+	bool decodeBattle(const std::vector<uint8_t>& data, GameStateSystem::BattleSnapshot& snapshot)
+	{
+		try
+		{
+			ECS::BinaryReader reader(data.data(), data.size());
+			if (data.empty() || reader.read<uint32_t>() != BATTLE_SAVE_VERSION)
+				return false;
+			snapshot.recipe = reader.readString();
+			snapshot.levelIndex = reader.read<int32_t>();
+			snapshot.ambrosia = reader.read<int32_t>();
+			snapshot.data.resize(static_cast<size_t>(reader.read<uint64_t>()));
+			reader.readBytes(snapshot.data.data(), snapshot.data.size());
+			return reader.atEnd();
+		}
+		catch (const std::exception&)
+		{
+			return false;
+		}
+	}
+}
 
 GameStateSystem::GameStateSystem()
 	: ambrosia(0)
+	, frameBufferSize(0, 0)
 {
 	resetState();
 	isTransitioning = false;
+	isSavingEnabled = true;
 
 	currentLevelIndex = 0;
 	currentTutorialIndex = 0;
 	currentStoryIndex = 0;
 
+	registerSnapshotComponents();
+
 	LevelLoader lc;
 	json save_obj = lc.load();
 	if (save_obj.contains("recipe"))
@@ -136,17 +189,64 @@ void GameStateSystem::nextMap()
 
 void GameStateSystem::restartMap()
 {
+	PROFILE_SCOPE("load map");
 	resetState();
 	currentLevel = recipe["maps"][currentLevelIndex];
 
 	std::cout << "GameStateSystem::restartMap: starting " << currentLevel.at("map") << std::endl;
 
-	// Get screen/buffer size
-	int frameBufferWidth, frameBufferHeight;
-	glfwGetFramebufferSize(window, &frameBufferWidth, &frameBufferHeight);
+	buildMap();
 
+	// Trying the map again starts over from where the first try started, not from how it ended. The
+	// ambrosia earned during the try is kept.
+	if (levelStartSnapshot.recipe == recipe.at("name").get<std::string>() && levelStartSnapshot.levelIndex == currentLevelIndex)
+	{
+		overlayBattle(levelStartSnapshot);
+	}
+	else
+	{
+		levelStartSnapshot = captureBattle();
+	}
+	prefetchNextMap();
+}
+
+GameStateSystem::BattleSnapshot GameStateSystem::captureBattle() const
+{
+	BattleSnapshot snapshot;
+	snapshot.recipe = recipe.at("name").get<std::string>();
+	snapshot.levelIndex = currentLevelIndex;
+	snapshot.ambrosia = ambrosia;
+	snapshot.data = ECS::Snapshot::capture();
+	return snapshot;
+}
+
+void GameStateSystem::restoreBattle(const BattleSnapshot& snapshot)
+{
+	if (snapshot.data.empty() || snapshot.recipe != recipe.at("name").get<std::string>() || snapshot.levelIndex < 0 ||
+			static_cast<size_t>(snapshot.levelIndex) >= recipe.at("maps").size())
+	{
+		throw std::runtime_error("GameStateSystem::restoreBattle: the snapshot isn't of a map of " +
+			recipe.at("name").get<std::string>());
+	}
+
+	PROFILE_SCOPE("restore battle");
+	resetState();
+	currentLevelIndex = snapshot.levelIndex;
+	currentLevel = recipe["maps"][currentLevelIndex];
+
+	std::cout << "GameStateSystem::restoreBattle: restoring " << currentLevel.at("map") << std::endl;
+
+	buildMap();
+	overlayBattle(snapshot);
+	setAmbrosia(snapshot.ambrosia);
+	prefetchNextMap();
+}
+
+void GameStateSystem::buildMap()
+{
 	// Create all entities except for the players
 	removeNonPlayerEntities();
+	ResourceManager::instance().evictUnused(ResourceManager::groupsForLevel(currentLevel));
 	createNonPlayerEntities();
 	createMap();
 
@@ -154,8 +254,103 @@ void GameStateSystem::restartMap()
 	preparePlayersForNextMap();
 }
 
+void GameStateSystem::overlayBattle(const BattleSnapshot& snapshot)
+{
+	// The behaviour tree of the mob whose turn it was belongs to the entities that were just removed
+	EventSystem<EndMobTurnEvent>::instance().sendEvent(EndMobTurnEvent{});
+
+	// The players and the level's mobs were just built, find them by where they came from
+	auto key = [](const SpawnOrigin& origin)
+	{
+		return (static_cast<uint64_t>(origin.kind) << 32) | origin.index;
+	};
+	std::unordered_map<uint64_t, ECS::Entity> built;
+	auto& origins = ECS::registry<SpawnOrigin>();
+	for (size_t i = 0; i < origins.size(); i++)
+	{
+		built[key(origins.components[i])] = origins.entities[i];
+	}
+
+	// Map the snapshot's entities to them, spawning the chunks and mashed potato again
+	std::unordered_map<unsigned int, ECS::Entity> entityMap;
+	for (const auto& saved : ECS::Snapshot::components<SpawnOrigin>(snapshot.data))
+	{
+		const SpawnOrigin& origin = saved.second;
+		if (origin.kind == SpawnOrigin::Kind::POTATO_CHUNK)
+		{
+			entityMap[saved.first] = PotatoChunk::createPotatoChunk(origin.origin, origin.origin);
+		}
+		else if (origin.kind == SpawnOrigin::Kind::MASHED_POTATO)
+		{
+			entityMap[saved.first] = MashedPotato::createMashedPotato(origin.origin);
+		}
+		else
+		{
+			auto it = built.find(key(origin));
+			if (it != built.end())
+			{
+				entityMap[saved.first] = it->second;
+				built.erase(it);
+			}
+		}
+	}
+
+	// The mobs that had already died
+	for (const auto& unmapped : built)
+	{
+		ECS::Entity mob = unmapped.second;
+		if (mob.has<PlayerComponent>())
+		{
+			continue;
+		}
+		if (mob.has<StatsComponent>())
+		{
+			ECS::ContainerInterface::removeAllComponentsOf(mob.get<StatsComponent>().healthBar);
+		}
+		ECS::ContainerInterface::removeAllComponentsOf(mob);
+	}
+
+	ECS::Snapshot::overlay(snapshot.data, entityMap);
+
+	// Skills and behaviour trees aren't part of a snapshot. A player's skill in progress counts as used,
+	// and a mob whose turn it was starts its turn over.
+	const auto activeEntities = ECS::registry<TurnSystem::TurnComponentIsActive>().entities;
+	for (auto entity : activeEntities)
+	{
+		auto& turnComponent = entity.get<TurnSystem::TurnComponent>();
+		turnComponent.activeAction = SkillType::NONE;
+		if (entity.has<AISystem::MobComponent>())
+		{
+			turnComponent.isMoving = false;
+			turnComponent.isUsingSkill = false;
+			turnComponent.hasMoved = false;
+			turnComponent.hasUsedSkill = false;
+
+			auto& motion = entity.get<Motion>();
+			motion.path = std::stack<vec2>();
+			motion.velocity = vec2(0.f, 0.f);
+		}
+		else if (turnComponent.isUsingSkill)
+		{
+			turnComponent.isUsingSkill = false;
+			turnComponent.hasUsedSkill = true;
+		}
+		if (entity.has<SkillComponent>())
+		{
+			entity.get<SkillComponent>().setActiveSkill(SkillType::NONE);
+		}
+
+		EventSystem<PlayerChangeEvent>::instance().sendEvent(PlayerChangeEvent{ entity });
+	}
+}
+
 void GameStateSystem::save()
 {
+	if (!isSavingEnabled)
+	{
+		return;
+	}
+
 	std::cout << "GameStateSystem::save: saving " << recipe["name"]
 						<< ", level " << currentLevelIndex << std::endl;
 
@@ -166,6 +361,19 @@ void GameStateSystem::save()
 	std::cout << skill_levels << std::endl;
 
 	lc.save(recipe["name"], currentLevelIndex, ambrosia, achievements, skill_levels);
+	lc.removeBattle();
+}
+
+void GameStateSystem::saveBattle()
+{
+	if (!isSavingEnabled || !inGameState() || isTransitioning || isInTutorial || recipe.is_null())
+	{
+		return;
+	}
+
+	std::cout << "GameStateSystem::saveBattle: saving the battle of " << recipe["name"]
+						<< ", level " << currentLevelIndex << std::endl;
+	LevelLoader().saveBattle(encodeBattle(captureBattle()));
 }
 
 json GameStateSystem::getSkillsForAllPlayers()
@@ -195,7 +403,23 @@ void GameStateSystem::loadSave()
 	if (save_obj.contains("recipe"))
 	{
 		std::cout << "GameStateSystem::loadSave: a saved game was found" << std::endl;
+		// Read first, loading the recipe saves and so removes it
+		BattleSnapshot battle;
+		const bool hasBattle = decodeBattle(lc.loadBattle(), battle);
 		loadRecipe(save_obj["recipe"], save_obj["skill_levels"], save_obj["level"], save_obj["ambrosia"]);
+
+		if (hasBattle && battle.recipe == save_obj["recipe"].get<std::string>() && battle.levelIndex == save_obj["level"].get<int>())
+		{
+			std::cout << "GameStateSystem::loadSave: resuming the battle in progress" << std::endl;
+			try
+			{
+				restoreBattle(battle);
+			}
+			catch (const std::exception& error)
+			{
+				std::cout << "GameStateSystem::loadSave: can't resume the battle, " << error.what() << std::endl;
+			}
+		}
 	}
 	else
 	{
@@ -208,7 +432,15 @@ void GameStateSystem::loadSave()
 void GameStateSystem::loadRecipe(const std::string& recipeName, json skill_levels, int level,
 																 int ambrosia, bool isInTutorial)
 {
-	std::cout << "GameStateSystem::loadRecipe: loading " << recipeName
+	LevelLoader lc;
+	loadRecipeData(lc.readLevel(recipeName), skill_levels, level, ambrosia, isInTutorial);
+}
+
+void GameStateSystem::loadRecipeData(const json& recipeData, json skill_levels, int level,
+																		 int ambrosia, bool isInTutorial)
+{
+	PROFILE_SCOPE("load recipe");
+	std::cout << "GameStateSystem::loadRecipe: loading " << recipeData["name"]
 						<< ", level " << level << std::endl;
 
 	resetState();
@@ -216,17 +448,19 @@ void GameStateSystem::loadRecipe(const std::string& recipeName, json skill_level
 	this->isInTutorial = isInTutorial;
 	currentLevelIndex = level;
 
-	LevelLoader lc;
-	recipe = lc.readLevel(recipeName);
+	recipe = recipeData;
 	currentLevel = recipe["maps"][currentLevelIndex];
 
 	// Get rid of all entities and create new ones
 	std::cout << skill_levels << std::endl;
 	removeNonPlayerEntities();
 	removePlayerEntities();
+	ResourceManager::instance().evictUnused(ResourceManager::groupsForLevel(currentLevel));
 	createPlayerEntities(skill_levels);
 	createNonPlayerEntities();
 	createMap();
+	levelStartSnapshot = captureBattle();
+	prefetchNextMap();
 
 	save();
 }
@@ -241,6 +475,7 @@ void GameStateSystem::launchMainMenu()
 	Camera::createCamera(vec2(0.f));
 	removeNonPlayerEntities();
 	removePlayerEntities();
+	ResourceManager::instance().evictUnused({});
 	MouseClickFX::createMouseClickFX();
 	vec2 screenBufferSize = getScreenBufferSize();
 	StartMenu::createStartMenu(screenBufferSize.x, screenBufferSize.y);
@@ -357,18 +592,17 @@ void GameStateSystem::launchShopScreen()
 
 const vec2 GameStateSystem::getScreenBufferSize()
 {
-	int frameBufferWidth, frameBufferHeight;
-	glfwGetFramebufferSize(window, &frameBufferWidth, &frameBufferHeight);
-	return vec2(frameBufferWidth, frameBufferHeight);
+	return vec2(frameBufferSize);
 }
 
-void GameStateSystem::setWindow(GLFWwindow* window)
+void GameStateSystem::setFrameBufferSize(ivec2 size)
 {
-	this->window = window;
+	frameBufferSize = size;
 }
 
 void GameStateSystem::preloadResources()
 {
+	PROFILE_SCOPE("preload resources");
 	ECS::ContainerInterface::listAllComponents();
 	std::cout << "Preloading...\n";
 
@@ -384,6 +618,7 @@ void GameStateSystem::preloadResources()
 	removeNonPlayerEntities();
 
 	ECS::ContainerInterface::listAllComponents();
+	ImageCache::instance().printStats();
 	std::cout << "Unload complete.\n";
 }
 
@@ -391,8 +626,8 @@ void GameStateSystem::setAmbrosia(int amt)
 {
 	ambrosia = std::max(0, amt);
 
-	assert(ECS::registry<AmbrosiaDisplay>.entities.size() == 1);
-	auto entity = ECS::registry<AmbrosiaDisplay>.entities.front();
+	assert(ECS::registry<AmbrosiaDisplay>().entities.size() == 1);
+	auto entity = ECS::registry<AmbrosiaDisplay>().entities.front();
 	auto& ambDisplay = entity.get<AmbrosiaDisplay>();
 
 	assert(entity.has<Motion>());
@@ -431,8 +666,8 @@ void GameStateSystem::removePlayerEntities()
 {
 	std::cout << "GameStateSystem::removePlayerEntities: completely removing player entities" << std::endl;
 
-	while (!ECS::registry<PlayerComponent>.entities.empty())
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<PlayerComponent>.entities.back());
+	while (!ECS::registry<PlayerComponent>().entities.empty())
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<PlayerComponent>().entities.back());
 }
 
 void GameStateSystem::hidePlayers()
@@ -459,13 +694,9 @@ void GameStateSystem::createNonPlayerEntities()
 {
 	std::cout << "GameStateSystem::createNonPlayerEntities: creating the non-player entities for current map" << std::endl;
 
-	// Get screen/buffer size
-	int frameBufferWidth, frameBufferHeight;
-	glfwGetFramebufferSize(window, &frameBufferWidth, &frameBufferHeight);
-
 	Camera::createCamera(currentLevel.at("camera"));
 	createMobs();
-	createButtons(frameBufferWidth, frameBufferHeight);
+	createButtons(frameBufferSize.x, frameBufferSize.y);
 	createEffects();
 	createAmbrosiaUI();
 	setAmbrosia(ambrosia);
@@ -475,25 +706,48 @@ void GameStateSystem::removeNonPlayerEntities()
 {
 	std::cout << "GameStateSystem::removeNonPlayerEntities: completely removing all non-player entities" << std::endl;
 
-	auto removeEntities = [=](std::vector<ECS::Entity>& entities)
+	// Also a sync point, nothing that was deferred should outlive the level
+	ECS::CommandBuffer::instance().playback();
+
+	std::vector<ECS::Entity> toRemove;
+	auto collectEntities = [&](const std::vector<ECS::Entity>& entities)
 	{
-		for (int i = entities.size() - 1; i >= 0; i--)
+		for (auto entity : entities)
 		{
-			auto entity = entities[i];
 			if (!entity.has<PlayerComponent>() && !(entity.has<AchievementPopup>() && isInVictoryScreen))
 			{
-				ECS::ContainerInterface::removeAllComponentsOf(entity);
+				toRemove.push_back(entity);
 			}
 		}
 	};
 
-	removeEntities(ECS::registry<Motion>.entities);
-	removeEntities(ECS::registry<Text>.entities);
+	collectEntities(ECS::registry<Motion>().entities);
+	collectEntities(ECS::registry<Text>().entities);
+	ECS::ContainerInterface::removeAllComponentsOf(toRemove);
+
+	// Also recycle the ids of entities created during the level that never got any components
+	size_t numOrphans = ECS::EntityManager::destroyOrphans();
+	std::cout << "GameStateSystem::removeNonPlayerEntities: recycled " << numOrphans << " orphaned entity ids, "
+		<< ECS::EntityManager::numAlive() << " entities alive" << std::endl;
+
+	// The components of the removed entities were the last users of the level's memory. The component
+	// containers themselves keep their capacity, so the next level fills them without reallocating.
+	LevelArena::printStats();
+	LevelArena::release();
+}
+
+void GameStateSystem::prefetchNextMap()
+{
+	if (static_cast<size_t>(currentLevelIndex) + 1 < recipe["maps"].size())
+	{
+		ResourceManager::instance().prefetch(ResourceManager::groupsForLevel(recipe["maps"][currentLevelIndex + 1]));
+	}
 }
 
 void GameStateSystem::createMap()
 {
 	std::string mapName = currentLevel.at("map");
+	ResourceManager::ScopedGroup resourceGroup("map:" + mapName);
 
 	std::cout << "GameStateSystem::createMap: creating the " << mapName << " map" << std::endl;
 
@@ -515,9 +769,9 @@ void GameStateSystem::createMap()
 		DessertForeground::createDessertForeground(vec2(2291.f, 772.f));
 		DessertBackground::createDessertBackground(vec2(1920.f, 672.f));
 		EventSystem<AddEmitterEvent>::instance().sendEvent(
-				AddEmitterEvent{ "pinkCottonCandy",std::make_shared<BasicEmitter>(BasicEmitter(5)) });
+				AddEmitterEvent{ "pinkCottonCandy", EmitterType::BASIC, 5 });
 		EventSystem<AddEmitterEvent>::instance().sendEvent(
-				AddEmitterEvent{ "blueCottonCandy", std::make_shared<BlueCottonCandyEmitter>(BlueCottonCandyEmitter(5)) });
+				AddEmitterEvent{ "blueCottonCandy", EmitterType::BLUE_COTTON_CANDY, 5 });
 	}
 	else if (mapName == "veggie-forest")
 	{
@@ -568,9 +822,9 @@ void GameStateSystem::createButtons(int frameBufferWidth, int frameBufferHeight)
 	SkillButton::createMoveButton({ 100, frameBufferHeight - 80 }, "skill_buttons/skill_generic_move",
 																[]() {
 																	std::cout << "Move button clicked!" << std::endl;
-																	if (!ECS::registry<TurnSystem::TurnComponentIsActive>.entities.empty())
+																	if (!ECS::registry<TurnSystem::TurnComponentIsActive>().entities.empty())
 																	{
-																		auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities.front();
+																		auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities.front();
 																		if (!activeEntity.has<PlayerComponent>())
 																		{
 																			return;
@@ -598,9 +852,9 @@ void GameStateSystem::createButtons(int frameBufferWidth, int frameBufferHeight)
 																 []() {
 																	 std::cout << "Skill one button clicked!" << std::endl;
 
-																	 if (!ECS::registry<TurnSystem::TurnComponentIsActive>.entities.empty())
+																	 if (!ECS::registry<TurnSystem::TurnComponentIsActive>().entities.empty())
 																	 {
-																		 auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities.front();
+																		 auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities.front();
 																		 if (!activeEntity.has<PlayerComponent>())
 																		 {
 																			 return;
@@ -628,9 +882,9 @@ void GameStateSystem::createButtons(int frameBufferWidth, int frameBufferHeight)
 																 []() {
 																	 std::cout << "Skill two button clicked!" << std::endl;
 
-																	 if (!ECS::registry<TurnSystem::TurnComponentIsActive>.entities.empty())
+																	 if (!ECS::registry<TurnSystem::TurnComponentIsActive>().entities.empty())
 																	 {
-																		 auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities.front();
+																		 auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities.front();
 																		 if (!activeEntity.has<PlayerComponent>())
 																		 {
 																			 return;
@@ -653,9 +907,9 @@ void GameStateSystem::createButtons(int frameBufferWidth, int frameBufferHeight)
 																 []() {
 																	 std::cout << "Skill three button clicked!" << std::endl;
 
-																	 if (!ECS::registry<TurnSystem::TurnComponentIsActive>.entities.empty())
+																	 if (!ECS::registry<TurnSystem::TurnComponentIsActive>().entities.empty())
 																	 {
-																		 auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities.front();
+																		 auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities.front();
 																		 if (!activeEntity.has<PlayerComponent>())
 																		 {
 																			 return;
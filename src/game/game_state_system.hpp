@@ -1,3 +1,4 @@
+#pragma once
 #include "common.hpp"
 #include "event_system.hpp"
 #include "events.hpp"
@@ -5,19 +6,25 @@
 
 #include "../ext/nlohmann/json.hpp"
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 using json = nlohmann::json;
 
 class GameStateSystem {
 private:
+	friend class ECS::World;
+
 	GameStateSystem();
 	~GameStateSystem();
 	void resetState();
 
 public:
-	// Returns the singleton instance of this system
+	// Returns the instance of this system for the current ECS::World, so that simulated battles
+	// have their own game state
 	static GameStateSystem& instance() {
-		static GameStateSystem gameStateSystem;
-		return gameStateSystem;
+		return ECS::World::current().resource<GameStateSystem>();
 	}
 
 	bool inGameState();
@@ -26,15 +33,36 @@ public:
 	void beginStory();
 	void beginTutorial();
 	void nextMap();
+	// Starts the current map over, from the state it was in the first time it started
 	void restartMap();
 
+	// A battle on one map of a recipe, see ECS::Snapshot
+	struct BattleSnapshot
+	{
+		std::string recipe;
+		int levelIndex = -1;
+		int ambrosia = 0;
+		std::vector<uint8_t> data;
+	};
+	BattleSnapshot captureBattle() const;
+	// Builds the snapshot's map from the level data again, then brings its players, mobs and ambrosia back to the
+	// state they were in. Whatever an entity was doing at the time (a skill, a mob's turn) starts over.
+	// Throws std::runtime_error if the snapshot isn't of a map of the current recipe.
+	void restoreBattle(const BattleSnapshot& snapshot);
+
 	void save();
+	// Writes the battle in progress next to the save, for loadSave() to resume it. Does nothing outside
+	// of a battle. The next save() removes it, as the level it was in is then over.
+	void saveBattle();
 
 	json getSkillsForAllPlayers();
 
 	void loadSave();
 	void loadRecipe(const std::string& recipeName, json skill_levels = "", int level = 0,
 									int ambrosia = 0, bool isInTutorial = false);
+	// Same as loadRecipe, for a recipe that isn't read from data/levels, e.g. a variant made by a balancing tool
+	void loadRecipeData(const json& recipeData, json skill_levels = "", int level = 0,
+									int ambrosia = 0, bool isInTutorial = false);
 	void launchMainMenu();
 	void launchAchievementsScreen();
 	void launchCreditsScreen();
@@ -44,7 +72,8 @@ public:
 	void launchShopScreen();
 
 	const vec2 getScreenBufferSize();
-	void setWindow(GLFWwindow* window);
+	// Size of the window's frame buffer, or of the screen the headless build pretends to have
+	void setFrameBufferSize(ivec2 size);
 	void preloadResources();
 
 	inline int getAmbrosia() const {return ambrosia;}
@@ -71,6 +100,12 @@ private:
 	void createNonPlayerEntities();
 	void removeNonPlayerEntities();
 	void createMap();
+	// Builds the current map for a new battle, the players included
+	void buildMap();
+	// Applies a snapshot to the entities of a battle that was just built, the ambrosia aside
+	void overlayBattle(const BattleSnapshot& snapshot);
+	// Loads the resources of the next map in the recipe ahead of time
+	void prefetchNextMap();
 	void createMobs();
 	void createButtons(int frameBufferWidth, int frameBufferHeight);
 	void createEffects();
@@ -90,6 +125,8 @@ public:
 	bool isInShopScreen;
 	bool isTransitioning;
 	bool isInspecting;
+	// Off in the headless build, so that simulated battles don't overwrite the player's save
+	bool isSavingEnabled;
 	json currentLevel;
 	json recipe;
 	int currentLevelIndex;
@@ -100,10 +137,13 @@ private:
 	int ambrosia;
 	EventListenerInfo depositAmbrosiaListener;
 
+	// Taken when a map starts for the first time, what restartMap() goes back to
+	BattleSnapshot levelStartSnapshot;
+
 	ECS::Entity playerRaoul;
 	ECS::Entity playerTaji;
 	ECS::Entity playerEmber;
 	ECS::Entity playerChia;
 
-	GLFWwindow* window;
+	ivec2 frameBufferSize;
 };
\ No newline at end of file
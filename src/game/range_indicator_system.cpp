@@ -72,9 +72,9 @@ void RangeIndicatorSystem::onRangeIndicatorChange(const ChangeRangeIndicatorEven
 		activeSkillUsesMouseLoc = false;
 		
 		//Create a range indicator
-		rangeIndicator = ECS::Entity();
+		rangeIndicator = ECS::Entity::create();
 		ShadedMesh& resource = cacheResource("range_indicator");
-		if (resource.effect.program.resource == 0)
+		if (resource.effect.program == 0)
 		{
 			RenderSystem::createSprite(resource, texturesPath("circle-blue-overlay.png"), "textured");
 		}
@@ -87,7 +87,7 @@ void RangeIndicatorSystem::onRangeIndicatorChange(const ChangeRangeIndicatorEven
 		//set the center position for the range indicator
 		//TODO check if the skill is using a MouseClickProvider
 	
-		auto& motion = ECS::registry<Motion>.emplace(rangeIndicator);
+		auto& motion = ECS::registry<Motion>().emplace(rangeIndicator);
 
 		//Check if the skillParam is an AoESkillParam
 		if (auto aoeSkillsParam = std::dynamic_pointer_cast<AoESkillParams>(skill->getParams())) {
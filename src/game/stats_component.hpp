@@ -1,6 +1,7 @@
 #pragma once
 #include "common.hpp"
 #include "entities/tiny_ecs.hpp"
+#include "entities/snapshot.hpp"
 
 enum class StatType
 {
@@ -30,6 +31,7 @@ struct StatModifier
 class StatsComponent
 {
 	friend class StatsSystem;
+	friend struct ECS::Serializer<StatsComponent>;
 public:
 	StatsComponent() = default;
 	~StatsComponent() = default;
@@ -289,7 +289,7 @@ void StatsSystem::onHealEvent(const HealEvent &event)
 
 void StatsSystem::onStartNextRoundEvent(const StartNextRoundEvent& event)
 {
-	for (auto entity : ECS::registry<StatsComponent>.entities)
+	for (auto entity : ECS::registry<StatsComponent>().entities)
 	{
 		auto& statsComponent = entity.get<StatsComponent>();
 		std::vector<StatType> toRemove;
@@ -0,0 +1,172 @@
+#include "system_scheduler.hpp"
+#include "jobs/job_system.hpp"
+#include "profiling/profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const
+{
+	if (isExclusive || other.isExclusive)
+		return true;
+	if (isStructural && other.isStructural)
+		return true;
+
+	return (writeSet & (other.readSet | other.writeSet)).any() || (other.writeSet & readSet).any();
+}
+
+void SystemScheduler::add(const std::string& name, std::function<void()> step, const SystemAccess& access)
+{
+	SystemNode node;
+	node.name = name;
+	node.profileName = Profiler::instance().intern(name);
+	node.step = std::move(step);
+	node.access = access;
+	systems.push_back(std::move(node));
+	isGraphDirty = true;
+}
+
+void SystemScheduler::buildGraph()
+{
+	for (auto& system : systems)
+	{
+		system.successors.clear();
+		system.numPredecessors = 0;
+	}
+
+	// Every conflicting pair is ordered like it was added. Edges that are implied by a path through
+	// another system could be skipped, but the graph is tiny and the extra edges are harmless.
+	for (size_t i = 0; i < systems.size(); i++)
+	{
+		for (size_t j = i + 1; j < systems.size(); j++)
+		{
+			if (systems[i].access.conflictsWith(systems[j].access))
+			{
+				systems[i].successors.push_back(j);
+				systems[j].numPredecessors++;
+			}
+		}
+	}
+	isGraphDirty = false;
+}
+
+void SystemScheduler::run()
+{
+	if (isGraphDirty)
+		buildGraph();
+
+	const size_t numSystems = systems.size();
+	std::unique_ptr<std::atomic<int>[]> remainingPredecessors(new std::atomic<int>[numSystems]);
+	for (size_t i = 0; i < numSystems; i++)
+		remainingPredecessors[i] = systems[i].numPredecessors;
+
+	std::mutex mutex;
+	std::condition_variable systemFinished;
+	std::vector<size_t> readyOnMainThread;
+	size_t numFinished = 0;
+	std::exception_ptr error;
+
+	std::function<void(size_t)> schedule;
+	auto execute = [&](size_t index) {
+		try
+		{
+			PROFILE_SCOPE(systems[index].profileName);
+			systems[index].step();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!error)
+				error = std::current_exception();
+		}
+
+		for (size_t successor : systems[index].successors)
+		{
+			if (--remainingPredecessors[successor] == 0)
+				schedule(successor);
+		}
+
+		// Notify while holding the lock, run() may return (and destroy these) as soon as it's released
+		std::lock_guard<std::mutex> lock(mutex);
+		numFinished++;
+		systemFinished.notify_all();
+	};
+	schedule = [&](size_t index) {
+		if (systems[index].access.isMainThread)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			readyOnMainThread.push_back(index);
+			systemFinished.notify_all();
+		}
+		else
+		{
+			JobSystem::instance().submit([&execute, index]() { execute(index); });
+		}
+	};
+
+	for (size_t i = 0; i < numSystems; i++)
+	{
+		if (systems[i].numPredecessors == 0)
+			schedule(i);
+	}
+
+	while (true)
+	{
+		size_t next = numSystems;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			if (numFinished == numSystems)
+				break;
+
+			if (readyOnMainThread.empty())
+			{
+				lock.unlock();
+				if (JobSystem::instance().runPendingJob())
+					continue;
+
+				lock.lock();
+				systemFinished.wait(lock, [&]() { return numFinished == numSystems || !readyOnMainThread.empty(); });
+				continue;
+			}
+
+			// Lowest index first, so the main thread order is the same every step
+			auto it = std::min_element(readyOnMainThread.begin(), readyOnMainThread.end());
+			next = *it;
+			readyOnMainThread.erase(it);
+		}
+		execute(next);
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void SystemScheduler::runSerially()
+{
+	for (auto& system : systems)
+	{
+		PROFILE_SCOPE(system.profileName);
+		system.step();
+	}
+}
+
+void SystemScheduler::printGraph()
+{
+	if (isGraphDirty)
+		buildGraph();
+
+	std::cout << "SystemScheduler: " << systems.size() << " systems\n";
+	for (const auto& system : systems)
+	{
+		std::cout << "  " << system.name << (system.access.isMainThread ? " [main]" : "") << " ->";
+		for (size_t successor : system.successors)
+			std::cout << " " << systems[successor].name;
+		std::cout << '\n';
+	}
+	std::cout.flush();
+}
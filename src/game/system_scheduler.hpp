@@ -0,0 +1,75 @@
+#pragma once
+#include "entities/tiny_ecs.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// What a system touches while it steps, used by the SystemScheduler to tell which systems may run
+// at the same time. Declare it conservatively: a missing write is a data race.
+struct SystemAccess
+{
+	ECS::Signature readSet;
+	ECS::Signature writeSet;
+	bool isStructural = false; // creates or destroys entities, adds or removes components, or records into the CommandBuffer
+	bool isMainThread = false; // uses GL, GLFW or other state that only the main thread may touch
+	bool isExclusive = false;  // sends events or changes global state, so it can't overlap with anything
+
+	template<class... Components>
+	SystemAccess& reads()
+	{
+		int expand[] = { 0, (readSet.set(ECS::componentTypeId<Components>()), 0)... };
+		(void)expand;
+		return *this;
+	}
+
+	template<class... Components>
+	SystemAccess& writes()
+	{
+		int expand[] = { 0, (writeSet.set(ECS::componentTypeId<Components>()), 0)... };
+		(void)expand;
+		return *this;
+	}
+
+	inline SystemAccess& structural() { isStructural = true; return *this; }
+	inline SystemAccess& mainThread() { isMainThread = true; return *this; }
+	inline SystemAccess& exclusive() { isExclusive = true; isMainThread = true; return *this; }
+
+	bool conflictsWith(const SystemAccess& other) const;
+};
+
+// Runs the systems of one update step. Two systems conflict if either is exclusive, both are
+// structural, or one writes a component the other reads or writes. Conflicting systems always
+// run in the order they were added, so the results are deterministic; everything else runs
+// concurrently on the JobSystem's workers. Every step is timed by the Profiler.
+class SystemScheduler
+{
+public:
+	void add(const std::string& name, std::function<void()> step, const SystemAccess& access);
+
+	// Runs every system once and returns when all of them are done. Main thread systems run on the
+	// calling thread, which also helps out with the other jobs while it waits.
+	void run();
+	// Runs every system once on the calling thread, in the order they were added. For threads that
+	// already run alongside others, e.g. one of a batch of simulated battles.
+	void runSerially();
+
+	void printGraph();
+
+private:
+	struct SystemNode
+	{
+		std::string name;
+		// The name the Profiler records the step under
+		const char* profileName;
+		std::function<void()> step;
+		SystemAccess access;
+		std::vector<size_t> successors;
+		int numPredecessors = 0;
+	};
+
+	void buildGraph();
+
+	std::vector<SystemNode> systems;
+	bool isGraphDirty = false;
+};
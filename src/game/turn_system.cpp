@@ -59,13 +59,13 @@ void TurnSystem::nextActiveEntity()
 {
 	std::cout << "nextActiveEntity: switching to the next active entity \n";
 	//Remove the active entity
-	ECS::registry<TurnComponentIsActive>.clear();
+	ECS::registry<TurnComponentIsActive>().clear();
 
 	auto tryToSetActiveEntity = [](const vector<ECS::Entity> entities)
 	{
 		for (auto entity : entities)
 		{
-			auto& turnComponent = ECS::registry<TurnComponent>.get(entity);
+			auto& turnComponent = ECS::registry<TurnComponent>().get(entity);
 
 			// Skip the turn of stunned entities
 			if (entity.has<StatsComponent>() &&
@@ -77,7 +77,7 @@ void TurnSystem::nextActiveEntity()
 
 			if (!hasCompletedTurn(turnComponent) && !entity.has<DeathTimer>())
 			{
-				ECS::registry<TurnComponentIsActive>.emplace(entity);
+				ECS::registry<TurnComponentIsActive>().emplace(entity);
 				EventSystem<PlayerChangeEvent>::instance().sendEvent(PlayerChangeEvent{ entity });
 				break;
 			}
@@ -85,7 +85,7 @@ void TurnSystem::nextActiveEntity()
 	};
 
 	//Sort the vector of players that are alive based on the player enum. I had to create this temp variable because if i sorted directly on the registy it broke.
-	auto playerEntities = ECS::registry<PlayerComponent>.entities;
+	auto playerEntities = ECS::registry<PlayerComponent>().entities;
 	std::sort(playerEntities.begin(), playerEntities.end(), [](ECS::Entity a, ECS::Entity b) {
 		return a.get<PlayerComponent>().player < b.get<PlayerComponent>().player;
 		});
@@ -94,12 +94,12 @@ void TurnSystem::nextActiveEntity()
 	
 
 	// If all the players have gone start going through all the mobs
-	if (ECS::registry<TurnComponentIsActive>.size() == 0)
+	if (ECS::registry<TurnComponentIsActive>().size() == 0)
 	{
-		tryToSetActiveEntity(ECS::registry<AISystem::MobComponent>.entities);
+		tryToSetActiveEntity(ECS::registry<AISystem::MobComponent>().entities);
 	}
 
-	if (ECS::registry<TurnComponentIsActive>.size() == 0)
+	if (ECS::registry<TurnComponentIsActive>().size() == 0)
 	{
 		//All entities have gone so end the turn
 		nextTurn();
@@ -111,20 +111,20 @@ void TurnSystem::changeActiveEntity(ECS::Entity nextEntity)
 {
 	//Make sure the nextEntity has a TurnComponent
 	assert(nextEntity.has<TurnComponent>());
-	auto& turnComponent = ECS::registry<TurnComponent>.get(nextEntity);
+	auto& turnComponent = ECS::registry<TurnComponent>().get(nextEntity);
 	if (!hasCompletedTurn(turnComponent)) {
 		//Check if the selected player is the current active player
-		assert(!ECS::registry<TurnComponentIsActive>.entities.empty());
-		if (nextEntity.id == ECS::registry<TurnComponentIsActive>.entities[0].id) {
+		assert(!ECS::registry<TurnComponentIsActive>().entities.empty());
+		if (nextEntity.id == ECS::registry<TurnComponentIsActive>().entities[0].id) {
 			std::cout << "The requested player is already the active player\n";
 		}
 		else {
 			std::cout << "\nSwitching to the next active entity\n";
 			//Remove the active entity
-			ECS::registry<TurnComponentIsActive>.clear();
+			ECS::registry<TurnComponentIsActive>().clear();
 
 			//Set the activeEntity to the nextEntity
-			ECS::registry<TurnComponentIsActive>.emplace(nextEntity);
+			ECS::registry<TurnComponentIsActive>().emplace(nextEntity);
 			EventSystem<PlayerChangeEvent>::instance().sendEvent(PlayerChangeEvent{ nextEntity });
 		}
 	}
@@ -138,9 +138,9 @@ void TurnSystem::nextTurn()
 {
 	std::cout << "Starting the next turn\n";
 	//Clear the register for TurnComponentIsActive
-	ECS::registry<TurnComponentIsActive>.clear();
+	ECS::registry<TurnComponentIsActive>().clear();
 	//Loop through all TurnComponents and set all the attributes back to false
-	auto& registry = ECS::registry<TurnComponent>;
+	auto& registry = ECS::registry<TurnComponent>();
 	for (unsigned int i = 0; i < registry.components.size(); i++) {
 		auto& turnComponent = registry.components[i];
 		turnComponent.isMoving = false;
@@ -166,19 +166,19 @@ void TurnSystem::step(float elapsed_ms)
 	// The turn system should only run if enough time has passed since the last
 	// movement or skill was performed AND if there are no active projectiles
 	// (e.g., ambrosia projectiles)
-	if (timer > 0.f || !ECS::registry<ProjectileComponent>.components.empty())
+	if (timer > 0.f || !ECS::registry<ProjectileComponent>().components.empty())
 	{
 		return;
 	}
 	timer = 0.f;
 
 	//If there is no active entity (this could be due to a restart) get the next active entity
-	if (ECS::registry<TurnComponentIsActive>.entities.empty()) {
+	if (ECS::registry<TurnComponentIsActive>().entities.empty()) {
 		std::cout << "There is no active entity\n";
 		nextActiveEntity();
 	}
 	// Check happens with above if statement.
-	auto& activeEntity = ECS::registry<TurnComponentIsActive>.entities[0];
+	auto& activeEntity = ECS::registry<TurnComponentIsActive>().entities[0];
 	if (!activeEntity.has<DeathTimer>()) 
 	{
 		if (activeEntity.has<TurnComponent>()) 
@@ -193,8 +193,8 @@ void TurnSystem::step(float elapsed_ms)
 					EventSystem<EndMobTurnEvent>::instance().sendEvent(EndMobTurnEvent{});
 				}
 				// Add a hardcoded delay before moving the camera so player can see animations
-				assert(!ECS::registry<CameraComponent>.entities.empty());
-				auto camera = ECS::registry<CameraComponent>.entities[0];
+				assert(!ECS::registry<CameraComponent>().entities.empty());
+				auto camera = ECS::registry<CameraComponent>().entities[0];
 				camera.emplace<CameraDelayedMoveComponent>(0.4f);
 				nextActiveEntity();
 			}
@@ -227,7 +227,7 @@ void TurnSystem::step(float elapsed_ms)
 bool TurnSystem::playersLeft()
 {
 	bool playersLeft = false;
-	auto& playerContainer = ECS::registry<PlayerComponent>;
+	auto& playerContainer = ECS::registry<PlayerComponent>();
 	for (ECS::Entity player : playerContainer.entities)
 	{
 		if (!player.has<DeathTimer>())
@@ -243,12 +243,12 @@ bool TurnSystem::hasCompletedTurn(TurnComponent tc)
 
 void TurnSystem::onMouseClick(const MouseClickEvent& event)
 {
-	if (ECS::registry<TurnComponentIsActive>.entities.empty())
+	if (ECS::registry<TurnComponentIsActive>().entities.empty())
 	{
 		return;
 	}
 
-	auto& activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	auto& activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 
 	// Check that it's a player and has a TurnComponent
 	if (activeEntity.has<PlayerComponent>() && activeEntity.has<TurnComponent>())
@@ -295,9 +295,9 @@ void TurnSystem::onMouseClick(const MouseClickEvent& event)
 void TurnSystem::onPlayerButtonClick(const PlayerButtonEvent& event)
 {
 	// Can't change players if the current active player is busy with movement or a skill
-	if (!ECS::registry<TurnComponentIsActive>.entities.empty())
+	if (!ECS::registry<TurnComponentIsActive>().entities.empty())
 	{
-		auto activeEntity = ECS::registry<TurnComponentIsActive>.entities.front();
+		auto activeEntity = ECS::registry<TurnComponentIsActive>().entities.front();
 
 		if (activeEntity.has<TurnComponent>())
 		{
@@ -311,7 +311,7 @@ void TurnSystem::onPlayerButtonClick(const PlayerButtonEvent& event)
 	}
 
 	// look for player entity that matches player in event
-	for (auto entity : ECS::registry<PlayerComponent>.entities)
+	for (auto entity : ECS::registry<PlayerComponent>().entities)
 	{
 		auto& player = entity.get<PlayerComponent>().player;
 		if (event.player == player) {
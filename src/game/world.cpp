@@ -1,5 +1,6 @@
 #include "world.hpp"
 #include "camera.hpp"
+#include "camera_system.hpp"
 #include "event_system.hpp"
 #include "events.hpp"
 
@@ -7,7 +8,16 @@
 #include "physics/projectile.hpp"
 #include "physics/debug.hpp"
 #include "entities/enemies.hpp"
+#include "entities/command_buffer.hpp"
 #include "rendering/render_components.hpp"
+#include "rendering/resource_manager.hpp"
+#include "rendering/perf_overlay.hpp"
+#include "jobs/job_system.hpp"
+#include "memory/allocation_counter.hpp"
+#include "memory/frame_arena.hpp"
+#include "memory/level_arena.hpp"
+#include "profiling/profiler.hpp"
+#include "replay/input_replay.hpp"
 #include "animation/animation_components.hpp"
 #include "ui/button.hpp"
 #include "ui/ui_system.hpp"
@@ -27,13 +37,23 @@
 #include <cassert>
 #include <sstream>
 #include <iostream>
+
+namespace
+{
+	// While replaying, the live input is ignored, except for the performance overlay and the profiler
+	bool isLiveInput(int key)
+	{
+		return !InputReplay::instance().isReplaying() || key == GLFW_KEY_F2 || key == GLFW_KEY_F3;
+	}
+}
+
 // Create the world
 // Note, this has a lot of OpenGL specific things, could be moved to the renderer; but it also defines the callbacks to the mouse and keyboard. That is why it is called here.
 WorldSystem::WorldSystem(ivec2 window_size_px) :
 	shouldPlayAudioAtStartOfTurn(false)
 {
-	// Seeding rng with random device
-	rng = std::default_random_engine(std::random_device()());
+	// Seeding rng with random device, or with the seed of the recorded session
+	rng = std::default_random_engine(InputReplay::instance().seedFor("world"));
 
 	///////////////////////////////////////
 	// Initialize GLFW
@@ -63,12 +83,30 @@ WorldSystem::WorldSystem(ivec2 window_size_px) :
 	// Input is handled using GLFW, for more info see
 	// http://www.glfw.org/docs/latest/input_guide.html
 	glfwSetWindowUserPointer(window, this);
-	auto keyRedirect = [](GLFWwindow* wnd, int _0, int _1, int _2, int _3) { ((WorldSystem*)glfwGetWindowUserPointer(wnd))->onKey(_0, _1, _2, _3); };
-	auto mouseClickRedirect = [](GLFWwindow* wnd, int _0, int _1, int _2) { ((WorldSystem*)glfwGetWindowUserPointer(wnd))->onMouseClick(_0, _1, _2); };
+	auto keyRedirect = [](GLFWwindow* wnd, int _0, int _1, int _2, int _3) {
+		if (!isLiveInput(_0))
+			return;
+		InputReplay::instance().recordKey(_0, _2, _3);
+		((WorldSystem*)glfwGetWindowUserPointer(wnd))->onKey(_0, _1, _2, _3);
+	};
+	auto mouseClickRedirect = [](GLFWwindow* wnd, int _0, int _1, int _2) {
+		if (!isLiveInput(-1))
+			return;
+		double mousePosX, mousePosY;
+		glfwGetCursorPos(wnd, &mousePosX, &mousePosY);
+		const vec2 mousePos(mousePosX, mousePosY);
+		InputReplay::instance().recordMouseClick(_0, _1, _2, mousePos);
+		((WorldSystem*)glfwGetWindowUserPointer(wnd))->onMouseClick(_0, _1, _2, mousePos);
+	};
 	glfwSetKeyCallback(window, keyRedirect);
 	glfwSetMouseButtonCallback(window, mouseClickRedirect);
 
-	auto mouseHoverRedirect = [](GLFWwindow* wnd, double _0, double _1) { ((WorldSystem*)glfwGetWindowUserPointer(wnd))->onMouseHover(_0, _1); };
+	auto mouseHoverRedirect = [](GLFWwindow* wnd, double _0, double _1) {
+		if (!isLiveInput(-1))
+			return;
+		InputReplay::instance().recordMouseHover(vec2(_0, _1));
+		((WorldSystem*)glfwGetWindowUserPointer(wnd))->onMouseHover(_0, _1);
+	};
 	glfwSetCursorPosCallback(window, mouseHoverRedirect);
 
 	initAudio();
@@ -105,87 +143,20 @@ void WorldSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 		return;
 	}
 	// Updating window title
-	std::stringstream title_ss;
+	FrameStringStream title_ss;
 	title_ss << "Ambrosia";
 	glfwSetWindowTitle(window, title_ss.str().c_str());
 
 	// Check for player defeat
-	assert(ECS::registry<ScreenState>.components.size() == 1);
-	auto& screen = ECS::registry<ScreenState>.components[0];
-
-	for (auto entity : ECS::registry<DeathTimer>.entities)
-	{
-		// Progress timer
-		auto& counter = ECS::registry<DeathTimer>.get(entity);
-		counter.counter_ms -= elapsed_ms;
-
-		// Remove player/mob once death timer expires
-		if (counter.counter_ms < 0)
-		{
-
-			// this has to go here, so the new chunks are added to mobs before the potato is removed
-			if (ECS::registry<HasSwarmBehaviour>.has(entity))
-			{
-				SwarmBehaviour sb;
-				sb.spawnExplodedChunks(entity);
-			}
-
-			//If the entity has a stats component get rid of the health bar too
-			if (entity.has<StatsComponent>()) {
-				ECS::ContainerInterface::removeAllComponentsOf(entity.get<StatsComponent>().healthBar);
-			}
-
-			if (entity.has<PlayerComponent>())
-			{
-				// For player deaths, disable their rendering but keep everything else
-				Player::disableRendering(entity);
-			}
-			else
-			{
-				// For mob deaths, get rid of all their components
-				ECS::ContainerInterface::removeAllComponentsOf(entity);
-			}
-
-			// Check if there are no more players left, restart game
-			auto& players = ECS::registry<PlayerComponent>.entities;
-			int numAlive = std::count_if(players.begin(), players.end(), [](ECS::Entity e)
-			{
-				return !e.has<DeathTimer>();
-			});
+	assert(ECS::registry<ScreenState>().components.size() == 1);
+	auto& screen = ECS::registry<ScreenState>().components[0];
 
-			if (numAlive == 0 && !GameStateSystem::instance().isTransitioning)
-			{
-				GameStateSystem::instance().isTransitioning = true;
-				EventSystem<PlaySoundEffectEvent>::instance().sendEvent({ SoundEffect::GAME_OVER });
-				TransitionEvent event;
-				event.callback = []() {
-					GameStateSystem::instance().launchDefeatScreen();
-				};
-				EventSystem<TransitionEvent>::instance().sendEvent(event);
-				return;
-			}
-		}
-	}
-	// If all mobs are dead and there are no active projectiles (e.g., ambrosia
-	// projectiles), then go to the victory screen
-	if (ECS::registry<AISystem::MobComponent>.entities.empty() &&
-			ECS::registry<ProjectileComponent>.components.empty())
-	{
-		if (!GameStateSystem::instance().isTransitioning)
-		{
-			GameStateSystem::instance().isTransitioning = true;
-			TransitionEvent event;
-			event.callback = []() {
-				GameStateSystem::instance().launchVictoryScreen();
-			};
-			EventSystem<TransitionEvent>::instance().sendEvent(event);
-		}
-	}
+	battle.step(elapsed_ms);
 }
 
 void WorldSystem::processTimers(float elapsed_ms)
 {
-	for (auto& timer : ECS::registry<TimerComponent>.components)
+	for (auto& timer : ECS::registry<TimerComponent>().components)
 	{
 		if (timer.isCountingUp)
 		{
@@ -211,9 +182,9 @@ void WorldSystem::processTimers(float elapsed_ms)
 		}
 	}
 
-	for (int i = 0; i < ECS::registry<AchievementPopup>.entities.size(); i++)
+	for (int i = 0; i < ECS::registry<AchievementPopup>().entities.size(); i++)
 	{
-		auto& achievementPopup = ECS::registry<AchievementPopup>.entities[i];
+		auto& achievementPopup = ECS::registry<AchievementPopup>().entities[i];
 		auto& achievementTimer = achievementPopup.get<TimerComponent>();
 		if (achievementTimer.counter_ms == achievementTimer.maxTime_ms)
 		{
@@ -222,9 +193,9 @@ void WorldSystem::processTimers(float elapsed_ms)
 	}
 
 	// update screen state with its timer
-	if (!ECS::registry<ScreenState>.entities.empty())
+	if (!ECS::registry<ScreenState>().entities.empty())
 	{
-		auto& screenEntity = ECS::registry<ScreenState>.entities.front();
+		auto& screenEntity = ECS::registry<ScreenState>().entities.front();
 		if (screenEntity.has<TimerComponent>())
 		{
 			auto& screenTimer = screenEntity.get<TimerComponent>();
@@ -262,27 +233,7 @@ void WorldSystem::processTimers(float elapsed_ms)
 // Compute collisions between entities
 void WorldSystem::handleCollisions()
 {
-	if (GameStateSystem::instance().inGameState()) 
-	{
-		// Loop over all collisions detected by the physics system
-		auto& registry = ECS::registry<PhysicsSystem::Collision>;
-		for (unsigned int i = 0; i < registry.components.size(); i++)
-		{
-			// The entity and its collider
-			auto entity = registry.entities[i];
-			auto entity_other = registry.components[i].other;
-
-			// Check for projectiles colliding with the player or mobs
-			if (ECS::registry<ProjectileComponent>.has(entity))
-			{
-				auto& projComponent = entity.get<ProjectileComponent>();
-				projComponent.processCollision(entity_other);
-			}
-		}
-
-		// Remove all collisions from this simulation step
-		ECS::registry<PhysicsSystem::Collision>.clear();
-	}
+	battle.handleCollisions();
 }
 
 // Should the game be over ?
@@ -304,6 +255,15 @@ void WorldSystem::onKey(int key, int, int action, int mod)
 		ECS::ContainerInterface::listAllComponents();
 	}
 
+	// Debug printout of the GPU resources and their memory usage, of the worker threads and of the heap usage
+	if (action == GLFW_RELEASE && key == GLFW_KEY_R) {
+		ResourceManager::instance().printResidency();
+		JobSystem::instance().printStats();
+		FrameArena::printStats();
+		LevelArena::printStats();
+		AllocationCounter::printStats();
+	}
+
 	//Don't let debug buttons work unless in game
 	if (!GameStateSystem::instance().inGameState()) {
 		// Skip story
@@ -313,40 +273,14 @@ void WorldSystem::onKey(int key, int, int action, int mod)
 		}
 		return;
 	}
-	// Handles inputs for camera movement
-	assert(!ECS::registry<CameraComponent>.entities.empty());
-	auto camera = ECS::registry<CameraComponent>.entities[0];
-	auto& cameraComponent = camera.get<CameraComponent>();
-	if (action == GLFW_PRESS) {
-		if (key == GLFW_KEY_UP) {
-			cameraComponent.velocity.y = -cameraComponent.speed;
-		} else if (key == GLFW_KEY_DOWN) {
-			cameraComponent.velocity.y = cameraComponent.speed;
-		}
-		if (key == GLFW_KEY_LEFT) {
-			cameraComponent.velocity.x = -cameraComponent.speed;
-		} else if (key == GLFW_KEY_RIGHT) {
-			cameraComponent.velocity.x = cameraComponent.speed;
-		}
-	}
-	else if (action == GLFW_RELEASE) {
-		if (key == GLFW_KEY_LEFT && cameraComponent.velocity.x <= 0) {
-			cameraComponent.velocity.x = 0;
-		}
-		else if (key == GLFW_KEY_RIGHT && cameraComponent.velocity.x >= 0) {
-			cameraComponent.velocity.x = 0;
-		}
-		else if (key == GLFW_KEY_UP && cameraComponent.velocity.y <= 0) {
-			cameraComponent.velocity.y = 0;
-		}
-		else if (key == GLFW_KEY_DOWN && cameraComponent.velocity.y >= 0) {
-			cameraComponent.velocity.y = 0;
-		}
-	}
+
+	// Camera movement, help overlay and inspect mode, the keys that a headless replay also handles
+	CameraSystem::onKey(key, action);
+	TutorialSystem::onKey(key, action);
 
 	// Animation Test
 	if (action == GLFW_RELEASE && key == GLFW_KEY_4) {
-		for (auto entity : ECS::registry<Chicken>.entities)
+		for (auto entity : ECS::registry<Chicken>().entities)
 		{
 			auto& anim = entity.get<AnimationsComponent>();
 			anim.changeAnimation(AnimationType::ATTACK1);
@@ -357,7 +291,7 @@ void WorldSystem::onKey(int key, int, int action, int mod)
 	// whether buffs and debuffs are working properly and to see how much damage was applied in an attack
 	if (action == GLFW_RELEASE && key == GLFW_KEY_S)
 	{
-		for (auto& entity : ECS::registry<StatsComponent>.entities)
+		for (auto& entity : ECS::registry<StatsComponent>().entities)
 		{
 			auto& statsComponent = entity.get<StatsComponent>();
 
@@ -369,23 +303,6 @@ void WorldSystem::onKey(int key, int, int action, int mod)
 		}
 	}
 
-	if (key == GLFW_KEY_H && action == GLFW_RELEASE)
-	{
-		if (GameStateSystem::instance().isInHelpScreen)
-		{
-			EventSystem<HideHelpEvent>::instance().sendEvent(HideHelpEvent{});
-		}
-		else if (!GameStateSystem::instance().isInTutorial)
-		{
-			EventSystem<ShowHelpEvent>::instance().sendEvent(ShowHelpEvent{});
-		}
-	}
-
-	if (key == GLFW_KEY_I && action == GLFW_RELEASE)
-	{
-		TutorialSystem::toggleInspectMode();
-	}
-
 	// Debugging
 	if (key == GLFW_KEY_D)
 		DebugSystem::in_debug_mode = (action != GLFW_RELEASE);
@@ -400,6 +317,31 @@ void WorldSystem::onKey(int key, int, int action, int mod)
 		GameStateSystem::instance().loadSave();
 	}
 
+	// Quick save and load of the battle state
+	if (action == GLFW_RELEASE && key == GLFW_KEY_F5 && GameStateSystem::instance().inGameState()) {
+		quickSnapshot = GameStateSystem::instance().captureBattle();
+		std::cout << "Quick save: " << quickSnapshot.data.size() / 1024.f << " KB" << std::endl;
+	}
+	if (action == GLFW_RELEASE && key == GLFW_KEY_F9 && !quickSnapshot.data.empty() &&
+			GameStateSystem::instance().inGameState() && !GameStateSystem::instance().isTransitioning) {
+		try {
+			GameStateSystem::instance().restoreBattle(quickSnapshot);
+		}
+		catch (const std::exception& e) {
+			std::cout << "Quick load: " << e.what() << std::endl;
+		}
+	}
+
+	// Show or hide the performance overlay
+	if (action == GLFW_RELEASE && key == GLFW_KEY_F2) {
+		PerfOverlay::isVisible = !PerfOverlay::isVisible;
+	}
+
+	// Write the profiler's samples, for chrome://tracing or https://ui.perfetto.dev
+	if (action == GLFW_RELEASE && key == GLFW_KEY_F3) {
+		Profiler::instance().writeChromeTrace("profile.json");
+	}
+
 	// Play the next audio track (this is just so that we can give all of them a try)
 	if (action == GLFW_RELEASE && key == GLFW_KEY_A) {
 		playNextAudioTrack_DEBUG();
@@ -407,6 +349,8 @@ void WorldSystem::onKey(int key, int, int action, int mod)
 
 	// Go to main menu (for checking achievements after saving)
 	if (action == GLFW_RELEASE && key == GLFW_KEY_BACKSPACE) {
+		// Continuing resumes the battle left behind
+		GameStateSystem::instance().saveBattle();
 		GameStateSystem::instance().launchMainMenu();
 	}
 
@@ -416,16 +360,13 @@ void WorldSystem::onKey(int key, int, int action, int mod)
 	}
 }
 
-void WorldSystem::onMouseClick(int button, int action, int mods) const
+void WorldSystem::onMouseClick(int button, int action, int mods, vec2 mousePos) const
 {
 	if (action == GLFW_RELEASE && button == GLFW_MOUSE_BUTTON_LEFT)
 	{
-		double mousePosX, mousePosY;
-		glfwGetCursorPos(window, &mousePosX, &mousePosY);
+		std::cout << "Mouse click (release): {" << mousePos.x << ", " << mousePos.y << "}" << std::endl;
 
-		std::cout << "Mouse click (release): {" << mousePosX << ", " << mousePosY << "}" << std::endl;
-
-		//auto camera = ECS::registry<CameraComponent>.entities[0];
+		//auto camera = ECS::registry<CameraComponent>().entities[0];
 		//auto& cameraPos = camera.get<CameraComponent>().position;
 		// mouse click print without camera position
 		//std::cout << "Mouse click (release): {" << mousePosX + cameraPos.x << ", " << mousePosY + cameraPos.y << "}" << std::endl;
@@ -461,12 +402,32 @@ void WorldSystem::onMouseClick(int button, int action, int mods) const
 		}
 
 		RawMouseClickEvent event;
-		event.mousePos = {mousePosX, mousePosY};
+		event.mousePos = mousePos;
 		EventSystem<RawMouseClickEvent>::instance().sendEvent(event);
 		EventSystem<PlaySoundEffectEvent>::instance().sendEvent({SoundEffect::MOUSE_CLICK});
 	}
 }
 
+void WorldSystem::replayInput()
+{
+	InputEvent event;
+	while (InputReplay::instance().nextEvent(event))
+	{
+		switch (event.type)
+		{
+		case InputEvent::Type::KEY:
+			onKey(event.key, 0, event.action, event.mods);
+			break;
+		case InputEvent::Type::MOUSE_CLICK:
+			onMouseClick(event.key, event.action, event.mods, event.mousePos);
+			break;
+		case InputEvent::Type::MOUSE_HOVER:
+			onMouseHover(event.mousePos.x, event.mousePos.y);
+			break;
+		}
+	}
+}
+
 void WorldSystem::onMouseHover(double xpos, double ypos) const
 {
 	RawMouseHoverEvent event;
@@ -644,8 +605,8 @@ void WorldSystem::onPlayerChangeEvent(const PlayerChangeEvent& event)
 
 void WorldSystem::onTransition(TransitionEvent event)
 {
-	assert(!ECS::registry<ScreenState>.entities.empty());
-	auto& screenEntity = ECS::registry<ScreenState>.entities.front();
+	assert(!ECS::registry<ScreenState>().entities.empty());
+	auto& screenEntity = ECS::registry<ScreenState>().entities.front();
 	transition = event.callback;
 
 	if (!screenEntity.has<TimerComponent>())
@@ -4,6 +4,8 @@
 #include "../ext/nlohmann/json.hpp"
 #include "event_system.hpp"
 #include "events.hpp"
+#include "battle_system.hpp"
+#include "game_state_system.hpp"
 #include <functional>
 
 using json = nlohmann::json;
@@ -34,6 +36,9 @@ public:
 	// Check for collisions
 	void handleCollisions();
 
+	// Feeds the input of the current update step of the InputReplay to the input callbacks
+	void replayInput();
+
 	// Should the game be over ?
 	bool isOver() const;
 
@@ -42,7 +47,7 @@ public:
 private:
 	// Input callback functions
 	void onKey(int key, int, int action, int mod);
-	void onMouseClick(int button, int action, int mods) const;
+	void onMouseClick(int button, int action, int mods, vec2 mousePos) const;
 	void onMouseHover(double xpos, double ypos) const;
 
 	// Music and sound effects
@@ -75,6 +80,12 @@ private:
 	// A hack to prevent playing the TURN_START sound effect when the game first starts
 	bool shouldPlayAudioAtStartOfTurn;
 
+	// Death timers, victory and defeat, projectile collisions
+	BattleSystem battle;
+
+	// Battle state saved by the quick save debug key
+	GameStateSystem::BattleSnapshot quickSnapshot;
+
 	// C++ random number generator
 	std::default_random_engine rng;
 	std::uniform_real_distribution<float> uniform_dist; // number between 0..1
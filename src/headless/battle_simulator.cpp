@@ -0,0 +1,152 @@
+#include "battle_simulator.hpp"
+
+#include "level_loader/level_loader.hpp"
+#include "replay/input_replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <thread>
+
+namespace
+{
+	// Swallows the game's console output while the battles play
+	class NullBuffer : public std::streambuf
+	{
+	protected:
+		int overflow(int c) override { return traits_type::not_eof(c); }
+		std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+	};
+
+	class SilencedOutput
+	{
+	public:
+		explicit SilencedOutput(bool silence) : previous(silence ? std::cout.rdbuf(&nullBuffer) : nullptr) {}
+		~SilencedOutput()
+		{
+			if (previous)
+				std::cout.rdbuf(previous);
+		}
+
+	private:
+		NullBuffer nullBuffer;
+		std::streambuf* previous;
+	};
+}
+
+BattleSimulator::BattleSimulator(const Settings& settings)
+	: settings(settings)
+	, warmedUp(false)
+{
+	this->settings.numThreads = std::max(1u, settings.numThreads);
+	if (this->settings.recipeData.is_null())
+		this->settings.recipeData = LevelLoader().readLevel(settings.recipe);
+
+	const auto& maps = this->settings.recipeData["maps"];
+	if (settings.mapIndex < 0 || settings.mapIndex >= static_cast<int>(maps.size()))
+		throw std::runtime_error(settings.recipe + " has no map " + std::to_string(settings.mapIndex));
+}
+
+std::vector<BattleSimulator::GameResult> BattleSimulator::runBatch(const std::string& policy, int batch, int numGames)
+{
+	std::vector<Game> games;
+	for (int game = 0; game < numGames; game++)
+	{
+		games.push_back({ policy, batch, game, nullptr });
+	}
+	return run(games);
+}
+
+std::vector<BattleSimulator::GameResult> BattleSimulator::run(const std::vector<Game>& games)
+{
+	const int numGames = static_cast<int>(games.size());
+	std::vector<GameResult> results(games.size());
+	if (games.empty())
+		return results;
+
+	SilencedOutput silencedOutput(settings.silenceGameOutput);
+
+	// The meshes and the animations are shared by every world, and only loading them is thread safe,
+	// not building them. So the first battle plays alone and builds all of them.
+	int firstGame = 0;
+	if (!warmedUp)
+	{
+		results[0] = play(games[0]);
+		warmedUp = true;
+		firstGame = 1;
+	}
+
+	std::atomic<int> nextGame(firstGame);
+	std::mutex errorMutex;
+	std::exception_ptr error;
+	auto worker = [&]() {
+		for (int game = nextGame++; game < numGames; game = nextGame++)
+		{
+			try
+			{
+				results[game] = play(games[game]);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if (!error)
+					error = std::current_exception();
+				nextGame = numGames;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	const unsigned int numThreads = std::min<unsigned int>(settings.numThreads, numGames - firstGame);
+	for (unsigned int i = 1; i < numThreads; i++)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+	return results;
+}
+
+BattleSimulator::GameResult BattleSimulator::play(const Game& game) const
+{
+	ECS::World world;
+	ECS::World::Scope scope(world);
+
+	HeadlessBattle::Config config;
+	config.recipe = settings.recipe;
+	config.recipeData = game.recipeData ? *game.recipeData : settings.recipeData;
+	config.mapIndex = settings.mapIndex;
+	config.maxRounds = settings.maxRounds;
+	config.recordRounds = game.game < settings.numRecordedGames;
+	// A different seed for every game, that doesn't depend on which thread plays it. The policy and the
+	// mobs' skill choices derive their own from it, through the world's seed: the first numbers of
+	// engines seeded with consecutive seeds are alike, so the games would be too.
+	InputReplay::seedWorld(settings.seed + static_cast<unsigned int>(game.batch) * 1000003u +
+		static_cast<unsigned int>(game.game));
+	config.policy = PlayerPolicy::create(game.policy, InputReplay::instance().seedFor("player policy"));
+
+	HeadlessBattle battle(config);
+	battle.run(settings.maxSteps, true);
+
+	GameResult result;
+	result.policy = game.policy;
+	result.batch = game.batch;
+	result.game = game.game;
+	result.outcome = battle.outcome();
+	result.reachedRoundLimit = battle.reachedRoundLimit();
+	// The round that would have gone over the limit has started, but isn't played
+	result.rounds = result.reachedRoundLimit ? settings.maxRounds : battle.round() + 1;
+	result.steps = battle.steps();
+	result.trace = battle.rounds();
+	return result;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "headless_battle.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Plays batches of headless battles in parallel for balancing, the native replacement of
+// data/balancing/balancing.py. Every battle gets an ECS::World of its own and runs on one of the
+// simulator's threads from start to end.
+//
+// A game's seed is the seed of its world (see InputReplay::seedWorld), which its policy and the mobs'
+// skill choices derive theirs from, so a batch plays the same with the same seed.
+class BattleSimulator
+{
+public:
+	struct Settings
+	{
+		std::string recipe = "recipe-1";
+		// The recipe itself, read from data/levels/<recipe>.json if it's null
+		json recipeData;
+		int mapIndex = 1;
+		// Like balancing.py, a battle that isn't won within this many rounds is a defeat
+		int maxRounds = 15;
+		// In case a battle gets stuck
+		long long maxSteps = 100000;
+		unsigned int numThreads = 1;
+		unsigned int seed = 0;
+		// The first games of every batch keep a HeadlessBattle::RoundRecord of every round
+		int numRecordedGames = 1;
+		// Whether to drop what the game systems print to std::cout while the battles play
+		bool silenceGameOutput = true;
+	};
+
+	// One battle to play. `batch` and `game` pick its seed.
+	struct Game
+	{
+		std::string policy;
+		int batch;
+		int game;
+		// A variant of the recipe, or null for the one in the settings
+		std::shared_ptr<const json> recipeData;
+	};
+
+	struct GameResult
+	{
+		std::string policy;
+		int batch;
+		int game;
+		BattleSystem::Outcome outcome;
+		bool reachedRoundLimit;
+		int rounds;
+		long long steps;
+		// Empty unless it's one of the recorded games
+		std::vector<HeadlessBattle::RoundRecord> trace;
+	};
+
+	// Reads the recipe unless the settings already have it. Throws std::runtime_error if the recipe has no such map.
+	explicit BattleSimulator(const Settings& settings);
+
+	// Plays `numGames` battles with the given policy, and returns their results in game order.
+	// Throws the first exception thrown by any of the battles.
+	std::vector<GameResult> runBatch(const std::string& policy, int batch, int numGames);
+	// Plays the games, and returns their results in the same order
+	std::vector<GameResult> run(const std::vector<Game>& games);
+
+	inline const Settings& getSettings() const { return settings; }
+
+private:
+	GameResult play(const Game& game) const;
+
+	Settings settings;
+	bool warmedUp;
+};
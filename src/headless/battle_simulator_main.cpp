@@ -0,0 +1,169 @@
+// Entry point of ambrosia_simulate: plays batches of headless battles with each player policy and
+// reports their victory rates, like data/balancing/balancing.py did with its model of the game.
+// Usage: ambrosia_simulate [recipe] [map index] [policy|all] [games per batch] [batches] [threads] [output directory] [seed]
+// Defaults to the potato boss (recipe-1 map 1), all the policies, 5 batches of 1000 games and one thread per core.
+// The seed is taken from the clock if it isn't given, and a run with the seed of summary.json plays the same games.
+//
+// Writes to the output directory, which is created if it doesn't exist:
+//   games.csv     one line per game: policy, batch, game, result, rounds, steps
+//   rounds.csv    the HP of every entity at the start of every round, and the skill it used in that
+//                 round (0 for none), for the first game of every batch
+//   summary.json  the victory rate of every batch and on average, per policy
+
+#include "battle_simulator.hpp"
+#include "player_policy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+using Clock = std::chrono::high_resolution_clock;
+
+namespace
+{
+	const char* resultName(const BattleSimulator::GameResult& result)
+	{
+		switch (result.outcome)
+		{
+		case BattleSystem::Outcome::VICTORY: return "victory";
+		case BattleSystem::Outcome::DEFEAT: return result.reachedRoundLimit ? "round-limit" : "defeat";
+		default: return "unfinished";
+		}
+	}
+
+	std::ofstream openOutput(const std::string& path)
+	{
+		std::ofstream file(path);
+		if (!file)
+			throw std::runtime_error("can't write " + path);
+		return file;
+	}
+
+	// Before simulating anything, so that a bad path doesn't lose the results
+	void makeOutputDirectory(const std::string& path)
+	{
+#ifdef _WIN32
+		_mkdir(path.c_str());
+#else
+		mkdir(path.c_str(), 0755);
+#endif
+		struct stat info;
+		if (stat(path.c_str(), &info) != 0 || (info.st_mode & S_IFDIR) == 0)
+			throw std::runtime_error("can't create the output directory " + path);
+	}
+
+	int simulate(int argc, char* argv[])
+	{
+		BattleSimulator::Settings settings;
+		settings.recipe = argc > 1 ? argv[1] : "recipe-1";
+		settings.mapIndex = argc > 2 ? std::stoi(argv[2]) : 1;
+		const std::string policyArg = argc > 3 ? argv[3] : "all";
+		const int numGames = argc > 4 ? std::max(1, std::stoi(argv[4])) : 1000;
+		const int numBatches = argc > 5 ? std::max(1, std::stoi(argv[5])) : 5;
+		settings.numThreads = argc > 6 ? std::stoul(argv[6]) : std::max(1u, std::thread::hardware_concurrency());
+		const std::string outputDir = argc > 7 ? argv[7] : ".";
+		settings.seed = argc > 8 ? static_cast<unsigned int>(std::stoul(argv[8]))
+			: static_cast<unsigned int>(Clock::now().time_since_epoch().count());
+
+		const std::vector<std::string> policies = policyArg == "all" ? PlayerPolicy::names() : std::vector<std::string>{ policyArg };
+		for (const auto& policy : policies)
+			PlayerPolicy::create(policy, 0); // Fails early for an unknown name
+
+		makeOutputDirectory(outputDir);
+		std::ofstream gamesFile = openOutput(outputDir + "/games.csv");
+		std::ofstream roundsFile = openOutput(outputDir + "/rounds.csv");
+		std::ofstream summaryFile = openOutput(outputDir + "/summary.json");
+		gamesFile << "policy,batch,game,result,rounds,steps\n";
+		roundsFile << "policy,batch,game,round,entity,hp,skill\n";
+		json summary;
+		summary["recipe"] = settings.recipe;
+		summary["map"] = settings.mapIndex;
+		summary["gamesPerBatch"] = numGames;
+		summary["maxRounds"] = settings.maxRounds;
+		summary["seed"] = settings.seed;
+
+		std::cout << "Simulating " << settings.recipe << " map " << settings.mapIndex << ": " << numBatches << " batches of "
+			<< numGames << " games per policy, on " << settings.numThreads << " threads" << std::endl;
+
+		BattleSimulator simulator(settings);
+		for (const auto& policy : policies)
+		{
+			json policySummary;
+			std::vector<double> victoryRates;
+			long long totalSteps = 0;
+			const auto start = Clock::now();
+
+			for (int batch = 0; batch < numBatches; batch++)
+			{
+				const auto results = simulator.runBatch(policy, batch, numGames);
+
+				int victories = 0;
+				json victoryRounds = json::array();
+				for (const auto& result : results)
+				{
+					gamesFile << policy << "," << batch << "," << result.game << "," << resultName(result) << ","
+						<< result.rounds << "," << result.steps << "\n";
+					for (const auto& round : result.trace)
+					{
+						for (const auto& entity : round.entities)
+						{
+							const int skill = entity.skill == SkillType::NONE ? 0 : static_cast<int>(entity.skill) + 1;
+							roundsFile << policy << "," << batch << "," << result.game << "," << round.round << ","
+								<< entity.name << "," << entity.hp << "," << skill << "\n";
+						}
+					}
+
+					totalSteps += result.steps;
+					if (result.outcome == BattleSystem::Outcome::VICTORY)
+					{
+						victories++;
+						victoryRounds.push_back(result.rounds);
+					}
+				}
+
+				victoryRates.push_back(100.0 * victories / numGames);
+				policySummary["batches"].push_back({ { "victoryRate", victoryRates.back() }, { "victoryRounds", victoryRounds } });
+			}
+
+			const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+			double average = 0.0;
+			for (double rate : victoryRates)
+				average += rate / victoryRates.size();
+
+			std::cout << policy << ":" << std::endl << "  " << numBatches << "-batch Victory Rates:";
+			for (size_t i = 0; i < victoryRates.size(); i++)
+				std::cout << (i == 0 ? " " : ", ") << victoryRates[i] << "%";
+			std::cout << std::endl << "  Average Victory Rate: " << average << "%" << std::endl;
+			std::cout << "  " << numGames * numBatches / seconds << " games/s, " << totalSteps / seconds << " steps/s" << std::endl;
+
+			policySummary["averageVictoryRate"] = average;
+			policySummary["gamesPerSecond"] = numGames * numBatches / seconds;
+			summary["policies"][policy] = policySummary;
+		}
+
+		summaryFile << summary.dump(4) << std::endl;
+		return EXIT_SUCCESS;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		return simulate(argc, argv);
+	}
+	catch (const std::exception& error)
+	{
+		std::cerr << "ambrosia_simulate: " << error.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
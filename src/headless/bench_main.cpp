@@ -0,0 +1,263 @@
+// Entry point of ambrosia_bench: plays the benchmark scenarios headless (see Benchmark) and compares
+// their metrics with a baseline, to catch performance regressions before they ship.
+// Usage: ambrosia_bench [--scenarios <file>] [--baseline <file>] [--only <scenario>]... [--output <file>]
+//                       [--runs <count>] [--tolerance <metric>=<fraction>]... [--write-baseline]
+// Run from the repository root so that --write-baseline updates the checked-in baseline,
+// data/benchmarks/baseline.json.
+// Every scenario is played once to build its meshes and animations, then --runs times (5 by default),
+// and the best of the runs is compared. A metric regresses when it's worse than the baseline by more
+// than its tolerance, e.g. 0.1 lets ticksPerSecond drop by 10%. A full run with --write-baseline plays
+// the runs of every scenario three times and derives the tolerances from how much their best varies:
+// one and a half times its widest range over a scenario, and at least 5%. --tolerance overrides a
+// tolerance for the run, and the derived one.
+// The timings depend on the machine and the build type, so the baseline should come from a Release build
+// on the machine that compares against it, and a build of another type refuses to compare with it. The
+// peak resident set is the whole run's, so it's only compared for full runs, without --only.
+// Exits with 0 if nothing regressed, 1 if a metric did and 2 if a scenario couldn't be played or the
+// baseline is of another build type. Scenarios that couldn't be played are reported as errors, and
+// aren't written to the baseline.
+
+// The particle emitters link against the GL functions, which stay unloaded: only their simulation runs
+#define GL3W_IMPLEMENTATION
+#include <gl3w.h>
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef AMBROSIA_BUILD_TYPE
+#define AMBROSIA_BUILD_TYPE ""
+#endif
+
+namespace
+{
+	// CMake's build type, empty for a build without one
+	const std::string BUILD_TYPE = std::string(AMBROSIA_BUILD_TYPE).empty() ? "none" : AMBROSIA_BUILD_TYPE;
+
+	// A new baseline plays the runs of every scenario this many times, and its tolerances are the spread
+	// between them times the margin
+	const int BASELINE_SAMPLES = 3;
+	const double SPREAD_MARGIN = 1.5;
+	const double MIN_TOLERANCE = 0.05;
+
+	json readJson(const std::string& path)
+	{
+		std::ifstream file(path);
+		if (!file)
+			throw std::runtime_error("can't read " + path);
+		json result;
+		file >> result;
+		return result;
+	}
+
+	void writeJson(const std::string& path, const json& content)
+	{
+		std::ofstream file(path);
+		if (!file)
+			throw std::runtime_error("can't write " + path);
+		file << content.dump(2) << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string scenariosPath = "data/benchmarks/scenarios.json";
+	std::string baselinePath = "data/benchmarks/baseline.json";
+	std::string outputPath;
+	std::vector<std::string> only;
+	json toleranceOverrides = json::object();
+	int numRuns = 5;
+	bool writeBaseline = false;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--scenarios" && hasValue)
+			scenariosPath = argv[++i];
+		else if (arg == "--baseline" && hasValue)
+			baselinePath = argv[++i];
+		else if (arg == "--output" && hasValue)
+			outputPath = argv[++i];
+		else if (arg == "--only" && hasValue)
+			only.push_back(argv[++i]);
+		else if (arg == "--runs" && hasValue)
+		{
+			numRuns = std::atoi(argv[++i]);
+			if (numRuns < 1)
+			{
+				std::cerr << "ambrosia_bench: expected a positive number of runs, got " << argv[i] << std::endl;
+				return 2;
+			}
+		}
+		else if (arg == "--tolerance" && hasValue)
+		{
+			const std::string tolerance = argv[++i];
+			const size_t equals = tolerance.find('=');
+			if (equals == std::string::npos)
+			{
+				std::cerr << "ambrosia_bench: expected <metric>=<fraction>, got " << tolerance << std::endl;
+				return 2;
+			}
+			toleranceOverrides[tolerance.substr(0, equals)] = std::stod(tolerance.substr(equals + 1));
+		}
+		else if (arg == "--write-baseline")
+			writeBaseline = true;
+		else
+		{
+			std::cerr << "ambrosia_bench: unknown argument " << arg << std::endl;
+			return 2;
+		}
+	}
+
+	const auto scenarios = Benchmark::loadScenarios(scenariosPath);
+	// A new baseline starts with these
+	json baseline = {
+		{ "buildType", BUILD_TYPE },
+		{ "tolerances", { { "ticksPerSecond", 0.15 }, { "p50FrameMs", 0.2 }, { "p99FrameMs", 0.5 },
+			{ "allocationsPerFrame", 0.1 }, { "peakRssMb", 0.15 } } },
+		{ "scenarios", json::object() }
+	};
+	if (std::ifstream(baselinePath))
+		baseline = readJson(baselinePath);
+	else
+		std::cout << "No baseline at " << baselinePath << ", nothing to compare with" << std::endl;
+
+	const std::string baselineBuildType = baseline.value("buildType", "unknown");
+	if (baselineBuildType != BUILD_TYPE)
+	{
+		if (!writeBaseline)
+		{
+			std::cerr << "ambrosia_bench: the baseline comes from a " << baselineBuildType << " build and this is a "
+				<< BUILD_TYPE << " build, their timings can't be compared" << std::endl;
+			return 2;
+		}
+		// Nothing of the old baseline still holds
+		std::cout << "Replacing the " << baselineBuildType << " baseline with a " << BUILD_TYPE << " one" << std::endl;
+		baseline["buildType"] = BUILD_TYPE;
+		baseline["scenarios"] = json::object();
+		baseline.erase("peakRssMb");
+	}
+
+	json tolerances = baseline.value("tolerances", json::object());
+	for (const auto& tolerance : toleranceOverrides.items())
+	{
+		tolerances[tolerance.key()] = tolerance.value();
+	}
+
+	json results = json::object();
+	json errors = json::object();
+	// The widest relative range of every metric between the samples of a scenario
+	json spreads = json::object();
+	std::vector<Benchmark::Regression> regressions;
+	std::cout << std::fixed << std::setprecision(2);
+	for (const auto& scenario : scenarios)
+	{
+		if (!only.empty() && std::find(only.begin(), only.end(), scenario.name) == only.end())
+			continue;
+
+		// A new baseline measures how much the best of the runs varies, from one sample of runs to the next
+		const int numSamples = writeBaseline ? BASELINE_SAMPLES : 1;
+		Benchmark::Metrics metrics;
+		json spread;
+		try
+		{
+			// The first run builds the meshes and animations that no other scenario built before
+			Benchmark::run(scenario);
+			std::vector<Benchmark::Metrics> samples;
+			for (int sample = 0; sample < numSamples; sample++)
+			{
+				std::vector<Benchmark::Metrics> runs;
+				for (int run = 0; run < numRuns; run++)
+				{
+					runs.push_back(Benchmark::run(scenario));
+				}
+				samples.push_back(Benchmark::best(runs));
+			}
+			metrics = Benchmark::best(samples);
+			spread = Benchmark::relativeSpread(samples);
+		}
+		catch (const std::exception& error)
+		{
+			std::cout << scenario.name << ": error, " << error.what() << std::endl;
+			errors[scenario.name] = error.what();
+			continue;
+		}
+
+		std::cout << scenario.name << ": " << metrics.steps << " steps, " << metrics.ticksPerSecond << " ticks/s, p50 "
+			<< metrics.p50FrameMs << " ms, p99 " << metrics.p99FrameMs << " ms, " << metrics.allocationsPerFrame
+			<< " allocations/frame (best of " << numRuns * numSamples << " runs)" << std::endl;
+		results[scenario.name] = Benchmark::toJson(metrics);
+		for (const auto& metric : spread.items())
+		{
+			spreads[metric.key()] = std::max(spreads.value(metric.key(), 0.0), metric.value().get<double>());
+		}
+
+		const auto scenarioRegressions = Benchmark::compare(scenario.name, metrics, baseline.at("scenarios"), tolerances);
+		regressions.insert(regressions.end(), scenarioRegressions.begin(), scenarioRegressions.end());
+	}
+
+	// Only a full run has the peak of every scenario in it
+	const bool fullRun = only.empty() && errors.empty();
+	const double peakRssMb = Benchmark::peakRssMb();
+	std::cout << "Peak RSS of the run: " << peakRssMb << " MB" << std::endl;
+	if (fullRun && baseline.contains("peakRssMb") && tolerances.contains("peakRssMb"))
+	{
+		const double baselineValue = baseline.at("peakRssMb").get<double>();
+		const double tolerance = tolerances.at("peakRssMb").get<double>();
+		if (peakRssMb > baselineValue * (1.0 + tolerance))
+			regressions.push_back({ "run", "peakRssMb", baselineValue, peakRssMb, tolerance });
+	}
+
+	for (const auto& regression : regressions)
+	{
+		std::cout << "Regression: " << regression.scenario << " " << regression.metric << " " << regression.value
+			<< ", baseline " << regression.baseline << " (tolerance " << regression.tolerance * 100.0 << "%)" << std::endl;
+	}
+	if (regressions.empty())
+		std::cout << "No regressions" << std::endl;
+	for (const auto& error : errors.items())
+	{
+		std::cout << "Error: " << error.key() << " couldn't be played, " << error.value().get<std::string>() << std::endl;
+	}
+
+	if (!outputPath.empty())
+	{
+		json output = { { "buildType", BUILD_TYPE }, { "scenarios", results }, { "errors", errors } };
+		if (fullRun)
+			output["peakRssMb"] = peakRssMb;
+		writeJson(outputPath, output);
+	}
+	if (writeBaseline)
+	{
+		// Scenarios that weren't played, or couldn't be, keep their values
+		for (const auto& result : results.items())
+		{
+			baseline["scenarios"][result.key()] = result.value();
+		}
+		if (fullRun)
+			baseline["peakRssMb"] = peakRssMb;
+		// The spread of a few scenarios would understate the others'. The peak resident set is measured
+		// once per invocation, so its tolerance is kept.
+		for (const auto& spread : spreads.items())
+		{
+			if (!fullRun)
+				break;
+			const double derived = std::ceil(SPREAD_MARGIN * spread.value().get<double>() * 100.0) / 100.0;
+			baseline["tolerances"][spread.key()] = toleranceOverrides.value(spread.key(), std::max(MIN_TOLERANCE, derived));
+		}
+		writeJson(baselinePath, baseline);
+		std::cout << "Wrote the baseline " << baselinePath << std::endl;
+	}
+
+	if (!errors.empty())
+		return 2;
+	return regressions.empty() ? 0 : 1;
+}
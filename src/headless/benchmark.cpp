@@ -0,0 +1,315 @@
+#include "benchmark.hpp"
+#include "headless_battle.hpp"
+
+#include "animation/animation_loader.hpp"
+#include "entities/enemies.hpp"
+#include "memory/allocation_counter.hpp"
+#include "particles/particle_system.hpp"
+#include "replay/input_replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#if !defined(__linux__) && !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+using Clock = std::chrono::high_resolution_clock;
+
+namespace
+{
+	struct MetricInfo
+	{
+		const char* name;
+		double Benchmark::Metrics::* value;
+		bool higherIsBetter;
+	};
+
+	const MetricInfo METRICS[] = {
+		{ "ticksPerSecond", &Benchmark::Metrics::ticksPerSecond, true },
+		{ "p50FrameMs", &Benchmark::Metrics::p50FrameMs, false },
+		{ "p99FrameMs", &Benchmark::Metrics::p99FrameMs, false },
+		{ "allocationsPerFrame", &Benchmark::Metrics::allocationsPerFrame, false },
+	};
+
+	// The nearest rank
+	double percentile(std::vector<double>& sortedValues, double fraction)
+	{
+		if (sortedValues.empty())
+			return 0.0;
+		const size_t rank = static_cast<size_t>(std::ceil(fraction * sortedValues.size()));
+		return sortedValues[std::min(sortedValues.size(), std::max<size_t>(rank, 1)) - 1];
+	}
+
+	void spawnPotatoChunks(int numChunks)
+	{
+		const auto& potatoes = ECS::registry<Potato>().entities;
+		if (potatoes.empty())
+			throw std::runtime_error("there's no potato to spawn potato chunks around");
+
+		SwarmBehaviour swarm;
+		for (int i = 0; i < numChunks; i += 5)
+		{
+			swarm.spawnExplodedChunks(potatoes.front());
+		}
+	}
+
+	// Tops the projectiles up to `numProjectiles`, launched by the mobs in turn at the players in turn
+	void launchProjectiles(int numProjectiles, long long step)
+	{
+		static const ProjectileType types[] = {
+			ProjectileType::BLUEBERRY, ProjectileType::BONE, ProjectileType::EGG_SHELL,
+			ProjectileType::PEPPER, ProjectileType::SALT, ProjectileType::DRUMSTICK
+		};
+		const auto& mobs = ECS::registry<AISystem::MobComponent>().entities;
+		const auto& players = ECS::registry<PlayerComponent>().entities;
+		if (mobs.empty() || players.empty())
+			return;
+
+		int missing = numProjectiles - static_cast<int>(ECS::registry<ProjectileComponent>().size());
+		for (int i = 0; i < missing; i++)
+		{
+			const size_t n = static_cast<size_t>(step) + i;
+			auto instigator = mobs[n % mobs.size()];
+			auto target = players[n % players.size()];
+			if (!instigator.has<Motion>() || !target.has<Motion>())
+				continue;
+
+			LaunchEvent event;
+			event.skillParams.instigator = instigator;
+			event.skillParams.projectileType = types[n % (sizeof(types) / sizeof(types[0]))];
+			event.skillParams.targetPosition = target.get<Motion>().position;
+			EventSystem<LaunchEvent>::instance().sendEvent(event);
+		}
+	}
+
+	// Only their CPU side is simulated, without the ParticleSystem, which would build the GL resources of
+	// the emitters that the maps add
+	std::vector<std::shared_ptr<ParticleEmitter>> createEmitters(int numParticles)
+	{
+		const int particlesPerSecond = 100;
+		std::vector<std::shared_ptr<ParticleEmitter>> emitters;
+		for (int i = 0; i * ParticleSystem::MaxParticles < numParticles; i++)
+		{
+			switch (i % 4)
+			{
+			case 0: emitters.push_back(std::make_shared<RainEmitter>(particlesPerSecond)); break;
+			case 1: emitters.push_back(std::make_shared<SparkleEmitter>(particlesPerSecond)); break;
+			case 2: emitters.push_back(std::make_shared<BasicEmitter>(particlesPerSecond)); break;
+			default: emitters.push_back(std::make_shared<BlueCottonCandyEmitter>(particlesPerSecond)); break;
+			}
+		}
+		return emitters;
+	}
+}
+
+std::vector<Benchmark::Scenario> Benchmark::loadScenarios(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file)
+		throw std::runtime_error("can't read the scenarios " + path);
+	json entries;
+	file >> entries;
+
+	std::vector<Scenario> scenarios;
+	for (const auto& entry : entries)
+	{
+		Scenario scenario;
+		scenario.name = entry.at("name").get<std::string>();
+		scenario.recipe = entry.value("recipe", scenario.recipe);
+		scenario.mapIndex = entry.value("map", scenario.mapIndex);
+		scenario.policy = entry.value("policy", scenario.policy);
+		scenario.replay = entry.value("replay", scenario.replay);
+		scenario.seed = entry.value("seed", scenario.seed);
+		scenario.warmupSteps = entry.value("warmupSteps", scenario.warmupSteps);
+		scenario.steps = entry.value("steps", scenario.steps);
+		scenario.potatoChunks = entry.value("potatoChunks", scenario.potatoChunks);
+		scenario.projectiles = entry.value("projectiles", scenario.projectiles);
+		scenario.particles = entry.value("particles", scenario.particles);
+		scenarios.push_back(scenario);
+	}
+	return scenarios;
+}
+
+Benchmark::Metrics Benchmark::run(const Scenario& scenario)
+{
+	// Without a buffer, std::cout drops everything until the buffer is put back
+	struct SilencedOutput
+	{
+		std::streambuf* previous = std::cout.rdbuf(nullptr);
+		~SilencedOutput() { std::cout.rdbuf(previous); }
+	} silencedOutput;
+
+	// A clip that's first played during the measured steps would otherwise be decoded by a worker
+	// competing with the battle for the cores, and be waited for when it's played
+	AnimationLoader::instance().setSynchronous(true);
+
+	ECS::World world;
+	ECS::World::Scope scope(world);
+
+	auto& replay = InputReplay::instance();
+	HeadlessBattle::Config config;
+	if (!scenario.replay.empty())
+	{
+		replay.startReplay(scenario.replay);
+		config.recipe = replay.getRecipe();
+		config.mapIndex = replay.getMapIndex();
+		config.replayInput = true;
+	}
+	else
+	{
+		replay.startSeeded(scenario.seed);
+		config.recipe = scenario.recipe;
+		config.mapIndex = scenario.mapIndex;
+		config.policy = PlayerPolicy::create(scenario.policy, scenario.seed);
+	}
+
+	HeadlessBattle battle(config);
+	if (scenario.potatoChunks > 0)
+		spawnPotatoChunks(scenario.potatoChunks);
+	auto emitters = createEmitters(scenario.particles);
+
+	std::vector<double> frameMs;
+	frameMs.reserve(static_cast<size_t>(scenario.steps));
+	size_t allocations = 0;
+	double seconds = 0.0;
+	for (long long step = 0; step < scenario.warmupSteps + scenario.steps; step++)
+	{
+		if (battle.outcome() != BattleSystem::Outcome::ONGOING || replay.isFinished())
+			break;
+
+		const size_t allocationsBefore = AllocationCounter::numThreadAllocations();
+		const auto start = Clock::now();
+
+		if (scenario.projectiles > 0)
+			launchProjectiles(scenario.projectiles, step);
+		battle.step(true);
+		for (auto& emitter : emitters)
+		{
+			emitter->step(HeadlessBattle::STEP_MS);
+		}
+
+		const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		if (step >= scenario.warmupSteps)
+		{
+			frameMs.push_back(ms);
+			seconds += ms / 1000.0;
+			allocations += AllocationCounter::numThreadAllocations() - allocationsBefore;
+		}
+	}
+
+	Metrics metrics;
+	metrics.steps = static_cast<long long>(frameMs.size());
+	if (metrics.steps == 0)
+		throw std::runtime_error("the battle ended during the warm-up");
+	std::sort(frameMs.begin(), frameMs.end());
+	metrics.ticksPerSecond = metrics.steps / seconds;
+	metrics.p50FrameMs = percentile(frameMs, 0.5);
+	metrics.p99FrameMs = percentile(frameMs, 0.99);
+	metrics.allocationsPerFrame = static_cast<double>(allocations) / metrics.steps;
+	return metrics;
+}
+
+Benchmark::Metrics Benchmark::best(const std::vector<Metrics>& runs)
+{
+	if (runs.empty())
+		throw std::runtime_error("no runs to take the best of");
+
+	Metrics result = runs.front();
+	for (const auto& run : runs)
+	{
+		for (const auto& metric : METRICS)
+		{
+			const double value = run.*metric.value;
+			if (metric.higherIsBetter ? value > result.*metric.value : value < result.*metric.value)
+				result.*metric.value = value;
+		}
+	}
+	return result;
+}
+
+json Benchmark::relativeSpread(const std::vector<Metrics>& samples)
+{
+	json result = json::object();
+	for (const auto& metric : METRICS)
+	{
+		const auto range = std::minmax_element(samples.begin(), samples.end(), [&metric](const Metrics& a, const Metrics& b) {
+			return a.*metric.value < b.*metric.value;
+		});
+		const double low = (*range.first).*metric.value;
+		const double high = (*range.second).*metric.value;
+		// Relative to the better end, as compare() is: a baseline at one end doesn't regress at the other
+		const double better = metric.higherIsBetter ? high : low;
+		result[metric.name] = better > 0.0 ? (high - low) / better : 0.0;
+	}
+	return result;
+}
+
+double Benchmark::peakRssMb()
+{
+#if defined(__linux__)
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line))
+	{
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::stod(line.substr(6)) / 1024.0;
+	}
+	return 0.0;
+#elif !defined(_WIN32)
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	// Bytes on macOS
+	return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+	return 0.0;
+#endif
+}
+
+std::vector<std::string> Benchmark::metricNames()
+{
+	std::vector<std::string> names;
+	for (const auto& metric : METRICS)
+	{
+		names.push_back(metric.name);
+	}
+	return names;
+}
+
+json Benchmark::toJson(const Metrics& metrics)
+{
+	json result = { { "steps", metrics.steps } };
+	for (const auto& metric : METRICS)
+	{
+		result[metric.name] = metrics.*metric.value;
+	}
+	return result;
+}
+
+std::vector<Benchmark::Regression> Benchmark::compare(const std::string& scenario, const Metrics& metrics,
+	const json& baseline, const json& tolerances)
+{
+	std::vector<Regression> regressions;
+	if (!baseline.contains(scenario))
+		return regressions;
+
+	const auto& expected = baseline.at(scenario);
+	for (const auto& metric : METRICS)
+	{
+		if (!expected.contains(metric.name) || !tolerances.contains(metric.name))
+			continue;
+
+		const double baselineValue = expected.at(metric.name).get<double>();
+		const double value = metrics.*metric.value;
+		const double tolerance = tolerances.at(metric.name).get<double>();
+		const bool regressed = metric.higherIsBetter ? value < baselineValue * (1.0 - tolerance)
+			: value > baselineValue * (1.0 + tolerance);
+		if (regressed)
+			regressions.push_back({ scenario, metric.name, baselineValue, value, tolerance });
+	}
+	return regressions;
+}
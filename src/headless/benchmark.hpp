@@ -0,0 +1,87 @@
+#pragma once
+
+#include "game/common.hpp"
+
+#include <string>
+#include <vector>
+
+// The scenarios of ambrosia_bench: headless battles played for a fixed number of steps, optionally
+// with extra load on top (a potato chunk swarm, projectiles in flight, particles), or the input of a
+// recorded session (see InputReplay). Every scenario plays in an ECS::World of its own, with the seeds
+// fixed by a seeded InputReplay session, so that two runs of the same build play the same battle. The
+// battle runs its systems on the calling thread rather than on the JobSystem, so that it's also the only
+// thread whose allocations are counted, and the animation clips it prefetches are loaded right away on
+// that thread rather than decoded by JobSystem workers in the middle of the measured steps.
+//
+// Scenarios are read from data/benchmarks/scenarios.json, baselines from data/benchmarks/baseline.json:
+//   { "buildType": <CMake build type>, "tolerances": { <metric>: <fraction> }, "peakRssMb": <value>,
+//     "scenarios": { <scenario>: { <metric>: <value> } } }
+// where the values are the best of several runs of the scenario (see best()).
+// The peak resident set is the whole run's, since the scenarios share the caches of the meshes and animations.
+class Benchmark
+{
+public:
+	struct Scenario
+	{
+		std::string name;
+		std::string recipe = "recipe-1";
+		int mapIndex = 0;
+		std::string policy = "super-strategic";
+		// A session recorded with `ambrosia --record`, whose recipe and map are played instead, or empty
+		std::string replay;
+		unsigned int seed = 1;
+		// Steps played before the measured ones, while the resources get built
+		long long warmupSteps = 120;
+		// Measured steps, fewer if the battle ends before
+		long long steps = 1500;
+		// Potato chunks spawned around the potato at the start, in swarms of five as the boss spawns them
+		int potatoChunks = 0;
+		// Projectiles kept in flight from the mobs to the players
+		int projectiles = 0;
+		// Particles kept alive, in emitters of ParticleSystem::MaxParticles
+		int particles = 0;
+	};
+
+	struct Metrics
+	{
+		long long steps = 0;
+		double ticksPerSecond = 0.0;
+		double p50FrameMs = 0.0;
+		double p99FrameMs = 0.0;
+		// Heap allocations per step by the thread that played the battle, which barely vary between runs
+		double allocationsPerFrame = 0.0;
+	};
+
+	// A metric that got worse than the baseline by more than its tolerance
+	struct Regression
+	{
+		std::string scenario;
+		std::string metric;
+		double baseline;
+		double value;
+		double tolerance;
+	};
+
+	// Throws std::runtime_error if the file can't be read
+	static std::vector<Scenario> loadScenarios(const std::string& path);
+
+	// Plays the scenario with the game's output silenced. Throws std::runtime_error if it can't be set up.
+	static Metrics run(const Scenario& scenario);
+
+	// The best value of every metric over the runs of a scenario, which aren't empty. The noise of a busy
+	// machine only ever makes a run slower, so the best run is the steadiest between invocations.
+	static Metrics best(const std::vector<Metrics>& runs);
+	// The range of every metric over measurements of the same scenario, relative to its better end
+	static json relativeSpread(const std::vector<Metrics>& samples);
+
+	// The peak resident set of the process so far, 0 where it isn't measured
+	static double peakRssMb();
+
+	// The names of the metrics compared with the baseline
+	static std::vector<std::string> metricNames();
+	static json toJson(const Metrics& metrics);
+	// The regressions of `metrics` against the scenario's entry of the baseline, none if it has no entry.
+	// Metrics without a tolerance aren't compared.
+	static std::vector<Regression> compare(const std::string& scenario, const Metrics& metrics, const json& baseline,
+		const json& tolerances);
+};
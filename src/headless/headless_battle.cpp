@@ -0,0 +1,262 @@
+#include "headless_battle.hpp"
+
+#include "game/camera.hpp"
+#include "game/game_state_system.hpp"
+#include "game/achievement_system.hpp"
+#include "game/stats_component.hpp"
+#include "entities/command_buffer.hpp"
+#include "entities/enemies.hpp"
+#include "jobs/job_system.hpp"
+#include "memory/frame_arena.hpp"
+#include "level_loader/level_loader.hpp"
+#include "profiling/profiler.hpp"
+#include "rendering/render_components.hpp"
+#include "replay/input_replay.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	// The headless build pretends to have the game's window, since the UI layout and the camera depend on it
+	const ivec2 window_size_in_px = { 1366, 900 };
+	const vec2 window_size_in_game_units = { 1366, 900 };
+
+	HeadlessBattle::Config validated(HeadlessBattle::Config config)
+	{
+		if (config.recipeData.is_null())
+			config.recipeData = LevelLoader().readLevel(config.recipe);
+		const auto& maps = config.recipeData["maps"];
+		if (config.mapIndex < 0 || config.mapIndex >= static_cast<int>(maps.size()))
+			throw std::runtime_error(config.recipe + " has no map " + std::to_string(config.mapIndex));
+		if (config.replayInput)
+		{
+			const auto& replay = InputReplay::instance();
+			if (!replay.isReplaying() || replay.getRecipe() != config.recipe || replay.getMapIndex() != config.mapIndex)
+				throw std::runtime_error("the replayed session isn't a battle of " + config.recipe + " map " + std::to_string(config.mapIndex));
+		}
+		else if (!config.policy)
+		{
+			throw std::runtime_error("a headless battle needs a player policy");
+		}
+		if (config.recordInput)
+		{
+			const auto& replay = InputReplay::instance();
+			if (!replay.isRecording() || replay.getRecipe() != config.recipe || replay.getMapIndex() != config.mapIndex)
+				throw std::runtime_error("the recorded session isn't a battle of " + config.recipe + " map " + std::to_string(config.mapIndex));
+		}
+		return config;
+	}
+}
+
+constexpr float HeadlessBattle::STEP_MS;
+
+HeadlessBattle::HeadlessBattle(const Config& config)
+	: config(validated(config))
+	, camera(window_size_in_px)
+	, physics(pathFindingSystem)
+	, ai(pathFindingSystem)
+	, turnSystem(pathFindingSystem)
+	, autopilot(config.policy, config.recordInput)
+	, currentOutcome(BattleSystem::Outcome::ONGOING)
+	, currentRound(0)
+	, numSteps(0)
+{
+	startNextRoundListener = EventSystem<StartNextRoundEvent>::instance().registerListener(
+			std::bind(&HeadlessBattle::onStartNextRound, this, std::placeholders::_1));
+	setActiveSkillListener = EventSystem<SetActiveSkillEvent>::instance().registerListener(
+			std::bind(&HeadlessBattle::onSetActiveSkill, this, std::placeholders::_1));
+
+	AchievementSystem::instance();
+
+	auto& gameState = GameStateSystem::instance();
+	gameState.isSavingEnabled = false;
+	gameState.setFrameBufferSize(window_size_in_px);
+	gameState.loadRecipeData(this->config.recipeData, "", config.mapIndex);
+
+	const float dt = STEP_MS;
+
+	// Same order as in the game, see main.cpp
+	scheduler.add("battle", [this, dt]() { battle.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("camera", [this, dt]() { camera.step(dt); },
+		SystemAccess().writes<CameraComponent, CameraDelayedMoveComponent>().structural());
+	scheduler.add("physics", [this, dt]() { physics.step(dt, window_size_in_game_units); }, SystemAccess().exclusive());
+	scheduler.add("swarm", [this, dt]() { swarmBehaviour.step(dt, window_size_in_game_units); },
+		SystemAccess().reads<ActivePotatoChunks, Motion>().writes<StatsComponent, DeathTimer>().structural());
+	scheduler.add("collisions", [this]() { battle.handleCollisions(); }, SystemAccess().exclusive());
+	scheduler.add("projectiles", [this, dt]() { projectileSystem.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("skills", [this, dt]() { skillSystem.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("animations", [this]() { animations.step(); },
+		SystemAccess().reads<SkillComponent>().writes<AnimationsComponent, Motion>().mainThread());
+	scheduler.add("effects", [this]() { effectSystem.step(); },
+		SystemAccess().reads<SkillFXData, AnimationsComponent>().writes<Motion>().structural());
+	scheduler.add("ui", [this, dt]() { ui.step(dt); }, SystemAccess().exclusive());
+	// A recording autopilot clicks before the systems run, where the replay's clicks come in
+	if (!config.replayInput && !config.recordInput)
+		scheduler.add("autopilot", [this]() { autopilot.step(currentRound); }, SystemAccess().exclusive());
+	scheduler.add("turns", [this, dt]() { turnSystem.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("state", [this, dt]() { stateSystem.step(dt); }, SystemAccess().exclusive());
+
+	if (config.recordRounds)
+		recordRound();
+}
+
+HeadlessBattle::~HeadlessBattle()
+{
+	if (startNextRoundListener.isValid())
+	{
+		EventSystem<StartNextRoundEvent>::instance().unregisterListener(startNextRoundListener);
+	}
+	if (setActiveSkillListener.isValid())
+	{
+		EventSystem<SetActiveSkillEvent>::instance().unregisterListener(setActiveSkillListener);
+	}
+}
+
+BattleSystem::Outcome HeadlessBattle::step(bool onOwnThread)
+{
+	if (config.replayInput)
+		replayInput();
+	if (config.recordInput)
+		autopilot.step(currentRound);
+
+	if (onOwnThread)
+		scheduler.runSerially();
+	else
+		scheduler.run();
+
+	{
+		PROFILE_SCOPE("dispatch events");
+		EventQueues::dispatchAll();
+	}
+	{
+		PROFILE_SCOPE("command buffer");
+		ECS::CommandBuffer::instance().playback();
+	}
+	// Main thread jobs don't know which world they belong to
+	if (!onOwnThread)
+		JobSystem::instance().runMainThreadJobs();
+
+	FrameArena::endFrame();
+	numSteps++;
+	if (config.replayInput || config.recordInput)
+		InputReplay::instance().endStep();
+
+	currentOutcome = BattleSystem::outcome();
+	if (currentOutcome == BattleSystem::Outcome::ONGOING && reachedRoundLimit())
+		currentOutcome = BattleSystem::Outcome::DEFEAT;
+	return currentOutcome;
+}
+
+BattleSystem::Outcome HeadlessBattle::run(long long maxSteps, bool onOwnThread)
+{
+	while (numSteps < maxSteps && currentOutcome == BattleSystem::Outcome::ONGOING)
+	{
+		step(onOwnThread);
+	}
+	return currentOutcome;
+}
+
+std::string HeadlessBattle::entityName(ECS::Entity entity)
+{
+	if (entity.has<PlayerComponent>())
+	{
+		switch (entity.get<PlayerComponent>().player)
+		{
+		case PlayerType::RAOUL: return "raoul";
+		case PlayerType::TAJI: return "taji";
+		case PlayerType::EMBER: return "ember";
+		case PlayerType::CHIA: return "chia";
+		}
+	}
+
+	std::string type = "mob";
+	if (entity.has<Egg>()) type = "egg";
+	else if (entity.has<Pepper>()) type = "pepper";
+	else if (entity.has<Milk>()) type = "milk";
+	else if (entity.has<Potato>()) type = "potato";
+	else if (entity.has<MashedPotato>()) type = "mashedpotato";
+	else if (entity.has<PotatoChunk>()) type = "potatochunk";
+	else if (entity.has<Tomato>()) type = "tomato";
+	else if (entity.has<Lettuce>()) type = "lettuce";
+	else if (entity.has<SaltnPepper>()) type = "saltnpepper";
+	else if (entity.has<Chicken>()) type = "chicken";
+	return type + "#" + std::to_string(entity.id);
+}
+
+void HeadlessBattle::onStartNextRound(const StartNextRoundEvent&)
+{
+	currentRound++;
+	if (config.recordRounds && !reachedRoundLimit())
+		recordRound();
+}
+
+void HeadlessBattle::onSetActiveSkill(const SetActiveSkillEvent& event)
+{
+	if (!config.recordRounds || roundRecords.empty() ||
+			event.type == SkillType::MOVE || event.type == SkillType::NONE)
+	{
+		return;
+	}
+
+	// Mobs spawned during the round, e.g. potato chunks, aren't in the record yet
+	ECS::Entity entity = event.entity;
+	const std::string name = entityName(entity);
+	auto& entities = roundRecords.back().entities;
+	auto it = std::find_if(entities.begin(), entities.end(), [&name](const EntityRecord& record) {
+		return record.name == name;
+	});
+	if (it == entities.end())
+	{
+		const float hp = entity.has<StatsComponent>() ? entity.get<StatsComponent>().getStatValue(StatType::HP) : 0.f;
+		entities.push_back({ name, hp, SkillType::NONE });
+		it = entities.end() - 1;
+	}
+	if (it->skill == SkillType::NONE)
+		it->skill = event.type;
+}
+
+void HeadlessBattle::replayInput()
+{
+	InputEvent event;
+	while (InputReplay::instance().nextEvent(event))
+	{
+		switch (event.type)
+		{
+		case InputEvent::Type::KEY:
+			if (GameStateSystem::instance().inGameState())
+			{
+				CameraSystem::onKey(event.key, event.action);
+				TutorialSystem::onKey(event.key, event.action);
+			}
+			break;
+		case InputEvent::Type::MOUSE_CLICK:
+			if (event.action == GLFW_RELEASE && event.key == GLFW_MOUSE_BUTTON_LEFT && !GameStateSystem::instance().isTransitioning)
+				EventSystem<RawMouseClickEvent>::instance().sendEvent({ event.mousePos });
+			break;
+		case InputEvent::Type::MOUSE_HOVER:
+			EventSystem<RawMouseHoverEvent>::instance().sendEvent({ event.mousePos });
+			break;
+		}
+	}
+}
+
+void HeadlessBattle::recordRound()
+{
+	RoundRecord record;
+	record.round = currentRound;
+
+	auto addEntity = [&record](ECS::Entity entity) {
+		if (!entity.has<StatsComponent>())
+			return;
+		// Dead players stay around with a death timer, at 0 HP
+		const float hp = entity.has<DeathTimer>() ? 0.f : entity.get<StatsComponent>().getStatValue(StatType::HP);
+		record.entities.push_back({ entityName(entity), hp, SkillType::NONE });
+	};
+	for (auto player : ECS::registry<PlayerComponent>().entities)
+		addEntity(player);
+	for (auto mob : ECS::registry<AISystem::MobComponent>().entities)
+		addEntity(mob);
+
+	roundRecords.push_back(std::move(record));
+}
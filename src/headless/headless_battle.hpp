@@ -0,0 +1,134 @@
+#pragma once
+
+#include "player_autopilot.hpp"
+#include "player_policy.hpp"
+
+#include "game/common.hpp"
+#include "game/battle_system.hpp"
+#include "game/camera_system.hpp"
+#include "game/turn_system.hpp"
+#include "game/stats_system.hpp"
+#include "game/range_indicator_system.hpp"
+#include "game/system_scheduler.hpp"
+#include "game/event_system.hpp"
+#include "entities/tiny_ecs.hpp"
+#include "physics/physics.hpp"
+#include "physics/projectile_system.hpp"
+#include "ai/ai.hpp"
+#include "ai/behaviour_tree.hpp"
+#include "ai/swarm_behaviour.hpp"
+#include "animation/animation_system.hpp"
+#include "maps/path_finding_system.hpp"
+#include "skills/skill_system.hpp"
+#include "effects/effect_system.hpp"
+#include "ui/ui_system.hpp"
+#include "ui/tutorials.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// One battle of a recipe map, played by the same systems as the game minus the window, the renderer,
+// the particles and the audio. Player turns are taken by a PlayerAutopilot, or by the input of a
+// recorded session (see InputReplay), mob turns by their behaviour trees as in the game.
+//
+// Everything is created in the ECS::World that is current when the battle is constructed, and that
+// world has to be current whenever the battle is stepped or destroyed. Several battles can run at the
+// same time on different threads as long as each has its own world.
+class HeadlessBattle
+{
+public:
+	struct Config
+	{
+		std::string recipe = "recipe-1";
+		// The recipe itself, read from data/levels/<recipe>.json if it's null
+		json recipeData;
+		int mapIndex = 0;
+		std::shared_ptr<PlayerPolicy> policy;
+		// Rounds after which the battle counts as a defeat, 0 for no limit
+		int maxRounds = 0;
+		// Whether to keep a RoundRecord of every round
+		bool recordRounds = false;
+		// Whether the players are driven by the input of the InputReplay rather than by the policy,
+		// which may then be null. The recipe and map have to be the replayed session's.
+		bool replayInput = false;
+		// Whether the autopilot plays through clicks, which the InputReplay records. The recipe and map
+		// have to be the recorded session's.
+		bool recordInput = false;
+	};
+
+	// The HP of an entity at the start of a round, and the first skill it used during it
+	struct EntityRecord
+	{
+		std::string name;
+		float hp;
+		SkillType skill; // NONE if it didn't use one
+	};
+
+	struct RoundRecord
+	{
+		int round;
+		std::vector<EntityRecord> entities;
+	};
+
+	// The fixed timestep, in milliseconds
+	static constexpr float STEP_MS = 16.67f;
+
+	// Loads the map. Throws std::runtime_error if the recipe has no such map.
+	explicit HeadlessBattle(const Config& config);
+	~HeadlessBattle();
+
+	// Steps every system once. A battle with a thread of its own runs its systems one after the other
+	// instead of on the JobSystem, and leaves the main thread jobs to the main thread.
+	BattleSystem::Outcome step(bool onOwnThread = false);
+	// Steps until the battle ends or `maxSteps` steps have been taken
+	BattleSystem::Outcome run(long long maxSteps, bool onOwnThread = false);
+
+	inline BattleSystem::Outcome outcome() const { return currentOutcome; }
+	// Rounds started so far, counting from 0
+	inline int round() const { return currentRound; }
+	inline long long steps() const { return numSteps; }
+	// Whether the battle was lost because it reached Config::maxRounds
+	inline bool reachedRoundLimit() const { return config.maxRounds > 0 && currentRound >= config.maxRounds; }
+	inline const std::vector<RoundRecord>& rounds() const { return roundRecords; }
+
+	// "raoul", "potato#12", etc.
+	static std::string entityName(ECS::Entity entity);
+
+private:
+	void onStartNextRound(const StartNextRoundEvent& event);
+	void onSetActiveSkill(const SetActiveSkillEvent& event);
+	void recordRound();
+	// Feeds the input of the current update step of the InputReplay to the systems, as WorldSystem
+	// does in the game. Only the battle keys are replayed: the camera, the help overlay and inspect mode.
+	void replayInput();
+
+	Config config;
+
+	CameraSystem camera;
+	PathFindingSystem pathFindingSystem;
+	PhysicsSystem physics;
+	AISystem ai;
+	StateSystem stateSystem;
+	TurnSystem turnSystem;
+	AnimationSystem animations;
+	EffectSystem effectSystem;
+	UISystem ui;
+	ProjectileSystem projectileSystem;
+	SkillSystem skillSystem;
+	StatsSystem statsSystem;
+	TutorialSystem tutorialSystem;
+	RangeIndicatorSystem rangeIndicatorSystem;
+	SwarmBehaviour swarmBehaviour;
+	BattleSystem battle;
+	PlayerAutopilot autopilot;
+	SystemScheduler scheduler;
+
+	EventListenerInfo startNextRoundListener;
+	EventListenerInfo setActiveSkillListener;
+
+	BattleSystem::Outcome currentOutcome;
+	int currentRound;
+	long long numSteps;
+	std::vector<RoundRecord> roundRecords;
+};
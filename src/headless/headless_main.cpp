@@ -0,0 +1,124 @@
+// Entry point of ambrosia_headless: plays one battle of a recipe without a window, a GPU or audio,
+// stepping the game systems at a fixed timestep as fast as the CPU allows (see HeadlessBattle).
+// Usage: ambrosia_headless [recipe] [map index] [max steps] [policy] [seed]
+//        ambrosia_headless --replay <file> [max steps]
+//        ambrosia_headless --record <file> [recipe] [map index] [max steps] [policy] [seed]
+// The policy is one of PlayerPolicy::names(), super-strategic by default. The seed of the battle, which the
+// policy and the mobs derive theirs from, is random unless it's given, and is printed so that a battle
+// can be played again. With --replay, the players are
+// driven by the input of a session recorded with `ambrosia --record` instead, on the session's map, until
+// the session ends. With --record, the policy plays by clicking, and its clicks are written to the file
+// as a session that --replay and the benchmarks can play back.
+// Exits with 0 on victory, 1 on defeat and 2 if the battle didn't end within the step limit.
+// A recording that can't be written exits with 3, a battle that can't be set up, e.g. a map that can't be
+// loaded, with 4. The map is recipe-1 map 1, the potato boss, by default.
+// With AMBROSIA_TRACE set to a path, the profiler's samples of the battle are written there as a Chrome trace.
+
+#include "headless_battle.hpp"
+#include "player_policy.hpp"
+
+#include "jobs/job_system.hpp"
+#include "memory/allocation_counter.hpp"
+#include "profiling/profiler.hpp"
+#include "replay/input_replay.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using Clock = std::chrono::high_resolution_clock;
+
+namespace
+{
+	int play(int argc, char* argv[])
+	{
+		const char* tracePath = std::getenv("AMBROSIA_TRACE");
+		if (tracePath != nullptr)
+		{
+			Profiler::instance().setEnabled(true);
+			Profiler::instance().setThreadName("main");
+			JobSystem::instance().setJobHooks(&Profiler::onJobBegin, &Profiler::onJobEnd);
+		}
+
+		HeadlessBattle::Config config;
+		long long maxSteps = 200000;
+		std::string policyName = "super-strategic";
+		auto& replay = InputReplay::instance();
+		if (argc > 2 && std::string(argv[1]) == "--replay")
+		{
+			replay.startReplay(argv[2]);
+			config.recipe = replay.getRecipe();
+			config.mapIndex = replay.getMapIndex();
+			config.replayInput = true;
+			maxSteps = argc > 3 ? std::stoll(argv[3]) : replay.getLength();
+			policyName = "replayed";
+		}
+		else
+		{
+			// --record shifts the other arguments by two
+			const bool record = argc > 2 && std::string(argv[1]) == "--record";
+			const int first = record ? 3 : 1;
+			config.recipe = argc > first ? argv[first] : "recipe-1";
+			config.mapIndex = argc > first + 1 ? std::stoi(argv[first + 1]) : 1;
+			maxSteps = argc > first + 2 ? std::stoll(argv[first + 2]) : maxSteps;
+			policyName = argc > first + 3 ? argv[first + 3] : policyName;
+			const unsigned int seed = argc > first + 4 ? static_cast<unsigned int>(std::stoul(argv[first + 4]))
+				: std::random_device()();
+			if (record)
+			{
+				replay.startRecording(argv[2], config.recipe, config.mapIndex, seed);
+				config.recordInput = true;
+			}
+			else
+			{
+				replay.startSeeded(seed);
+			}
+			config.policy = PlayerPolicy::create(policyName, replay.seedFor("player policy"));
+		}
+
+		HeadlessBattle battle(config);
+
+		const auto start = Clock::now();
+		while (battle.steps() < maxSteps && battle.outcome() == BattleSystem::Outcome::ONGOING && !replay.isFinished())
+		{
+			AllocationCounter::beginFrame();
+			battle.step();
+			AllocationCounter::endFrame();
+		}
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		const auto outcome = battle.outcome();
+		const char* result = outcome == BattleSystem::Outcome::VICTORY ? "victory"
+			: outcome == BattleSystem::Outcome::DEFEAT ? "defeat" : "unfinished";
+		std::cout << "Headless battle: " << config.recipe << " map " << config.mapIndex << ", " << policyName << " players, seed "
+			<< replay.getSeed() << ", "
+			<< result << " after " << battle.round() + 1 << " rounds, " << battle.steps() << " steps ("
+			<< battle.steps() * HeadlessBattle::STEP_MS / 1000.f << " s of game time) in " << seconds << " s, "
+			<< battle.steps() / seconds << " steps/s" << std::endl;
+		AllocationCounter::printStats();
+		if (replay.isRecording() && !replay.save())
+			return 3;
+		if (tracePath != nullptr)
+			Profiler::instance().writeChromeTrace(tracePath);
+
+		if (outcome == BattleSystem::Outcome::VICTORY)
+			return 0;
+		return outcome == BattleSystem::Outcome::DEFEAT ? 1 : 2;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		return play(argc, argv);
+	}
+	catch (const std::exception& error)
+	{
+		std::cerr << "ambrosia_headless: " << error.what() << std::endl;
+		return 4;
+	}
+}
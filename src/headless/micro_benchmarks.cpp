@@ -0,0 +1,505 @@
+// Micro-benchmarks of the data structures and algorithms that the systems lean on, built as the
+// ambrosia_microbench target: the ECS::ComponentContainer operations at 1k to 1M entities, path finding
+// on every shipped navmesh and on synthetic grids, the circular and conical entity providers, the
+// stat lookups, EventSystem::sendEvent and the text layout of drawText.
+// Usage: ambrosia_microbench [--filter <substring>] [--min-time <seconds>] [--output <file>]
+// Every benchmark repeats until it has run for the minimum time (0.25 s by default) and at least 3 times,
+// and reports the median and the fastest time per operation. The results are written as JSON to the
+// output file, microbench.json by default, to be tracked over time.
+// Run from the repository root, or from the build directory that has a copy of data/.
+
+#include "entities/tiny_ecs.hpp"
+#include "game/event_system.hpp"
+#include "game/events.hpp"
+#include "game/stats_component.hpp"
+#include "game/stats_system.hpp"
+#include "level_loader/level_loader.hpp"
+#include "maps/map.hpp"
+#include "maps/path_finding_system.hpp"
+#include "memory/frame_arena.hpp"
+#include "rendering/text_layout.hpp"
+#include "skills/entity_provider.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	// Results go here, so that the compiler can't drop the work that produces them
+	volatile double sink = 0.0;
+
+	struct Settings
+	{
+		std::string filter;
+		double minSeconds = 0.25;
+	};
+
+	class Runner
+	{
+	public:
+		explicit Runner(const Settings& settings) : settings(settings) {}
+
+		bool isSelected(const std::string& name) const
+		{
+			return settings.filter.empty() || name.find(settings.filter) != std::string::npos;
+		}
+
+		// Times `run`, which does `numOps` operations, after every call to `setup`, which isn't timed
+		template<class Setup, class Run>
+		void measure(const std::string& name, const json& params, size_t numOps, Setup&& setup, Run&& run)
+		{
+			if (!isSelected(name))
+				return;
+
+			std::vector<double> nsPerOp;
+			double seconds = 0.0;
+			while (nsPerOp.size() < 3 || seconds < settings.minSeconds)
+			{
+				setup();
+				const auto start = Clock::now();
+				run();
+				const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+				seconds += elapsed;
+				nsPerOp.push_back(elapsed * 1e9 / numOps);
+			}
+			std::sort(nsPerOp.begin(), nsPerOp.end());
+
+			const double median = nsPerOp[nsPerOp.size() / 2];
+			std::cout << "  " << name << " " << params.dump() << ": " << median << " ns/op (fastest " << nsPerOp.front()
+				<< ", " << nsPerOp.size() << " runs)" << std::endl;
+			results.push_back({
+				{ "name", name },
+				{ "params", params },
+				{ "ops", numOps },
+				{ "runs", nsPerOp.size() },
+				{ "medianNsPerOp", median },
+				{ "minNsPerOp", nsPerOp.front() }
+			});
+		}
+
+		// For the benchmarks that are set up once
+		template<class Run>
+		void measure(const std::string& name, const json& params, size_t numOps, Run&& run)
+		{
+			measure(name, params, numOps, []() {}, std::forward<Run>(run));
+		}
+
+		const json& getResults() const { return results; }
+
+	private:
+		Settings settings;
+		json results = json::array();
+	};
+
+	// A world of its own for every setup, current while it lives
+	struct Fixture
+	{
+		ECS::World world;
+		ECS::World::Scope scope{ world };
+		std::vector<ECS::Entity> entities;
+	};
+
+	struct BenchComponent
+	{
+		vec2 position;
+		float value;
+	};
+
+	struct BenchEvent
+	{
+		int value;
+	};
+
+	// ------------------------------------------------------------------ ECS::ComponentContainer
+
+	void componentContainer(Runner& runner)
+	{
+		const size_t sizes[] = { 1000, 10000, 100000, 1000000 };
+		for (size_t n : sizes)
+		{
+			const json params = { { "entities", n } };
+			std::unique_ptr<Fixture> fixture;
+			std::default_random_engine rng(static_cast<unsigned int>(n));
+
+			// The entities in a random order, with or without their components
+			auto makeFixture = [&](bool withComponents) {
+				fixture.reset();
+				fixture.reset(new Fixture());
+				fixture->entities.reserve(n);
+				for (size_t i = 0; i < n; i++)
+				{
+					fixture->entities.push_back(ECS::Entity::create());
+				}
+				std::shuffle(fixture->entities.begin(), fixture->entities.end(), rng);
+				if (withComponents)
+				{
+					auto& container = ECS::registry<BenchComponent>();
+					for (auto entity : fixture->entities)
+					{
+						container.emplace(entity, BenchComponent{ vec2(0.f), static_cast<float>(entity.id) });
+					}
+					std::shuffle(fixture->entities.begin(), fixture->entities.end(), rng);
+				}
+			};
+
+			runner.measure("ComponentContainer/insert", params, n, [&]() { makeFixture(false); }, [&]() {
+				auto& container = ECS::registry<BenchComponent>();
+				for (auto entity : fixture->entities)
+				{
+					container.emplace(entity, BenchComponent{ vec2(0.f), 1.f });
+				}
+			});
+
+			runner.measure("ComponentContainer/remove", params, n, [&]() { makeFixture(true); }, [&]() {
+				auto& container = ECS::registry<BenchComponent>();
+				for (auto entity : fixture->entities)
+				{
+					container.remove(entity);
+				}
+			});
+
+			runner.measure("ComponentContainer/sort", params, n, [&]() { makeFixture(true); }, [&]() {
+				ECS::registry<BenchComponent>().sort([](ECS::Entity a, ECS::Entity b) { return a.id < b.id; });
+			});
+
+			if (!runner.isSelected("ComponentContainer/get") && !runner.isSelected("ComponentContainer/has"))
+				continue;
+
+			makeFixture(true);
+			runner.measure("ComponentContainer/get", params, n, [&]() {
+				auto& container = ECS::registry<BenchComponent>();
+				float sum = 0.f;
+				for (auto entity : fixture->entities)
+				{
+					sum += container.get(entity).value;
+				}
+				sink = sum;
+			});
+
+			// Half of the entities have the component
+			for (size_t i = 0; i < n; i += 2)
+			{
+				fixture->entities[i].remove<BenchComponent>();
+			}
+			runner.measure("ComponentContainer/has", params, n, [&]() {
+				auto& container = ECS::registry<BenchComponent>();
+				size_t count = 0;
+				for (auto entity : fixture->entities)
+				{
+					count += container.has(entity) ? 1 : 0;
+				}
+				sink = static_cast<double>(count);
+			});
+		}
+	}
+
+	// ------------------------------------------------------------------ PathFindingSystem
+
+	// The walkable tiles of the current map, as world positions
+	std::vector<vec2> walkablePoints()
+	{
+		const auto& map = ECS::registry<MapComponent>().components.front();
+		PathFindingSystem pathFinding;
+		std::vector<vec2> points;
+		for (size_t y = 0; y < map.grid.size(); y++)
+		{
+			for (size_t x = 0; x < map.grid[y].size(); x++)
+			{
+				const vec2 point = vec2(x, y) * map.tileSize;
+				if (map.grid[y][x] == 3 && pathFinding.isWalkablePoint(point))
+					points.push_back(point);
+			}
+		}
+		return points;
+	}
+
+	// Paths from one walkable tile to others, in the map of the current world
+	void measurePaths(Runner& runner, const json& params)
+	{
+		const auto points = walkablePoints();
+		if (points.size() < 2)
+			throw std::runtime_error("the map has no walkable tiles");
+
+		std::default_random_engine rng(7);
+		std::uniform_int_distribution<size_t> pick(0, points.size() - 1);
+		auto source = ECS::Entity::create();
+		source.emplace<Motion>().position = points[pick(rng)];
+		std::vector<vec2> destinations;
+		for (int i = 0; i < 64; i++)
+		{
+			destinations.push_back(points[pick(rng)]);
+		}
+
+		PathFindingSystem pathFinding;
+		runner.measure("PathFindingSystem/getShortestPath", params, destinations.size(), [&]() {
+			size_t length = 0;
+			for (const auto& destination : destinations)
+			{
+				length += pathFinding.getShortestPath(source, destination).size();
+			}
+			sink = static_cast<double>(length);
+		});
+	}
+
+	void pathFinding(Runner& runner)
+	{
+		if (!runner.isSelected("PathFindingSystem/getShortestPath"))
+			return;
+
+		// The navmeshes of the maps of every level
+		std::set<std::string> mapNames;
+		for (const char* level : { "tutorial", "recipe-1", "recipe-2", "recipe-3" })
+		{
+			const json recipe = LevelLoader().readLevel(level);
+			for (const auto& map : recipe.at("maps"))
+			{
+				mapNames.insert(map.at("map").get<std::string>());
+			}
+		}
+		for (const auto& name : mapNames)
+		{
+			Fixture fixture;
+			try
+			{
+				MapComponent::createMap(name, vec2(1366.f, 900.f));
+			}
+			catch (const std::exception& error)
+			{
+				std::cout << "  skipping the " << name << " navmesh: " << error.what() << std::endl;
+				continue;
+			}
+			measurePaths(runner, { { "map", name } });
+		}
+
+		// Open fields with a fifth of the tiles blocked
+		for (int size : { 64, 128, 256 })
+		{
+			Fixture fixture;
+			auto& map = ECS::Entity::create().emplace<MapComponent>();
+			map.name = "synthetic";
+			map.grid.assign(size, std::vector<int>(size, 3));
+			map.mapSize = vec2(static_cast<float>(size)) * map.tileSize;
+			std::default_random_engine rng(static_cast<unsigned int>(size));
+			std::bernoulli_distribution blocked(0.2);
+			for (auto& row : map.grid)
+			{
+				for (auto& tile : row)
+				{
+					if (blocked(rng))
+						tile = 0;
+				}
+			}
+			measurePaths(runner, { { "map", "synthetic" }, { "tiles", size * size } });
+		}
+	}
+
+	// ------------------------------------------------------------------ EntityProviders
+
+	void entityProviders(Runner& runner)
+	{
+		for (size_t n : { 10, 100, 1000, 10000 })
+		{
+			Fixture fixture;
+			std::default_random_engine rng(static_cast<unsigned int>(n));
+			std::uniform_real_distribution<float> x(0.f, 2000.f);
+			std::uniform_real_distribution<float> y(0.f, 1200.f);
+			for (size_t i = 0; i < n; i++)
+			{
+				auto& motion = ECS::Entity::create().emplace<Motion>();
+				motion.position = { x(rng), y(rng) };
+				motion.boundingBox = { 100.f, 150.f };
+			}
+			auto instigator = ECS::registry<Motion>().entities.front();
+			std::vector<vec2> targets;
+			for (int i = 0; i < 100; i++)
+			{
+				targets.push_back({ x(rng), y(rng) });
+			}
+
+			const json params = { { "entities", n } };
+			CircularProvider circular(300.f);
+			ConicalProvider conical(PI / 8.f);
+			auto query = [&](EntityProvider& provider) {
+				size_t count = 0;
+				for (const auto& target : targets)
+				{
+					count += provider.getEntities(instigator, target).size();
+					FrameArena::endFrame();
+				}
+				sink = static_cast<double>(count);
+			};
+			runner.measure("CircularProvider/getEntities", params, targets.size(), [&]() { query(circular); });
+			runner.measure("ConicalProvider/getEntities", params, targets.size(), [&]() { query(conical); });
+		}
+	}
+
+	// ------------------------------------------------------------------ StatsComponent
+
+	void stats(Runner& runner)
+	{
+		const StatType types[] = {
+			StatType::HP, StatType::MAX_HP, StatType::STRENGTH, StatType::HP_SHIELD, StatType::LEVEL, StatType::STUNNED
+		};
+		const size_t numLookups = 100000;
+
+		for (bool withModifiers : { false, true })
+		{
+			Fixture fixture;
+			StatsSystem statsSystem;
+			auto entity = ECS::Entity::create();
+			auto& statsComponent = entity.emplace<StatsComponent>();
+			for (StatType type : types)
+			{
+				statsComponent.setBaseValue(type, 10.f);
+			}
+			if (withModifiers)
+			{
+				// As the buff skills apply them
+				EventSystem<BuffEvent>::instance().sendEvent({ entity, { StatType::STRENGTH, 5.f, 2 } });
+				EventSystem<BuffEvent>::instance().sendEvent({ entity, { StatType::HP_SHIELD, 20.f, 2 } });
+			}
+
+			runner.measure("StatsComponent/getStatValue", { { "modifiers", withModifiers } }, numLookups, [&]() {
+				float sum = 0.f;
+				for (size_t i = 0; i < numLookups; i++)
+				{
+					sum += statsComponent.getStatValue(types[i % (sizeof(types) / sizeof(types[0]))]);
+				}
+				sink = sum;
+			});
+		}
+	}
+
+	// ------------------------------------------------------------------ EventSystem
+
+	void events(Runner& runner)
+	{
+		const size_t numEvents = 10000;
+		for (size_t n : { 1, 10, 100, 1000 })
+		{
+			Fixture fixture;
+			auto& eventSystem = EventSystem<BenchEvent>::instance();
+			int total = 0;
+			for (size_t i = 0; i < n; i++)
+			{
+				eventSystem.registerListener([&total](const BenchEvent& event) { total += event.value; });
+			}
+
+			runner.measure("EventSystem/sendEvent", { { "listeners", n } }, numEvents, [&]() {
+				for (size_t i = 0; i < numEvents; i++)
+				{
+					eventSystem.sendEvent({ 1 });
+				}
+				sink = total;
+			});
+		}
+	}
+
+	// ------------------------------------------------------------------ Text layout
+
+	// Glyph metrics like Font::Character's, made up since FreeType isn't linked headless
+	struct Glyph
+	{
+		ivec2 Size;
+		ivec2 Bearing;
+		unsigned int Advance;
+	};
+
+	void textLayout(Runner& runner)
+	{
+		std::vector<Glyph> glyphs(256);
+		for (size_t c = 0; c < glyphs.size(); c++)
+		{
+			const int width = 8 + static_cast<int>(c % 7);
+			glyphs[c] = { ivec2(width, 14 + static_cast<int>(c % 5)), ivec2(1, 12), static_cast<unsigned int>((width + 2) * 64) };
+		}
+		auto getGlyph = [&glyphs](char32_t c) -> const Glyph& { return glyphs[c % glyphs.size()]; };
+
+		const std::string tooltip = "Deals 30 damage to every enemy in a cone in front of Taji, and stuns them for one turn. ";
+		std::string paragraph;
+		for (int i = 0; i < 6; i++)
+		{
+			paragraph += tooltip;
+		}
+		const std::pair<const char*, std::string> texts[] = {
+			{ "label", "Ambrosia: 120" },
+			{ "tooltip", tooltip },
+			{ "utf-8", u8"Crème brûlée, jalapeño, Käsespätzle and mille-feuille: délicieux!" },
+			{ "paragraph", paragraph }
+		};
+		const size_t numLayouts = 1000;
+		for (const auto& text : texts)
+		{
+			runner.measure("drawText/layout", { { "text", text.first }, { "characters", text.second.size() } }, numLayouts, [&]() {
+				float extent = 0.f;
+				for (size_t i = 0; i < numLayouts; i++)
+				{
+					layoutText(utf8ToUtf32(text.second), vec2(100.f, 800.f), 0.8f, getGlyph,
+						[&extent](const Glyph&, const float (&vertices)[6][4]) { extent += vertices[5][0]; });
+					FrameArena::endFrame();
+				}
+				sink = extent;
+			});
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Settings settings;
+	std::string outputPath = "microbench.json";
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string arg = argv[i];
+		if (arg == "--filter")
+			settings.filter = argv[i + 1];
+		else if (arg == "--min-time")
+			settings.minSeconds = std::stod(argv[i + 1]);
+		else if (arg == "--output")
+			outputPath = argv[i + 1];
+		else
+		{
+			std::cerr << "ambrosia_microbench: unknown argument " << arg << std::endl;
+			return 1;
+		}
+	}
+	if (argc % 2 == 0)
+	{
+		std::cerr << "ambrosia_microbench: " << argv[argc - 1] << " needs a value" << std::endl;
+		return 1;
+	}
+
+	Runner runner(settings);
+	std::cout << "ECS::ComponentContainer" << std::endl;
+	componentContainer(runner);
+	std::cout << "PathFindingSystem" << std::endl;
+	pathFinding(runner);
+	std::cout << "EntityProviders" << std::endl;
+	entityProviders(runner);
+	std::cout << "StatsComponent" << std::endl;
+	stats(runner);
+	std::cout << "EventSystem" << std::endl;
+	events(runner);
+	std::cout << "Text layout" << std::endl;
+	textLayout(runner);
+
+	std::ofstream file(outputPath);
+	if (!file)
+	{
+		std::cerr << "ambrosia_microbench: can't write " << outputPath << std::endl;
+		return 1;
+	}
+	file << json({ { "benchmarks", runner.getResults() } }).dump(2) << std::endl;
+	std::cout << "Wrote " << runner.getResults().size() << " results to " << outputPath << std::endl;
+	return 0;
+}
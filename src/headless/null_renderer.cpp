@@ -0,0 +1,88 @@
+// Stand-ins for the OpenGL parts of the rendering module, linked into ambrosia_headless instead of
+// render*.cpp and shader_registry.cpp (see null_text.cpp for text.cpp). Nothing is uploaded to a
+// GPU, but textures still get the size of their image, read from the file header, since gameplay
+// derives bounding boxes and clickable areas from it. Built resources get a stub program handle,
+// so the code that checks `effect.program` to see whether a resource is built (and the
+// ResourceManager) behaves as it does in the game.
+
+#include "rendering/render.hpp"
+#include "rendering/render_components.hpp"
+#include "rendering/resource_manager.hpp"
+
+#include "stb_image.h"
+
+#include <stdexcept>
+
+namespace
+{
+	// Never passed to OpenGL
+	const GLuint STUB_PROGRAM = 1;
+
+	ivec2 imageSize(const std::string& path)
+	{
+		int width, height, numChannels;
+		if (!stbi_info(path.c_str(), &width, &height, &numChannels))
+			throw std::runtime_error("Failed to read the size of " + path);
+		return { width, height };
+	}
+}
+
+template<> GLResource<BUFFER>::~GLResource() noexcept {}
+template<> GLResource<VERTEX_ARRAY>::~GLResource() noexcept {}
+template<> GLResource<RENDER_BUFFER>::~GLResource() noexcept {}
+template<> GLResource<TEXTURE>::~GLResource() noexcept {}
+template<> GLResource<PROGRAM>::~GLResource() noexcept {}
+template<> GLResource<SHADER>::~GLResource() noexcept {}
+
+void Texture::loadFromFile(const std::string& path)
+{
+	size = imageSize(path);
+}
+
+void Effect::loadFromFile(const std::string&, const std::string&)
+{
+	program = STUB_PROGRAM;
+}
+
+void RenderSystem::createSprite(ShadedMesh& sprite, const std::string& texture_path, const std::string& shader_name)
+{
+	sprite.effect.program = STUB_PROGRAM;
+	if (texture_path.length() > 0)
+	{
+		sprite.texture.size = imageSize(texture_path);
+		ResourceManager::instance().recordBuild(sprite, { ResourceBuildType::SPRITE, texture_path, shader_name });
+	}
+}
+
+void RenderSystem::createTexturedMesh(ShadedMesh& sprite, const std::string& texture_path, const std::string&)
+{
+	sprite.effect.program = STUB_PROGRAM;
+	if (texture_path.length() > 0)
+		sprite.texture.size = imageSize(texture_path);
+}
+
+void RenderSystem::createAnimatedSprite(ShadedMesh& sprite, int maxFrames, const std::string& texture_path, const std::string& shader_name)
+{
+	sprite.texture.frames = maxFrames;
+	sprite.effect.program = STUB_PROGRAM;
+	if (texture_path.length() > 0)
+	{
+		sprite.texture.size = imageSize(Texture::framePath(texture_path, 0));
+		ResourceManager::instance().recordBuild(sprite, { ResourceBuildType::ANIMATED_SPRITE, texture_path, shader_name, maxFrames });
+	}
+}
+
+void RenderSystem::createPlayerSpecificMesh(ShadedMesh& sprite, const std::string& texture_path, const std::string& shader_name)
+{
+	sprite.effect.program = STUB_PROGRAM;
+	if (texture_path.length() > 0)
+	{
+		sprite.texture.size = imageSize(texture_path + "/raoul.png");
+		ResourceManager::instance().recordBuild(sprite, { ResourceBuildType::PLAYER_SPECIFIC, texture_path, shader_name });
+	}
+}
+
+void RenderSystem::createColoredMesh(ShadedMesh& texmesh, const std::string&)
+{
+	texmesh.effect.program = STUB_PROGRAM;
+}
@@ -0,0 +1,33 @@
+// Stand-in for text.cpp in ambrosia_headless, see null_renderer.cpp. Text entities keep their
+// content and position, but no font is loaded, so FreeType isn't needed.
+
+#include "rendering/text.hpp"
+
+Text::Text(std::string content, std::shared_ptr<Font> font, glm::vec2 position, float scale, glm::vec3 colour) noexcept
+	: content(std::move(content))
+	, font(std::move(font))
+	, position(position)
+	, scale(scale)
+	, colour(colour)
+{}
+
+Text::Text(std::string content, const std::string&, glm::vec2 position, float scale, glm::vec3 colour) noexcept
+	: Text(std::move(content), std::shared_ptr<Font>(), position, scale, colour)
+{}
+
+void addText(ECS::Entity entity, const std::string& text, vec2 position, float scale, vec3 color)
+{
+	entity.emplace<Text>(text, std::shared_ptr<Font>(), position, scale, color);
+}
+
+ECS::Entity createText(const std::string& text, vec2 position, float scale, vec3 color)
+{
+	auto entity = ECS::Entity::create();
+	addText(entity, text, position, scale, color);
+	return entity;
+}
+
+ECS::Entity createAchievementText(const std::string& text, vec2 position)
+{
+	return createText(text, position, 0.75f, vec3(1.f));
+}
@@ -0,0 +1,240 @@
+#include "parameter_sweep.hpp"
+
+#include "player_policy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+
+namespace
+{
+	// Past this, the sweep would take days anyway
+	const size_t MAX_CONFIGURATIONS = 1000000;
+
+	BattleSimulator::Settings simulatorSettings(const json& sweep, unsigned int numThreads)
+	{
+		BattleSimulator::Settings settings;
+		settings.recipe = sweep.at("recipe").get<std::string>();
+		settings.mapIndex = sweep.at("map").get<int>();
+		settings.maxRounds = sweep.value("maxRounds", settings.maxRounds);
+		settings.numThreads = numThreads;
+		settings.seed = sweep.value("seed", 0u);
+		settings.numRecordedGames = 0;
+		return settings;
+	}
+
+	// Either "values": [...], or "from", "to" and "step". Ranges of integers stay integers, like the
+	// values in the recipes.
+	std::vector<json> parameterValues(const json& parameter)
+	{
+		if (parameter.contains("values"))
+			return parameter.at("values").get<std::vector<json>>();
+
+		const json& from = parameter.at("from");
+		const json& to = parameter.at("to");
+		const json& step = parameter.at("step");
+		if (step.get<double>() <= 0.0)
+			throw std::runtime_error("the step of a sweep parameter must be positive");
+
+		const bool integers = from.is_number_integer() && to.is_number_integer() && step.is_number_integer();
+		const int count = static_cast<int>(std::floor((to.get<double>() - from.get<double>()) / step.get<double>() + 1e-6)) + 1;
+		std::vector<json> values;
+		for (int i = 0; i < count; i++)
+		{
+			if (integers)
+				values.push_back(from.get<long long>() + i * step.get<long long>());
+			else
+				values.push_back(std::round((from.get<double>() + i * step.get<double>()) * 1e6) / 1e6);
+		}
+		return values;
+	}
+}
+
+ParameterSweep::ParameterSweep(const json& sweep, unsigned int numThreads)
+	: simulator(simulatorSettings(sweep, numThreads))
+	, numRungs(0)
+{
+	recipe = simulator.getSettings().recipeData;
+	mapIndex = simulator.getSettings().mapIndex;
+	firstRungGames = std::max(1, sweep.value("firstRungGames", 8));
+	eta = std::max(2, sweep.value("eta", 2));
+
+	for (const auto& target : sweep.at("targets").items())
+	{
+		PlayerPolicy::create(target.key(), 0); // Throws for an unknown policy
+		targets[target.key()] = target.value().get<double>();
+	}
+	if (targets.empty())
+		throw std::runtime_error("a sweep needs the target victory rate of at least one policy");
+
+	const json& map = recipe["maps"][mapIndex];
+	size_t numConfigurations = 1;
+	for (const auto& parameterSpec : sweep.at("parameters"))
+	{
+		Parameter parameter;
+		const std::string path = parameterSpec.at("path").get<std::string>();
+		parameter.name = parameterSpec.value("name", path);
+		parameter.path = json::json_pointer(path);
+		parameter.values = parameterValues(parameterSpec);
+
+		if (!map.contains(parameter.path))
+			throw std::runtime_error(simulator.getSettings().recipe + " map " + std::to_string(mapIndex) + " has nothing at " + path);
+		if (parameter.values.empty())
+			throw std::runtime_error("the sweep parameter " + parameter.name + " has no values");
+
+		numConfigurations *= parameter.values.size();
+		if (numConfigurations > MAX_CONFIGURATIONS)
+			throw std::runtime_error("the sweep has more than " + std::to_string(MAX_CONFIGURATIONS) + " configurations");
+		parameters.push_back(std::move(parameter));
+	}
+
+	// Every combination of the values, the first parameter changing the slowest
+	configurations.resize(numConfigurations);
+	for (size_t i = 0; i < numConfigurations; i++)
+	{
+		auto& indices = configurations[i].valueIndices;
+		indices.resize(parameters.size());
+		size_t rest = i;
+		for (size_t p = parameters.size(); p-- > 0;)
+		{
+			indices[p] = rest % parameters[p].values.size();
+			rest /= parameters[p].values.size();
+		}
+	}
+}
+
+void ParameterSweep::run(std::ostream& log)
+{
+	std::vector<size_t> survivors(configurations.size());
+	for (size_t i = 0; i < survivors.size(); i++)
+	{
+		survivors[i] = i;
+	}
+
+	int games = firstRungGames;
+	for (numRungs = 1;; numRungs++)
+	{
+		log << "Rung " << numRungs << ": " << survivors.size() << " configurations, " << games
+			<< " more battles per policy each" << std::endl;
+		evaluate(survivors, games);
+
+		std::sort(survivors.begin(), survivors.end(), [this](size_t a, size_t b) {
+			return configurations[a].score < configurations[b].score;
+		});
+		log << "  best so far: " << describe(configurations[survivors.front()]) << std::endl;
+
+		if (survivors.size() == 1)
+			break;
+		survivors.resize((survivors.size() + eta - 1) / eta);
+		games *= eta;
+	}
+}
+
+void ParameterSweep::evaluate(const std::vector<size_t>& survivors, int gamesPerPolicy)
+{
+	// All the battles of the rung in one go, so that the threads are busy until its very end
+	std::vector<BattleSimulator::Game> games;
+	for (size_t index : survivors)
+	{
+		const auto& configuration = configurations[index];
+		const auto variant = std::make_shared<const json>(makeRecipe(configuration));
+		for (const auto& target : targets)
+		{
+			for (int game = 0; game < gamesPerPolicy; game++)
+			{
+				games.push_back({ target.first, static_cast<int>(index), configuration.gamesPerPolicy + game, variant });
+			}
+		}
+	}
+
+	for (const auto& result : simulator.run(games))
+	{
+		if (result.outcome == BattleSystem::Outcome::VICTORY)
+			configurations[result.batch].victories[result.policy]++;
+	}
+
+	for (size_t index : survivors)
+	{
+		auto& configuration = configurations[index];
+		configuration.gamesPerPolicy += gamesPerPolicy;
+		configuration.rung = numRungs;
+		configuration.score = 0.0;
+		for (const auto& target : targets)
+		{
+			const double victoryRate = static_cast<double>(configuration.victories[target.first]) / configuration.gamesPerPolicy;
+			configuration.score += std::abs(victoryRate - target.second);
+		}
+	}
+}
+
+json ParameterSweep::makeRecipe(const Configuration& configuration) const
+{
+	json variant = recipe;
+	json& map = variant["maps"][mapIndex];
+	for (size_t p = 0; p < parameters.size(); p++)
+	{
+		map[parameters[p].path] = parameters[p].values[configuration.valueIndices[p]];
+	}
+	return variant;
+}
+
+std::vector<const ParameterSweep::Configuration*> ParameterSweep::ranked() const
+{
+	std::vector<const Configuration*> sorted;
+	for (const auto& configuration : configurations)
+	{
+		sorted.push_back(&configuration);
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Configuration* a, const Configuration* b) {
+		return a->rung != b->rung ? a->rung > b->rung : a->score < b->score;
+	});
+	return sorted;
+}
+
+std::string ParameterSweep::describe(const Configuration& configuration) const
+{
+	std::string description;
+	for (size_t p = 0; p < parameters.size(); p++)
+	{
+		description += (p == 0 ? "" : ", ") + parameters[p].name + " = " +
+			parameters[p].values[configuration.valueIndices[p]].dump();
+	}
+	for (const auto& target : targets)
+	{
+		const auto victories = configuration.victories.find(target.first);
+		const int numVictories = victories == configuration.victories.end() ? 0 : victories->second;
+		description += ", " + target.first + " " + std::to_string(numVictories) + "/" +
+			std::to_string(configuration.gamesPerPolicy);
+	}
+	return description;
+}
+
+void ParameterSweep::writeSurface(std::ostream& csv) const
+{
+	for (const auto& parameter : parameters)
+	{
+		csv << parameter.name << ",";
+	}
+	for (const auto& target : targets)
+	{
+		csv << target.first << " victory rate,";
+	}
+	csv << "battles per policy,rung,score\n";
+
+	for (const auto& configuration : configurations)
+	{
+		for (size_t p = 0; p < parameters.size(); p++)
+		{
+			csv << parameters[p].values[configuration.valueIndices[p]].dump() << ",";
+		}
+		for (const auto& target : targets)
+		{
+			const auto victories = configuration.victories.find(target.first);
+			const int numVictories = victories == configuration.victories.end() ? 0 : victories->second;
+			csv << (configuration.gamesPerPolicy > 0 ? static_cast<double>(numVictories) / configuration.gamesPerPolicy : 0.0) << ",";
+		}
+		csv << configuration.gamesPerPolicy << "," << configuration.rung << "," << configuration.score << "\n";
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "battle_simulator.hpp"
+
+#include "game/common.hpp"
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+// Looks for the values of a map's parameters (mob and player stats) that bring the victory rates of
+// the player policies closest to their targets. Every configuration is a variant of the recipe made in
+// memory, evaluated with simulated battles.
+//
+// It uses successive halving: every configuration plays a few battles per policy, the better
+// configurations play more, and so on until one is left, so that clearly bad regions don't use up
+// the battles. The sweep is described in JSON, see data/balancing/potato-sweep.json.
+class ParameterSweep
+{
+public:
+	struct Parameter
+	{
+		std::string name;
+		// Relative to the map, e.g. /mobs/0/stats/hp
+		json::json_pointer path;
+		std::vector<json> values;
+	};
+
+	struct Configuration
+	{
+		// Into the values of each parameter
+		std::vector<size_t> valueIndices;
+		// Per policy
+		std::map<std::string, int> victories;
+		int gamesPerPolicy = 0;
+		// The last rung the configuration played on
+		int rung = 0;
+		// Sum over the policies of how far the victory rate is from its target, lower is better
+		double score = 0.0;
+	};
+
+	// Throws std::runtime_error if the sweep or its recipe isn't valid
+	ParameterSweep(const json& sweep, unsigned int numThreads);
+
+	// Plays the rungs, logging their progress
+	void run(std::ostream& log);
+
+	// One line per configuration, with its parameter values, victory rates and the rung it reached
+	void writeSurface(std::ostream& csv) const;
+	// The configurations of the last rung first, then by score
+	std::vector<const Configuration*> ranked() const;
+	std::string describe(const Configuration& configuration) const;
+
+	inline const std::vector<Parameter>& getParameters() const { return parameters; }
+	inline const std::vector<Configuration>& getConfigurations() const { return configurations; }
+
+private:
+	json makeRecipe(const Configuration& configuration) const;
+	void evaluate(const std::vector<size_t>& survivors, int gamesPerPolicy);
+
+	json recipe;
+	int mapIndex;
+	std::map<std::string, double> targets;
+	int firstRungGames;
+	// 1 / eta of the configurations move up to the next rung, which plays eta times as many battles
+	int eta;
+
+	std::vector<Parameter> parameters;
+	std::vector<Configuration> configurations;
+	BattleSimulator simulator;
+	int numRungs;
+};
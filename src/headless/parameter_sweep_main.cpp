@@ -0,0 +1,69 @@
+// Entry point of ambrosia_sweep: searches a map's parameters for the values that bring the victory
+// rates of the player policies closest to their targets (see ParameterSweep).
+// Usage: ambrosia_sweep [sweep file] [threads] [output file]
+// Defaults to data/balancing/potato-sweep.json, one thread per core and sweep.csv. The output has one
+// line per configuration, with its victory rates, e.g. for plotting them over two of the parameters.
+
+#include "parameter_sweep.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::high_resolution_clock;
+
+namespace
+{
+	int runSweep(int argc, char* argv[])
+	{
+		const std::string sweepPath = argc > 1 ? argv[1] : "data/balancing/potato-sweep.json";
+		const unsigned int numThreads = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+		const std::string outputPath = argc > 3 ? argv[3] : "sweep.csv";
+
+		std::ifstream sweepFile(sweepPath);
+		if (!sweepFile)
+			throw std::runtime_error("can't read " + sweepPath);
+		json sweepJson;
+		sweepFile >> sweepJson;
+
+		// Opened before sweeping, so that a bad path doesn't lose the results
+		std::ofstream output(outputPath);
+		if (!output)
+			throw std::runtime_error("can't write " + outputPath);
+
+		ParameterSweep sweep(sweepJson, numThreads);
+		std::cout << "Sweeping " << sweep.getConfigurations().size() << " configurations of " << sweep.getParameters().size()
+			<< " parameters on " << numThreads << " threads" << std::endl;
+
+		const auto start = Clock::now();
+		sweep.run(std::cout);
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		sweep.writeSurface(output);
+
+		std::cout << "Done in " << seconds << " s, the best configurations:" << std::endl;
+		const auto ranked = sweep.ranked();
+		for (size_t i = 0; i < std::min<size_t>(10, ranked.size()); i++)
+		{
+			std::cout << "  " << sweep.describe(*ranked[i]) << std::endl;
+		}
+		return EXIT_SUCCESS;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		return runSweep(argc, argv);
+	}
+	catch (const std::exception& error)
+	{
+		std::cerr << "ambrosia_sweep: " << error.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
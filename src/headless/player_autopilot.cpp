@@ -0,0 +1,193 @@
+#include "player_autopilot.hpp"
+
+#include "ai/ai.hpp"
+#include "game/camera.hpp"
+#include "game/event_system.hpp"
+#include "game/events.hpp"
+#include "game/game_state_system.hpp"
+#include "game/stats_component.hpp"
+#include "game/turn_system.hpp"
+#include "rendering/render_components.hpp"
+#include "replay/input_replay.hpp"
+#include "skills/skill_component.hpp"
+#include "ui/button.hpp"
+#include "ui/ui_components.hpp"
+
+namespace
+{
+	// How close to the target a player walks before using its skill, close enough for the melee skills
+	const float APPROACH_DISTANCE = 150.f;
+	// Steps without moving after which a move is given up
+	const int MAX_BLOCKED_STEPS = 60;
+}
+
+PlayerAutopilot::PlayerAutopilot(std::shared_ptr<PlayerPolicy> policy, bool clicks)
+	: policy(std::move(policy))
+	, clicks(clicks)
+	, lastPosition(0.f, 0.f)
+	, blockedSteps(0)
+{
+}
+
+void PlayerAutopilot::step(int round)
+{
+	if (ECS::registry<TurnSystem::TurnComponentIsActive>().entities.empty())
+	{
+		return;
+	}
+
+	auto activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
+	if (!activeEntity.has<PlayerComponent>() || !activeEntity.has<TurnSystem::TurnComponent>() ||
+			!activeEntity.has<Motion>() || activeEntity.has<DeathTimer>())
+	{
+		return;
+	}
+	if (activeEntity.has<StatsComponent>() && activeEntity.get<StatsComponent>().isStunned())
+	{
+		return;
+	}
+
+	auto& turnComponent = activeEntity.get<TurnSystem::TurnComponent>();
+	if (turnComponent.isMoving)
+	{
+		// Nothing a player can click ends a move, so a blocked one stays blocked as in the game
+		if (!clicks)
+			stopIfBlocked(activeEntity);
+		return;
+	}
+	blockedSteps = 0;
+
+	vec2 target;
+	if (!findClosestMob(activeEntity.get<Motion>().position, target))
+	{
+		return;
+	}
+
+	if (turnComponent.canStartMoving() && approach(activeEntity, target))
+	{
+		return;
+	}
+	if (!turnComponent.canStartSkill())
+	{
+		return;
+	}
+
+	SkillType skill = policy->chooseSkill(activeEntity, round);
+	if (!activeEntity.get<SkillComponent>().getSkill(skill))
+	{
+		skill = SkillType::SKILL1;
+	}
+
+	if (clicks)
+	{
+		clickSkill(skill, target);
+		return;
+	}
+
+	// Same as selecting the skill button, then clicking on the target (see TurnSystem::onMouseClick)
+	turnComponent.activeAction = skill;
+	EventSystem<SetActiveSkillEvent>::instance().sendEvent({ activeEntity, skill });
+	turnComponent.isUsingSkill = true;
+	EventSystem<PerformActiveSkillEvent>::instance().sendEvent({ activeEntity, target });
+}
+
+bool PlayerAutopilot::approach(ECS::Entity player, vec2 target)
+{
+	const vec2 offset = player.get<Motion>().position - target;
+	const float distance = length(offset);
+	if (distance <= APPROACH_DISTANCE)
+	{
+		return false;
+	}
+
+	// Same as the move button, then clicking next to the target
+	auto& turnComponent = player.get<TurnSystem::TurnComponent>();
+	const vec2 destination = target + offset / distance * APPROACH_DISTANCE;
+	if (clicks)
+	{
+		// No path leaves the move selected, until the skill button replaces it
+		clickSkill(SkillType::MOVE, destination);
+		return turnComponent.isMoving;
+	}
+	turnComponent.activeAction = SkillType::MOVE;
+	EventSystem<SetActiveSkillEvent>::instance().sendEvent({ player, SkillType::MOVE });
+	EventSystem<MouseClickEvent>::instance().sendEvent({ destination });
+
+	// No path, e.g. the spot is blocked, so use the skill from here
+	if (!turnComponent.isMoving)
+	{
+		turnComponent.activeAction = SkillType::NONE;
+		return false;
+	}
+	return true;
+}
+
+void PlayerAutopilot::clickSkill(SkillType skill, vec2 target)
+{
+	for (auto button : ECS::registry<SkillButton>().entities)
+	{
+		if (button.get<SkillInfoComponent>().skillType == skill)
+		{
+			click(button.get<ClickableCircleComponent>().position);
+			break;
+		}
+	}
+
+	// The map is clicked on the screen, see UISystem::onMouseClick
+	auto camera = ECS::registry<CameraComponent>().entities[0];
+	click(target - camera.get<CameraComponent>().position);
+}
+
+void PlayerAutopilot::click(vec2 mousePos)
+{
+	// Recorded as the game's window does, see WorldSystem::WorldSystem
+	auto& replay = InputReplay::instance();
+	replay.recordMouseClick(GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, 0, mousePos);
+	replay.recordMouseClick(GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, 0, mousePos);
+	if (!GameStateSystem::instance().isTransitioning)
+		EventSystem<RawMouseClickEvent>::instance().sendEvent({ mousePos });
+}
+
+void PlayerAutopilot::stopIfBlocked(ECS::Entity player)
+{
+	auto& motion = player.get<Motion>();
+	if (motion.position != lastPosition)
+	{
+		lastPosition = motion.position;
+		blockedSteps = 0;
+		return;
+	}
+	if (++blockedSteps < MAX_BLOCKED_STEPS)
+	{
+		return;
+	}
+
+	// Same as reaching the end of the path, see PhysicsSystem::step
+	motion.path = {};
+	motion.velocity = { 0.f, 0.f };
+	EventSystem<FinishedMovementEvent>::instance().sendEvent({ player });
+	blockedSteps = 0;
+}
+
+bool PlayerAutopilot::findClosestMob(vec2 position, vec2& target)
+{
+	bool found = false;
+	float closestDistance = FLOAT_MAX;
+	for (auto mob : ECS::registry<AISystem::MobComponent>().entities)
+	{
+		if (mob.has<DeathTimer>() || !mob.has<Motion>())
+		{
+			continue;
+		}
+
+		const vec2 mobPosition = mob.get<Motion>().position;
+		const float distance = length(mobPosition - position);
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			target = mobPosition;
+			found = true;
+		}
+	}
+	return found;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "player_policy.hpp"
+
+#include "game/common.hpp"
+#include "entities/tiny_ecs.hpp"
+
+#include <memory>
+
+// Takes the players' turns in the headless build, where nobody clicks: the active player walks
+// towards the closest mob, then uses the skill its policy chooses on that mob. Goes through the same
+// events as the UI, so the move and the skill are performed by the game systems and the turn ends
+// as it does in the game.
+//
+// With `clicks`, it plays through the mouse instead, clicking the skill buttons and the map like a player
+// would, and the InputReplay records the clicks, so a session recorded this way replays like one
+// recorded with `ambrosia --record`.
+class PlayerAutopilot
+{
+public:
+	explicit PlayerAutopilot(std::shared_ptr<PlayerPolicy> policy, bool clicks = false);
+
+	// `round` is passed on to the policy
+	void step(int round);
+
+private:
+	// Starts moving the player if it's too far from the target. Returns false if it didn't move.
+	bool approach(ECS::Entity player, vec2 target);
+	static bool findClosestMob(vec2 position, vec2& target);
+	// Clicks the button of the skill, then the given position on the map
+	static void clickSkill(SkillType skill, vec2 target);
+	static void click(vec2 mousePos);
+	// Ends the move of a player that hasn't moved for a while, e.g. because a mob spawned on its path
+	void stopIfBlocked(ECS::Entity player);
+
+	std::shared_ptr<PlayerPolicy> policy;
+	bool clicks;
+	vec2 lastPosition;
+	int blockedSteps;
+};
@@ -0,0 +1,90 @@
+#include "player_policy.hpp"
+
+#include "ai/ai.hpp"
+#include "game/common.hpp"
+#include "game/stats_component.hpp"
+#include "rendering/render_components.hpp"
+
+#include <stdexcept>
+
+std::shared_ptr<PlayerPolicy> PlayerPolicy::create(const std::string& name, unsigned int seed)
+{
+	if (name == "random")
+		return std::make_shared<RandomPolicy>(seed);
+	if (name == "strategic")
+		return std::make_shared<StrategicPolicy>(seed);
+	if (name == "super-strategic")
+		return std::make_shared<SuperStrategicPolicy>(seed);
+	throw std::runtime_error("unknown player policy " + name);
+}
+
+const std::vector<std::string>& PlayerPolicy::names()
+{
+	static const std::vector<std::string> policyNames = { "random", "strategic", "super-strategic" };
+	return policyNames;
+}
+
+SkillType PlayerPolicy::randomSkill(int first, int last)
+{
+	std::uniform_int_distribution<int> skill(first, last);
+	return static_cast<SkillType>(static_cast<int>(SkillType::SKILL1) + skill(random) - 1);
+}
+
+PlayerPolicy::BossState PlayerPolicy::findBoss()
+{
+	BossState boss;
+	for (auto mob : ECS::registry<AISystem::MobComponent>().entities)
+	{
+		if (mob.has<DeathTimer>() || !mob.has<StatsComponent>())
+			continue;
+
+		auto& stats = mob.get<StatsComponent>();
+		if (stats.getStatValue(StatType::MAX_NUM_ULT) > 0.f)
+		{
+			boss.found = true;
+			boss.hp = stats.getStatValue(StatType::HP);
+			boss.maxHp = stats.getStatValue(StatType::MAX_HP);
+			boss.ultsLeft = static_cast<int>(stats.getStatValue(StatType::NUM_ULT_LEFT));
+			break;
+		}
+	}
+	return boss;
+}
+
+SkillType RandomPolicy::chooseSkill(ECS::Entity, int)
+{
+	return randomSkill(1, 3);
+}
+
+bool StrategicPolicy::expectUltimate(const BossState& boss, int round)
+{
+	return boss.found && boss.ultsLeft > 0 && (round == 0 || boss.hp < boss.maxHp / 2.f);
+}
+
+SkillType StrategicPolicy::chooseSkill(ECS::Entity player, int round)
+{
+	const SkillType skill = randomSkill(1, 3);
+	if (player.get<PlayerComponent>().player == PlayerType::CHIA && expectUltimate(findBoss(), round))
+		return SkillType::SKILL3;
+	return skill;
+}
+
+SkillType SuperStrategicPolicy::chooseSkill(ECS::Entity player, int round)
+{
+	const BossState boss = findBoss();
+	const bool ultsLeft = boss.found && boss.ultsLeft > 0;
+
+	switch (player.get<PlayerComponent>().player)
+	{
+	case PlayerType::RAOUL:
+		// The buff also makes the heals stronger
+		return ultsLeft ? randomSkill(2, 3) : randomSkill(1, 3);
+	case PlayerType::TAJI:
+		return ultsLeft ? SkillType::SKILL3 : randomSkill(1, 3);
+	case PlayerType::EMBER:
+		return ultsLeft ? SkillType::SKILL1 : SkillType::SKILL2;
+	case PlayerType::CHIA:
+		return expectUltimate(boss, round) ? SkillType::SKILL3 : SkillType::SKILL1;
+	}
+	return SkillType::SKILL1;
+}
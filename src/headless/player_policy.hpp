@@ -0,0 +1,72 @@
+#pragma once
+
+#include "entities/tiny_ecs.hpp"
+#include "skills/skill_component.hpp"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Chooses which skill a player uses on its turn in a headless battle. The policies are the player
+// strategies of data/balancing/balancing.py, except that they play the real game: the skills are
+// performed by the SkillSystem and the boss is driven by its behaviour tree.
+class PlayerPolicy
+{
+public:
+	virtual ~PlayerPolicy() = default;
+
+	// `round` counts from 0, like the turns of balancing.py
+	virtual SkillType chooseSkill(ECS::Entity player, int round) = 0;
+
+	// "random", "strategic" or "super-strategic". Throws std::runtime_error for any other name.
+	static std::shared_ptr<PlayerPolicy> create(const std::string& name, unsigned int seed);
+	static const std::vector<std::string>& names();
+
+protected:
+	explicit PlayerPolicy(unsigned int seed) : random(seed) {}
+
+	// A uniformly chosen skill between SKILL<first> and SKILL<last>
+	SkillType randomSkill(int first, int last);
+
+	// The first live mob with ultimates, i.e. the boss
+	struct BossState
+	{
+		bool found = false;
+		float hp = 0.f;
+		float maxHp = 0.f;
+		int ultsLeft = 0;
+	};
+	static BossState findBoss();
+
+	std::default_random_engine random;
+};
+
+// Every player picks one of its three skills at random
+class RandomPolicy : public PlayerPolicy
+{
+public:
+	explicit RandomPolicy(unsigned int seed) : PlayerPolicy(seed) {}
+	SkillType chooseSkill(ECS::Entity player, int round) override;
+};
+
+// Random, except that Chia shields everyone before each of the boss's ultimates
+class StrategicPolicy : public PlayerPolicy
+{
+public:
+	explicit StrategicPolicy(unsigned int seed) : PlayerPolicy(seed) {}
+	SkillType chooseSkill(ECS::Entity player, int round) override;
+
+protected:
+	// Whether the boss is about to use an ultimate: on the first round, and once it's under half HP
+	static bool expectUltimate(const BossState& boss, int round);
+};
+
+// Shields before the ultimates, keeps the damage low and heals up until the boss has used all of
+// them, then goes all in
+class SuperStrategicPolicy : public StrategicPolicy
+{
+public:
+	explicit SuperStrategicPolicy(unsigned int seed) : StrategicPolicy(seed) {}
+	SkillType chooseSkill(ECS::Entity player, int round) override;
+};
@@ -0,0 +1,324 @@
+#include "job_system.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace
+{
+	// Index of the calling thread's own queue, 0 for threads outside the pool
+	thread_local size_t currentQueueIndex = 0;
+}
+
+JobSystem::JobSystem()
+	: running(true)
+	, numQueued(0)
+	, jobsExecuted(0)
+	, jobsStolen(0)
+	, maxQueueDepth(0)
+	, mainThreadJobsExecuted(0)
+	, jobBeginHook(nullptr)
+	, jobEndHook(nullptr)
+{
+	// Leave one core for the main thread
+	const size_t numThreads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+	const size_t numWorkerThreads = std::max<size_t>(1, numThreads);
+
+	for (size_t i = 0; i < numWorkerThreads + 1; i++)
+	{
+		queues.push_back(std::make_unique<JobQueue>());
+	}
+	for (size_t i = 0; i < numWorkerThreads; i++)
+	{
+		threads.emplace_back(&JobSystem::workerLoop, this, i + 1);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		running = false;
+	}
+	wakeUp.notify_all();
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+void JobSystem::submit(Job job, JobCounter* counter)
+{
+	if (counter)
+	{
+		counter->count++;
+		job = [this, counter, job]() {
+			job();
+			finish(counter);
+		};
+	}
+
+	auto& queue = *queues[currentQueueIndex];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({ std::move(job), &ECS::World::current() });
+	}
+
+	size_t depth;
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		depth = ++numQueued;
+	}
+	wakeUp.notify_one();
+
+	size_t maxDepth = maxQueueDepth;
+	while (depth > maxDepth && !maxQueueDepth.compare_exchange_weak(maxDepth, depth)) {}
+}
+
+void JobSystem::submitAfter(JobCounter& dependency, Job job, JobCounter* counter)
+{
+	{
+		std::lock_guard<std::mutex> lock(dependency.mutex);
+		if (dependency.count > 0)
+		{
+			// Count the job right away, so that waiting on `counter` also waits for the dependency
+			if (counter)
+			{
+				counter->count++;
+			}
+			dependency.continuations.push_back([this, job, counter]() {
+				submit(job, counter);
+				if (counter)
+				{
+					finish(counter);
+				}
+			});
+			return;
+		}
+	}
+	submit(std::move(job), counter);
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+	std::vector<Job> continuations;
+	{
+		std::lock_guard<std::mutex> lock(counter->mutex);
+		if (--counter->count == 0)
+		{
+			continuations.swap(counter->continuations);
+		}
+	}
+
+	for (auto& continuation : continuations)
+	{
+		continuation();
+	}
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	while (!counter.isDone())
+	{
+		if (!runPendingJob())
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// The last finish() may still hold the lock, and the caller is free to destroy the counter after this
+	std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+bool JobSystem::runPendingJob()
+{
+	QueuedJob job;
+	if (popOwn(currentQueueIndex, job))
+	{
+		execute(job);
+		return true;
+	}
+	if (steal(currentQueueIndex, job))
+	{
+		jobsStolen++;
+		execute(job);
+		return true;
+	}
+	return false;
+}
+
+void JobSystem::runOnMainThread(Job job)
+{
+	std::lock_guard<std::mutex> lock(mainThreadMutex);
+	mainThreadJobs.push_back(std::move(job));
+}
+
+void JobSystem::continueOnMainThread(JobCounter& dependency, Job job)
+{
+	submitAfter(dependency, [this, job]() { runOnMainThread(job); });
+}
+
+size_t JobSystem::runMainThreadJobs()
+{
+	std::vector<Job> jobs;
+	{
+		std::lock_guard<std::mutex> lock(mainThreadMutex);
+		jobs.swap(mainThreadJobs);
+	}
+
+	for (auto& job : jobs)
+	{
+		job();
+	}
+	mainThreadJobsExecuted += jobs.size();
+	return jobs.size();
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	grainSize = std::max<size_t>(1, grainSize);
+
+	JobCounter counter;
+	std::mutex errorMutex;
+	std::exception_ptr error;
+	auto runRange = [&body, &errorMutex, &error](size_t begin, size_t end) {
+		try
+		{
+			body(begin, end);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	};
+
+	// The calling thread takes the first range itself
+	for (size_t begin = grainSize; begin < count; begin += grainSize)
+	{
+		const size_t end = std::min(count, begin + grainSize);
+		submit([&runRange, begin, end]() { runRange(begin, end); }, &counter);
+	}
+	runRange(0, std::min(count, grainSize));
+	wait(counter);
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+JobSystem::Stats JobSystem::getStats() const
+{
+	Stats stats;
+	stats.jobsExecuted = jobsExecuted;
+	stats.jobsStolen = jobsStolen;
+	stats.queueDepth = static_cast<size_t>(std::max(0, numQueued.load()));
+	stats.maxQueueDepth = maxQueueDepth;
+	stats.mainThreadJobsExecuted = mainThreadJobsExecuted;
+	return stats;
+}
+
+void JobSystem::resetStats()
+{
+	jobsExecuted = 0;
+	jobsStolen = 0;
+	maxQueueDepth = 0;
+	mainThreadJobsExecuted = 0;
+}
+
+void JobSystem::printStats() const
+{
+	const Stats stats = getStats();
+	std::cout << "JobSystem: " << numWorkers() << " workers, " << stats.jobsExecuted << " jobs ("
+		<< stats.jobsStolen << " stolen, " << stats.mainThreadJobsExecuted << " on the main thread), queue depth "
+		<< stats.queueDepth << " (max " << stats.maxQueueDepth << ")" << std::endl;
+}
+
+void JobSystem::setJobHooks(void (*onJobBegin)(), void (*onJobEnd)())
+{
+	jobBeginHook = onJobBegin;
+	jobEndHook = onJobEnd;
+}
+
+void JobSystem::workerLoop(size_t queueIndex)
+{
+	currentQueueIndex = queueIndex;
+
+	while (true)
+	{
+		if (runPendingJob())
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeUp.wait(lock, [this]() { return numQueued > 0 || !running; });
+		if (!running)
+		{
+			return;
+		}
+	}
+}
+
+void JobSystem::execute(QueuedJob& job)
+{
+	ECS::World::Scope worldScope(*job.world);
+
+	auto onBegin = jobBeginHook.load();
+	if (onBegin)
+	{
+		onBegin();
+	}
+
+	job.job();
+	jobsExecuted++;
+
+	auto onEnd = jobEndHook.load();
+	if (onEnd)
+	{
+		onEnd();
+	}
+}
+
+bool JobSystem::popOwn(size_t queueIndex, QueuedJob& job)
+{
+	auto& queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.jobs.empty())
+	{
+		return false;
+	}
+
+	// Newest first, its data is most likely still in cache
+	job = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+	numQueued--;
+	return true;
+}
+
+bool JobSystem::steal(size_t thiefIndex, QueuedJob& job)
+{
+	for (size_t offset = 1; offset < queues.size(); offset++)
+	{
+		auto& queue = *queues[(thiefIndex + offset) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			// Oldest first, to take the largest chunk of remaining work
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			numQueued--;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include "entities/tiny_ecs.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tracks a group of jobs. It counts the jobs that haven't finished yet, and holds the jobs that
+// should only start once all of them are done (see JobSystem::submitAfter).
+class JobCounter
+{
+public:
+	JobCounter() : count(0) {}
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	inline bool isDone() const { return count == 0; }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<int> count;
+	std::mutex mutex;
+	std::vector<std::function<void()>> continuations;
+};
+
+// A fixed pool of worker threads. Every worker has its own deque of jobs: it pushes and pops
+// its own work at the back, and steals from the front of the other deques when it runs dry.
+// Jobs submitted from outside the pool (e.g. the main thread) go to a shared queue.
+//
+// Jobs run in the ECS::World that was current on the thread that submitted them.
+// Jobs must not throw, except inside parallelFor which hands the exception back to the caller.
+// GL calls have to go through runOnMainThread, which the main loop drains once per frame.
+class JobSystem
+{
+public:
+	using Job = std::function<void()>;
+
+	struct Stats
+	{
+		size_t jobsExecuted;
+		size_t jobsStolen;
+		size_t queueDepth;
+		size_t maxQueueDepth;
+		size_t mainThreadJobsExecuted;
+	};
+
+	// Returns the singleton instance, starting the workers on first use
+	static JobSystem& instance()
+	{
+		static JobSystem jobSystem;
+		return jobSystem;
+	}
+
+	~JobSystem();
+
+	// The counter, if any, is incremented now and decremented once the job has run
+	void submit(Job job, JobCounter* counter = nullptr);
+	// Submits the job once every job tracked by `dependency` has finished
+	void submitAfter(JobCounter& dependency, Job job, JobCounter* counter = nullptr);
+	// Runs other jobs on the calling thread until every job tracked by the counter has finished
+	void wait(JobCounter& counter);
+
+	// Runs one queued job on the calling thread, returns false if there was nothing to run.
+	// Threads waiting on jobs should call this instead of blocking.
+	bool runPendingJob();
+
+	// Queues a job for the main thread, e.g. to upload the results of a worker job to the GPU
+	void runOnMainThread(Job job);
+	void continueOnMainThread(JobCounter& dependency, Job job);
+	// Runs the queued main thread jobs, must be called from the main thread. Returns how many ran.
+	size_t runMainThreadJobs();
+
+	// Calls body(begin, end) for consecutive ranges of at most grainSize indices in [0, count),
+	// and returns once all of them are done. The calling thread takes part in the work.
+	void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+	// Calls function(entity, component) for every component in the container, in parallel. The function
+	// may modify the component, but must not add or remove components of any type.
+	template<class Component, class Function>
+	void parallelForEach(ECS::ComponentContainer<Component>& container, Function function, size_t grainSize = 64)
+	{
+		parallelFor(container.size(), grainSize, [&container, &function](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				function(container.entities[i], container.components[i]);
+			}
+		});
+	}
+
+	inline size_t numWorkers() const { return threads.size(); }
+
+	// Instrumentation. The hooks are called on the executing thread around every job, e.g. for a profiler.
+	Stats getStats() const;
+	void resetStats();
+	void printStats() const;
+	void setJobHooks(void (*onJobBegin)(), void (*onJobEnd)());
+
+private:
+	JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	struct QueuedJob
+	{
+		Job job;
+		ECS::World* world;
+	};
+
+	struct JobQueue
+	{
+		std::mutex mutex;
+		std::deque<QueuedJob> jobs;
+	};
+
+	void workerLoop(size_t queueIndex);
+	bool popOwn(size_t queueIndex, QueuedJob& job);
+	bool steal(size_t thiefIndex, QueuedJob& job);
+	void execute(QueuedJob& job);
+	void finish(JobCounter* counter);
+
+	// Queue 0 is shared by the threads outside the pool, queue i + 1 belongs to worker i
+	std::vector<std::unique_ptr<JobQueue>> queues;
+	std::vector<std::thread> threads;
+
+	std::atomic<bool> running;
+	std::atomic<int> numQueued;
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+
+	std::mutex mainThreadMutex;
+	std::vector<Job> mainThreadJobs;
+
+	std::atomic<size_t> jobsExecuted;
+	std::atomic<size_t> jobsStolen;
+	std::atomic<size_t> maxQueueDepth;
+	std::atomic<size_t> mainThreadJobsExecuted;
+	std::atomic<void(*)()> jobBeginHook;
+	std::atomic<void(*)()> jobEndHook;
+};
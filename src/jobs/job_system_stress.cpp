@@ -0,0 +1,229 @@
+// Stress test and benchmark for the JobSystem, built as the ambrosia_jobs_stress target.
+// Usage: ambrosia_jobs_stress [rounds]
+// Exits with a non-zero code if any of the checks fails.
+
+#include "job_system.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	int numFailures = 0;
+
+	void check(bool condition, const std::string& what)
+	{
+		if (!condition)
+		{
+			std::cout << "FAILED: " << what << std::endl;
+			numFailures++;
+		}
+	}
+
+	double elapsedMs(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	// Enough work per element that the parallel version has something to win
+	inline double work(size_t i)
+	{
+		double x = static_cast<double>(i);
+		for (int k = 0; k < 16; k++)
+		{
+			x = x * 0.5 + 1.0 / (x + 1.0);
+		}
+		return x;
+	}
+
+	void parallelForSum(JobSystem& jobs)
+	{
+		const size_t count = 4000000;
+		std::vector<double> serial(count);
+		std::vector<double> parallel(count);
+
+		auto start = Clock::now();
+		for (size_t i = 0; i < count; i++)
+		{
+			serial[i] = work(i);
+		}
+		const double serialMs = elapsedMs(start);
+
+		start = Clock::now();
+		jobs.parallelFor(count, 16384, [&parallel](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				parallel[i] = work(i);
+			}
+		});
+		const double parallelMs = elapsedMs(start);
+
+		check(serial == parallel, "parallelFor computes the same results as the serial loop");
+		std::cout << "  parallelFor:       serial " << serialMs << " ms, parallel " << parallelMs << " ms ("
+			<< serialMs / parallelMs << "x)" << std::endl;
+	}
+
+	void tinyJobs(JobSystem& jobs)
+	{
+		const int count = 200000;
+		std::atomic<int> numRun(0);
+		JobCounter counter;
+
+		auto start = Clock::now();
+		for (int i = 0; i < count; i++)
+		{
+			jobs.submit([&numRun]() { numRun++; }, &counter);
+		}
+		jobs.wait(counter);
+		const double ms = elapsedMs(start);
+
+		check(numRun == count, "every tiny job runs exactly once");
+		std::cout << "  tiny jobs:         " << count << " in " << ms << " ms (" << ms * 1e6 / count << " ns/job)" << std::endl;
+	}
+
+	void dependencyChain(JobSystem& jobs)
+	{
+		const int length = 2000;
+		std::vector<std::unique_ptr<JobCounter>> counters;
+		std::atomic<int> next(0);
+		std::atomic<bool> inOrder(true);
+
+		auto start = Clock::now();
+		for (int i = 0; i < length; i++)
+		{
+			counters.push_back(std::make_unique<JobCounter>());
+			auto job = [&next, &inOrder, i]() {
+				if (next.exchange(i + 1) != i)
+				{
+					inOrder = false;
+				}
+			};
+
+			if (i == 0)
+			{
+				jobs.submit(job, counters.back().get());
+			}
+			else
+			{
+				jobs.submitAfter(*counters[i - 1], job, counters.back().get());
+			}
+		}
+		jobs.wait(*counters.back());
+		const double ms = elapsedMs(start);
+
+		check(inOrder && next == length, "chained jobs run in dependency order");
+		std::cout << "  dependency chain:  " << length << " jobs in " << ms << " ms" << std::endl;
+	}
+
+	struct Particle
+	{
+		float position;
+		float velocity;
+	};
+
+	void ecsParallelForEach(JobSystem& jobs)
+	{
+		const int count = 100000;
+		std::vector<ECS::Entity> entities(count);
+		for (int i = 0; i < count; i++)
+		{
+			entities[i].emplace<Particle>(Particle{ 0.f, static_cast<float>(i) });
+		}
+
+		auto start = Clock::now();
+		for (int step = 0; step < 10; step++)
+		{
+			jobs.parallelForEach(ECS::registry<Particle>(), [](ECS::Entity, Particle& particle) {
+				particle.position += particle.velocity;
+			}, 1024);
+		}
+		const double ms = elapsedMs(start);
+
+		bool correct = true;
+		for (int i = 0; i < count; i++)
+		{
+			correct = correct && entities[i].get<Particle>().position == 10.f * i;
+		}
+		check(correct, "parallelForEach updates every component");
+		std::cout << "  parallelForEach:   10 x " << count << " components in " << ms << " ms" << std::endl;
+
+		ECS::ContainerInterface::removeAllComponentsOf(entities);
+	}
+
+	void mainThreadContinuation(JobSystem& jobs)
+	{
+		const auto mainThread = std::this_thread::get_id();
+		JobCounter counter;
+		std::atomic<bool> ranOnWorker(false);
+		bool ranOnMain = false;
+
+		jobs.submit([&ranOnWorker]() { ranOnWorker = true; }, &counter);
+		jobs.continueOnMainThread(counter, [&ranOnMain, mainThread]() {
+			ranOnMain = std::this_thread::get_id() == mainThread;
+		});
+
+		jobs.wait(counter);
+		// The continuation is submitted as a job of its own once the counter reaches zero
+		while (jobs.runMainThreadJobs() == 0)
+		{
+			jobs.runPendingJob();
+		}
+		check(ranOnWorker && ranOnMain, "continuations run on the main thread after their dependency");
+	}
+
+	void exceptions(JobSystem& jobs)
+	{
+		bool caught = false;
+		try
+		{
+			jobs.parallelFor(1000, 10, [](size_t begin, size_t) {
+				if (begin == 500)
+				{
+					throw std::runtime_error("expected");
+				}
+			});
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+		check(caught, "parallelFor rethrows exceptions on the caller");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const int rounds = argc > 1 ? std::max(1, std::stoi(argv[1])) : 3;
+
+	auto& jobs = JobSystem::instance();
+	std::cout << "JobSystem stress test: " << jobs.numWorkers() << " workers, " << rounds << " rounds" << std::endl;
+
+	for (int round = 0; round < rounds; round++)
+	{
+		std::cout << "round " << round + 1 << std::endl;
+		jobs.resetStats();
+		parallelForSum(jobs);
+		tinyJobs(jobs);
+		dependencyChain(jobs);
+		ecsParallelForEach(jobs);
+		mainThreadContinuation(jobs);
+		exceptions(jobs);
+		jobs.printStats();
+	}
+
+	if (numFailures > 0)
+	{
+		std::cout << numFailures << " checks failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "all checks passed" << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -4,6 +4,13 @@
 #include <iomanip>
 #include <fstream>
 #include <sys/stat.h> 
+#include <cstdio>
+#include <iterator>
+
+namespace
+{
+	const std::string battleSavePath = "data/battle-save.bin";
+}
 
 bool is_file_exist(const std::string& name)
 {
@@ -57,3 +64,23 @@ json LevelLoader::load() {
 	return save_obj;
 }
 
+void LevelLoader::saveBattle(const std::vector<uint8_t>& data) {
+	std::ofstream file(battleSavePath, std::ios::binary);
+	if (!file) {
+		std::cout << "LevelLoader::saveBattle: can't write " << battleSavePath << std::endl;
+		return;
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+std::vector<uint8_t> LevelLoader::loadBattle() {
+	std::ifstream file(battleSavePath, std::ios::binary);
+	if (!file) {
+		return {};
+	}
+	return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void LevelLoader::removeBattle() {
+	std::remove(battleSavePath.c_str());
+}
@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "achievement_system.hpp"
 #include "../ext/nlohmann/json.hpp"
 using json = nlohmann::json;
@@ -15,4 +17,9 @@ class LevelLoader
 
 		// load save
 		json load();
+
+		// The battle in progress when the game was left, next to the save. Empty if there's none.
+		void saveBattle(const std::vector<uint8_t>& data);
+		std::vector<uint8_t> loadBattle();
+		void removeBattle();
 };
\ No newline at end of file
@@ -4,13 +4,17 @@
 
 // stlib
 #include <chrono>
+#include <cstdlib>
+#include <random>
 
 // internal
 #include "game/camera_system.hpp"
+#include "game/camera.hpp"
 #include "game/common.hpp"
 #include "game/world.hpp"
 #include "game/turn_system.hpp"
 #include "entities/tiny_ecs.hpp"
+#include "entities/command_buffer.hpp"
 #include "rendering/render.hpp"
 #include "physics/physics.hpp"
 #include "physics/debug.hpp"
@@ -29,6 +33,13 @@
 #include "effects/effect_system.hpp"
 #include "game/range_indicator_system.hpp"
 #include "game/achievement_system.hpp"
+#include "game/system_scheduler.hpp"
+#include "game/event_system.hpp"
+#include "jobs/job_system.hpp"
+#include "memory/allocation_counter.hpp"
+#include "memory/frame_arena.hpp"
+#include "profiling/profiler.hpp"
+#include "replay/input_replay.hpp"
 #include "ui/shop_system.hpp"
 
 
@@ -45,8 +56,29 @@ struct Description {
 };
 
 // Entry point
-int main()
+// Usage: ambrosia [--record <file> [recipe] [map index] | --replay <file>]
+// --record starts on the given map (recipe-1 map 0 by default) and writes the session's seed and input
+// to the file on exit, --replay plays such a session again at the fixed timestep and exits at its end.
+int main(int argc, char* argv[])
 {
+	const std::string mode = argc > 2 ? argv[1] : "";
+	if (mode == "--record")
+	{
+		InputReplay::instance().startRecording(argv[2], argc > 3 ? argv[3] : "recipe-1", argc > 4 ? std::stoi(argv[4]) : 0,
+			std::random_device()());
+	}
+	else if (mode == "--replay")
+	{
+		InputReplay::instance().startReplay(argv[2]);
+	}
+	auto& replay = InputReplay::instance();
+
+	// Samples of the last minute or so, F3 writes them out. With AMBROSIA_TRACE set to a path, they're
+	// also written there on exit.
+	Profiler::instance().setEnabled(true);
+	Profiler::instance().setThreadName("main");
+	JobSystem::instance().setJobHooks(&Profiler::onJobBegin, &Profiler::onJobEnd);
+
 	// Initialize the main systems 
 	WorldSystem world(window_size_in_px);
 	ParticleSystem particleSystem;
@@ -69,57 +101,131 @@ int main()
 	SwarmBehaviour swarmBehaviour;
 	AchievementSystem::instance();
 
-	GameStateSystem::instance().setWindow(world.window);
+	int frameBufferWidth, frameBufferHeight;
+	glfwGetFramebufferSize(world.window, &frameBufferWidth, &frameBufferHeight);
+	GameStateSystem::instance().setFrameBufferSize({ frameBufferWidth, frameBufferHeight });
 	GameStateSystem::instance().preloadResources();
-	GameStateSystem::instance().launchMainMenu();
+	if (replay.getMode() == InputReplay::Mode::OFF)
+	{
+		GameStateSystem::instance().launchMainMenu();
+	}
+	else
+	{
+		// Sessions leave the save file alone
+		GameStateSystem::instance().isSavingEnabled = false;
+		GameStateSystem::instance().loadRecipe(replay.getRecipe(), "", replay.getMapIndex());
+	}
 
 	// Reference: https://gafferongames.com/post/fix_your_timestep/#the-final-touch
 	float t = 0.f;
 	float dt = 16.67f; // milliseconds
 
+	// The systems of one fixed update step. Conflicting systems run in the order they're added here,
+	// the others (e.g. particles alongside animations) may run concurrently.
+	SystemScheduler scheduler;
+	scheduler.add("world", [&]() { world.step(dt, window_size_in_game_units); }, SystemAccess().exclusive());
+	scheduler.add("camera", [&]() { camera.step(dt); },
+		SystemAccess().writes<CameraComponent, CameraDelayedMoveComponent>().structural());
+	scheduler.add("physics", [&]() { physics.step(dt, window_size_in_game_units); }, SystemAccess().exclusive());
+	scheduler.add("swarm", [&]() { swarmBehaviour.step(dt, window_size_in_game_units); },
+		SystemAccess().reads<ActivePotatoChunks, Motion>().writes<StatsComponent, DeathTimer>().structural());
+	scheduler.add("collisions", [&]() { world.handleCollisions(); }, SystemAccess().exclusive());
+	scheduler.add("projectiles", [&]() { projectileSystem.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("skills", [&]() { skillSystem.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("particles", [&]() { particleSystem.step(dt); }, SystemAccess());
+	scheduler.add("animations", [&]() { animations.step(); },
+		SystemAccess().reads<SkillComponent>().writes<AnimationsComponent, Motion>().mainThread());
+	scheduler.add("effects", [&]() { effectSystem.step(); },
+		SystemAccess().reads<SkillFXData, AnimationsComponent>().writes<Motion>().structural());
+	scheduler.add("ui", [&]() { ui.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("turns", [&]() { turnSystem.step(dt); }, SystemAccess().exclusive());
+	scheduler.add("state", [&]() { stateSystem.step(dt); }, SystemAccess().exclusive());
+	scheduler.printGraph();
+
 	auto prevTime = Clock::now();
 	float accumulator = 0.0;
 
 	// Variable timestep loop
-	while (!world.isOver())
+	const auto replayStart = Clock::now();
+	while (!world.isOver() && !replay.isFinished())
 	{
+		AllocationCounter::beginFrame();
+		PROFILE_SCOPE("frame");
+
 		// Calculate elapsed time in milliseconds from the previous iteration
 		auto currTime = Clock::now();
 		float frameTime = static_cast<float>((std::chrono::duration_cast<std::chrono::microseconds>(currTime - prevTime)).count()) / 1000.f;
 		prevTime = currTime;
 
+		// A replay takes exactly one update step per frame, however long the frames take
+		if (replay.isReplaying())
+			frameTime = dt;
+
 		accumulator += frameTime;
 		while (accumulator >= dt)
 		{
 			// Processes system messages, if this wasn't present the window would become unresponsive
 			glfwPollEvents();
+			if (replay.isReplaying())
+				world.replayInput();
 
 			DebugSystem::clearDebugComponents();
-			world.step(dt, window_size_in_game_units);
-			camera.step(dt);
-			physics.step(dt, window_size_in_game_units);
-			swarmBehaviour.step(dt, window_size_in_game_units);
-			world.handleCollisions();
-			projectileSystem.step(dt);
-			skillSystem.step(dt);
-			animations.step();
-			effectSystem.step();
-			ui.step(dt);
-			turnSystem.step(dt);
-			stateSystem.step(dt);
-			particleSystem.step(dt);
+			scheduler.run();
+
+			// Events the systems queued while stepping, e.g. FinishedMovementEvent from physics
+			{
+				PROFILE_SCOPE("dispatch events");
+				EventQueues::dispatchAll();
+			}
+
+			// Sync point, apply the structural changes the systems deferred while iterating
+			{
+				PROFILE_SCOPE("command buffer");
+				ECS::CommandBuffer::instance().playback();
+			}
 
 			t += dt;
 			accumulator -= dt;
+			replay.endStep();
+
+		}
 
+		// Finish work that worker jobs handed back to the main thread, e.g. GL uploads
+		{
+			PROFILE_SCOPE("main thread jobs");
+			JobSystem::instance().runMainThreadJobs();
 		}
 
 		// Blend physics data between previous and current state
 		float alpha = accumulator / dt;
 		physics.blendMotionData(alpha);
 
-		renderer.draw(window_size_in_game_units);
+		{
+			PROFILE_SCOPE("draw");
+			renderer.draw(window_size_in_game_units);
+		}
+
+		// Everything allocated on the FrameArena during this iteration is released here
+		AllocationCounter::endFrame();
+		FrameArena::endFrame();
 	}
 
+	// Quitting in the middle of a battle, the next continue resumes it
+	GameStateSystem::instance().saveBattle();
+
+	if (replay.isRecording())
+	{
+		replay.save();
+	}
+	else if (replay.isReplaying())
+	{
+		const double seconds = std::chrono::duration<double>(Clock::now() - replayStart).count();
+		std::cout << "Replayed " << replay.getStep() << " of " << replay.getLength() << " steps in " << seconds << " s, "
+			<< replay.getStep() / seconds << " frames/s" << std::endl;
+	}
+
+	if (const char* tracePath = std::getenv("AMBROSIA_TRACE"))
+		Profiler::instance().writeChromeTrace(tracePath);
+
 	return EXIT_SUCCESS;
 }
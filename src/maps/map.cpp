@@ -12,7 +12,7 @@ void getPixel(stbi_uc* image, size_t imageWidth, size_t x, size_t y, stbi_uc* r,
 
 ECS::Entity MapComponent::createMap(const std::string& name, vec2 screenSize)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	std::string navmeshPath = mapsPath(name + "/" + name + "-navmesh" + ".png");
 	std::string debugPath = mapsPath(name + "/" + name + "-debug" + ".png");
@@ -20,7 +20,7 @@ ECS::Entity MapComponent::createMap(const std::string& name, vec2 screenSize)
 
 	// Create rendering primitives
 	ShadedMesh& resource = cacheResource(name);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 		RenderSystem::createSprite(resource, mapPath, "textured");
 	entity.emplace<ShadedMeshRef>(resource);
 	entity.emplace<RenderableComponent>(RenderLayer::MAP);
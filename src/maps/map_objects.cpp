@@ -2,10 +2,10 @@
 
 ECS::Entity CheeseBlob::createCheeseBlob(vec2 position)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource("cheeseblob_static");
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, objectsPath("cheese-texture.png"), "distendable");
 	}
@@ -21,14 +21,14 @@ ECS::Entity CheeseBlob::createCheeseBlob(vec2 position)
 ECS::Entity DessertForeground::createDessertForeground(vec2 position)
 {
 	// There should only ever be one of this type of entity
-	while (!ECS::registry<DessertForeground>.entities.empty()) {
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<DessertForeground>.entities.back());
+	while (!ECS::registry<DessertForeground>().entities.empty()) {
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<DessertForeground>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource("dessertmap_foreground");
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, mapsPath("dessert-arena/dessert-arena-front.png"), "textured");
 	}
@@ -44,14 +44,14 @@ ECS::Entity DessertForeground::createDessertForeground(vec2 position)
 ECS::Entity DessertBackground::createDessertBackground(vec2 position)
 {
 	// There should only ever be one of this type of entity
-	while (!ECS::registry<DessertBackground>.entities.empty()) {
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<DessertBackground>.entities.back());
+	while (!ECS::registry<DessertBackground>().entities.empty()) {
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<DessertBackground>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource("dessertmap_background");
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, mapsPath("dessert-arena/dessert-arena-back.png"), "textured");
 	}
@@ -67,13 +67,13 @@ ECS::Entity DessertBackground::createDessertBackground(vec2 position)
 ECS::Entity BBQBackground::createBBQBackground(vec2 position)
 {
 	// There should only ever be one of this type of entity
-	while (!ECS::registry<BBQBackground>.entities.empty()) {
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<BBQBackground>.entities.back());
+	while (!ECS::registry<BBQBackground>().entities.empty()) {
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<BBQBackground>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 	ShadedMesh& resource = cacheResource("bbq_background");
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, mapsPath("bbq/bbq-back.png"), "textured");
 	}
@@ -88,9 +88,9 @@ ECS::Entity BBQBackground::createBBQBackground(vec2 position)
 
 ECS::Entity BBQFire::createBBQFire(vec2 position, RenderLayer layer, vec2 scale)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 	ShadedMesh& resource = cacheResource("bbq_fire");
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, mapsPath("bbq/fire.png"), "fire");
 	}
@@ -1,6 +1,7 @@
 #include "path_finding_system.hpp"
 #include "ai/ai.hpp"
 
+#include <climits>
 #include <queue>
 
 std::stack<vec2> PathFindingSystem::getShortestPath(ECS::Entity sourceEntity, vec2 destination)
@@ -9,10 +10,10 @@ std::stack<vec2> PathFindingSystem::getShortestPath(ECS::Entity sourceEntity, ve
 	std::stack<vec2> shortestPath;
 
 	// It would be a bug if we don't have exactly one map loaded
-	assert(ECS::registry<MapComponent>.components.size() == 1);
+	assert(ECS::registry<MapComponent>().components.size() == 1);
 
 	// It would be a bug if the current map has an empty grid
-	assert(!ECS::registry<MapComponent>.components.front().grid.empty());
+	assert(!ECS::registry<MapComponent>().components.front().grid.empty());
 
 	assert(sourceEntity.has<Motion>());
 	vec2 source = sourceEntity.get<Motion>().position;
@@ -131,8 +132,8 @@ std::stack<vec2> PathFindingSystem::getShortestPath(ECS::Entity sourceEntity, ve
 }
 bool PathFindingSystem::isWalkablePoint(vec2 point)
 {
-	assert(ECS::registry<MapComponent>.components.size() == 1);
-	assert(!ECS::registry<MapComponent>.components.front().grid.empty());
+	assert(ECS::registry<MapComponent>().components.size() == 1);
+	assert(!ECS::registry<MapComponent>().components.front().grid.empty());
 
 	// Populate the list of obstacles
 	setCurrentObstacles();
@@ -145,8 +146,8 @@ bool PathFindingSystem::isWalkablePoint(vec2 point)
 
 bool PathFindingSystem::isWalkablePoint(ECS::Entity entity, vec2 point)
 {
-	assert(ECS::registry<MapComponent>.components.size() == 1);
-	assert(!ECS::registry<MapComponent>.components.front().grid.empty());
+	assert(ECS::registry<MapComponent>().components.size() == 1);
+	assert(!ECS::registry<MapComponent>().components.front().grid.empty());
 
 	// Populate the list of obstacles
 	setCurrentObstacles(entity);
@@ -235,7 +236,7 @@ void PathFindingSystem::setCurrentObstacles()
 {
 	obstacles.clear();
 
-	for (auto entity : ECS::registry<Motion>.entities)
+	for (auto entity : ECS::registry<Motion>().entities)
 	{
 		if (entity.has<PlayerComponent>() || entity.has<AISystem::MobComponent>())
 		{
@@ -33,7 +33,7 @@ private:
 
 	// Returns a reference to the current map. This function should only be called after the
 	// getShortestPath function has checked that a valid map exists
-	inline const MapComponent& getMap() const {return ECS::registry<MapComponent>.components.front();}
+	inline const MapComponent& getMap() const {return ECS::registry<MapComponent>().components.front();}
 
 	// Takes a world position and converts it to the position of a tile in the grid
 	inline vec2 getGridPosition(vec2 worldPosition) const {return round(worldPosition / getMap().tileSize);}
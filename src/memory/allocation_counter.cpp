@@ -0,0 +1,152 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+	// The counts of one thread, only ever written by that thread, so that counting an allocation doesn't
+	// contend with the other threads. They're on a cache line of their own and summed when read.
+	struct ThreadCounters
+	{
+		std::atomic<size_t> allocations;
+		std::atomic<size_t> bytes;
+		ThreadCounters* next;
+	};
+	const size_t CACHE_LINE = 64;
+
+	// Every thread that ever allocated, newest first. The counters outlive their thread, so that its
+	// allocations are still part of the totals.
+	std::atomic<ThreadCounters*> allThreads(nullptr);
+	thread_local ThreadCounters* threadCounters = nullptr;
+
+	size_t frameStartTotal = 0;
+	size_t frameStartThread = 0;
+	size_t lastFrameTotal = 0;
+	size_t lastFrameThread = 0;
+	size_t cleanFrames = 0;
+
+	ThreadCounters& countersOfThisThread()
+	{
+		if (threadCounters == nullptr)
+		{
+			// With malloc, since operator new would count this allocation
+			void* memory = std::malloc(sizeof(ThreadCounters) + CACHE_LINE - 1);
+			if (memory == nullptr)
+				throw std::bad_alloc();
+			const auto address = (reinterpret_cast<uintptr_t>(memory) + CACHE_LINE - 1) & ~(CACHE_LINE - 1);
+			auto counters = new (reinterpret_cast<void*>(address)) ThreadCounters();
+			counters->allocations.store(0, std::memory_order_relaxed);
+			counters->bytes.store(0, std::memory_order_relaxed);
+			counters->next = allThreads.load(std::memory_order_relaxed);
+			while (!allThreads.compare_exchange_weak(counters->next, counters, std::memory_order_release,
+				std::memory_order_relaxed))
+			{
+			}
+			threadCounters = counters;
+		}
+		return *threadCounters;
+	}
+
+	void* countedAllocate(size_t bytes)
+	{
+		// Only this thread writes them, a plain load and store is enough
+		auto& counters = countersOfThisThread();
+		counters.allocations.store(counters.allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		counters.bytes.store(counters.bytes.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+
+		void* ptr = std::malloc(bytes == 0 ? 1 : bytes);
+		if (ptr == nullptr)
+			throw std::bad_alloc();
+		return ptr;
+	}
+
+	template<class Counter>
+	size_t sumOverThreads(Counter counter)
+	{
+		size_t sum = 0;
+		for (auto counters = allThreads.load(std::memory_order_acquire); counters != nullptr; counters = counters->next)
+		{
+			sum += (counters->*counter).load(std::memory_order_relaxed);
+		}
+		return sum;
+	}
+}
+
+// Replacements of the global allocation functions, the array and nothrow forms included
+void* operator new(size_t bytes) { return countedAllocate(bytes); }
+void* operator new[](size_t bytes) { return countedAllocate(bytes); }
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept
+{
+	try
+	{
+		return countedAllocate(bytes);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t bytes, const std::nothrow_t& tag) noexcept { return operator new(bytes, tag); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+size_t AllocationCounter::numAllocations()
+{
+	return sumOverThreads(&ThreadCounters::allocations);
+}
+
+size_t AllocationCounter::numThreadAllocations()
+{
+	return countersOfThisThread().allocations.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::bytesAllocated()
+{
+	return sumOverThreads(&ThreadCounters::bytes);
+}
+
+void AllocationCounter::beginFrame()
+{
+	frameStartTotal = numAllocations();
+	frameStartThread = numThreadAllocations();
+}
+
+void AllocationCounter::endFrame()
+{
+	lastFrameTotal = numAllocations() - frameStartTotal;
+	lastFrameThread = numThreadAllocations() - frameStartThread;
+	cleanFrames = lastFrameThread == 0 ? cleanFrames + 1 : 0;
+}
+
+size_t AllocationCounter::lastFrameMainThreadAllocations()
+{
+	return lastFrameThread;
+}
+
+size_t AllocationCounter::lastFrameAllocations()
+{
+	return lastFrameTotal;
+}
+
+size_t AllocationCounter::allocationFreeFrames()
+{
+	return cleanFrames;
+}
+
+void AllocationCounter::printStats()
+{
+	std::cout << "Heap allocations: " << numAllocations() << " (" << bytesAllocated() / 1024 << " KB) in total, last frame "
+		<< lastFrameMainThreadAllocations() << " on the main thread and " << lastFrameAllocations() << " in total, "
+		<< allocationFreeFrames() << " allocation-free frames in a row" << std::endl;
+}
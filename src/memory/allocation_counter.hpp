@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+// Counts the calls to the global operator new, which allocation_counter.cpp replaces. Used to check
+// that a steady-state frame doesn't touch the heap. Every thread counts its own allocations, the
+// totals add them up when they're read.
+class AllocationCounter
+{
+public:
+	// Allocations made so far by all threads, and by the calling thread only
+	static size_t numAllocations();
+	static size_t numThreadAllocations();
+	static size_t bytesAllocated();
+
+	// Frame bookkeeping, called by the main loop around every iteration
+	static void beginFrame();
+	static void endFrame();
+
+	// Heap allocations of the last frame, on the main thread and in total
+	static size_t lastFrameMainThreadAllocations();
+	static size_t lastFrameAllocations();
+	// Consecutive frames, up to the last one, during which the main thread didn't allocate
+	static size_t allocationFreeFrames();
+
+	static void printStats();
+};
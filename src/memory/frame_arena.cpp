@@ -0,0 +1,25 @@
+#include "frame_arena.hpp"
+
+#include <iostream>
+
+namespace
+{
+	thread_local size_t lastFrameBytes = 0;
+	thread_local size_t lastFrameOverflows = 0;
+}
+
+void FrameArena::endFrame()
+{
+	auto& arena = instance();
+	lastFrameBytes = arena.bytesUsed();
+	lastFrameOverflows = arena.numOverflows();
+	arena.reset();
+}
+
+void FrameArena::printStats()
+{
+	const auto& arena = instance();
+	std::cout << "FrameArena: last frame used " << lastFrameBytes / 1024.f << " KB of " << arena.capacity() / 1024
+		<< " KB (" << lastFrameOverflows << " overflows), high-water mark " << arena.highWaterMark() / 1024.f
+		<< " KB, grown " << arena.numGrowths() << " times" << std::endl;
+}
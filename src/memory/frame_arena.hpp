@@ -0,0 +1,67 @@
+#pragma once
+#include "linear_arena.hpp"
+
+#include <sstream>
+
+// The arena for data that only lives until the end of the current frame, e.g. scratch lists built
+// while iterating over a registry. The main loop resets it at the end of every iteration.
+//
+// Every thread has its own arena, reset by the loop running on that thread: the main loop, or a
+// battle simulated on another thread. JobSystem workers must not allocate from it, since nothing
+// resets theirs, so only the exclusive and main thread systems of the SystemScheduler may use it.
+class FrameArena
+{
+public:
+	static LinearArena& instance()
+	{
+		thread_local LinearArena arena(64 * 1024);
+		return arena;
+	}
+
+	// Resets the calling thread's arena, keeping the usage of the frame that ended for printStats()
+	static void endFrame();
+	static void printStats();
+};
+
+// Allocator for containers on the FrameArena. It is stateless, unlike ArenaAllocator, so that it can
+// be default constructed, e.g. by the standard streams.
+template<class T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	template<class U>
+	struct rebind
+	{
+		using other = FrameAllocator<U>;
+	};
+
+	FrameAllocator() noexcept = default;
+
+	template<class U>
+	FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+	T* allocate(size_t n)
+	{
+		if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_alloc();
+		return static_cast<T*>(FrameArena::instance().allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		FrameArena::instance().deallocate(ptr, n * sizeof(T));
+	}
+
+	template<class U>
+	bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+	template<class U>
+	bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+template<class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+using FrameU32String = std::basic_string<char32_t, std::char_traits<char32_t>, FrameAllocator<char32_t>>;
+using FrameStringStream = std::basic_ostringstream<char, std::char_traits<char>, FrameAllocator<char>>;
@@ -0,0 +1,50 @@
+#include "level_arena.hpp"
+#include "entities/tiny_ecs.hpp"
+
+#include <iostream>
+
+namespace
+{
+	// The World resource, which only holds a reference since the allocators share the arena
+	struct WorldLevelArena
+	{
+		std::shared_ptr<LevelArena> arena = std::make_shared<LevelArena>();
+	};
+}
+
+LevelArena::LevelArena()
+	: arena(256 * 1024)
+{
+}
+
+std::shared_ptr<LevelArena> LevelArena::current()
+{
+	return ECS::World::current().resource<WorldLevelArena>().arena;
+}
+
+bool LevelArena::release()
+{
+	const auto levelArena = current();
+	std::lock_guard<std::mutex> lock(levelArena->mutex);
+	auto& arena = levelArena->arena;
+
+	if (arena.numLiveAllocations() > 0)
+	{
+		std::cout << "LevelArena::release: " << arena.numLiveAllocations()
+			<< " allocations outlived the level, keeping the arena" << std::endl;
+		return false;
+	}
+
+	arena.reset();
+	return true;
+}
+
+void LevelArena::printStats()
+{
+	const auto levelArena = current();
+	std::lock_guard<std::mutex> lock(levelArena->mutex);
+	const auto& arena = levelArena->arena;
+	std::cout << "LevelArena: " << arena.bytesUsed() / 1024.f << " KB used of " << arena.capacity() / 1024
+		<< " KB in " << arena.numLiveAllocations() << " live allocations, high-water mark "
+		<< arena.highWaterMark() / 1024.f << " KB, grown " << arena.numGrowths() << " times" << std::endl;
+}
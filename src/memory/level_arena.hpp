@@ -0,0 +1,96 @@
+#pragma once
+#include "linear_arena.hpp"
+
+#include <memory>
+#include <mutex>
+
+// The arena for data owned by the entities of the current level: the mobs' animations and skills,
+// and the FX of the map. GameStateSystem::removeNonPlayerEntities releases all of it at once after
+// tearing the level down. The players and the menus keep using the regular heap, which is what makes
+// them outlive the level.
+//
+// Every ECS::World has an arena of its own, so that battles simulated side by side neither share
+// their memory nor wait on each other's lock. Anything still allocated here when the level ends
+// (e.g. a skill queued in the SkillSystem) keeps the world's arena from being released, until a
+// later level exit finds it empty. Allocations are locked, since structural systems may create
+// entities on worker threads.
+class LevelArena
+{
+public:
+	LevelArena();
+	LevelArena(const LevelArena&) = delete;
+	LevelArena& operator=(const LevelArena&) = delete;
+
+	// The arena of the current World. The allocators share it, so that it outlives its World until the
+	// last object allocated from it is destroyed, e.g. by a component destroyed with the World.
+	static std::shared_ptr<LevelArena> current();
+
+	// Resets the arena of the current World if nothing allocated during the level is still alive,
+	// returns whether it did
+	static bool release();
+	static void printStats();
+
+private:
+	template<class T>
+	friend class LevelAllocator;
+
+	LinearArena arena;
+	std::mutex mutex;
+};
+
+// Allocator for a LevelArena, the current World's unless it's given another one
+template<class T>
+class LevelAllocator
+{
+public:
+	using value_type = T;
+
+	template<class U>
+	struct rebind
+	{
+		using other = LevelAllocator<U>;
+	};
+
+	LevelAllocator() : arena(LevelArena::current()) {}
+	explicit LevelAllocator(std::shared_ptr<LevelArena> arena) noexcept : arena(std::move(arena)) {}
+
+	template<class U>
+	LevelAllocator(const LevelAllocator<U>& other) noexcept : arena(other.arena) {}
+
+	T* allocate(size_t n)
+	{
+		if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_alloc();
+		std::lock_guard<std::mutex> lock(arena->mutex);
+		return static_cast<T*>(arena->arena.allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		std::lock_guard<std::mutex> lock(arena->mutex);
+		arena->arena.deallocate(ptr, n * sizeof(T));
+	}
+
+	template<class U>
+	bool operator==(const LevelAllocator<U>& other) const noexcept { return arena == other.arena; }
+	template<class U>
+	bool operator!=(const LevelAllocator<U>& other) const noexcept { return arena != other.arena; }
+
+private:
+	template<class U>
+	friend class LevelAllocator;
+
+	std::shared_ptr<LevelArena> arena;
+};
+
+template<class T>
+using LevelVector = std::vector<T, LevelAllocator<T>>;
+using LevelString = std::basic_string<char, std::char_traits<char>, LevelAllocator<char>>;
+
+// std::make_shared for level-scoped objects. The object and its control block both live in the arena
+// of the current World.
+template<class T, class... Args>
+std::shared_ptr<T> makeLevelShared(Args&&... args)
+{
+	return std::allocate_shared<T>(LevelAllocator<T>(), std::forward<Args>(args)...);
+}
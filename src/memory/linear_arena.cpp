@@ -0,0 +1,113 @@
+#include "linear_arena.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	inline size_t alignUp(size_t offset, size_t alignment)
+	{
+		return (offset + alignment - 1) & ~(alignment - 1);
+	}
+
+	// Through operator new rather than malloc, so that the AllocationCounter sees overflows and growth
+	char* allocateBlock(size_t bytes)
+	{
+		return static_cast<char*>(::operator new(bytes));
+	}
+}
+
+LinearArena::LinearArena(size_t capacity)
+	: block(allocateBlock(std::max<size_t>(capacity, 1)))
+	, blockSize(std::max<size_t>(capacity, 1))
+	, used(0)
+	, lastOffset(0)
+	, overflow(nullptr)
+	, overflowBytes(0)
+	, overflowCount(0)
+	, highWater(0)
+	, growthCount(0)
+	, liveCount(0)
+{
+}
+
+LinearArena::~LinearArena()
+{
+	releaseOverflow();
+	::operator delete(block);
+}
+
+void* LinearArena::allocate(size_t bytes, size_t alignment)
+{
+	// The blocks come from operator new, which doesn't guarantee more than this
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && alignment <= alignof(std::max_align_t));
+
+	const size_t offset = alignUp(used, alignment);
+	if (offset + bytes > blockSize)
+		return allocateOverflow(bytes);
+
+	liveCount++;
+	lastOffset = offset;
+	used = offset + bytes;
+	highWater = std::max(highWater, bytesUsed());
+	return block + offset;
+}
+
+void LinearArena::deallocate(void* ptr, size_t bytes)
+{
+	if (ptr == nullptr)
+		return;
+	assert(liveCount > 0);
+	liveCount--;
+
+	// Only the top of the block can be given back
+	if (ptr == block + lastOffset && lastOffset + bytes == used)
+		used = lastOffset;
+}
+
+void LinearArena::reset()
+{
+	if (overflow != nullptr)
+	{
+		releaseOverflow();
+
+		// Make room for the high-water mark, with some headroom
+		::operator delete(block);
+		blockSize = std::max(blockSize * 2, alignUp(highWater + highWater / 2, alignof(std::max_align_t)));
+		block = allocateBlock(blockSize);
+		growthCount++;
+	}
+
+	used = 0;
+	lastOffset = 0;
+	liveCount = 0;
+}
+
+void* LinearArena::allocateOverflow(size_t bytes)
+{
+	// The header keeps the chain of overflow blocks, the allocation follows it
+	const size_t headerSize = alignUp(sizeof(OverflowBlock), alignof(std::max_align_t));
+	auto memory = allocateBlock(headerSize + bytes);
+
+	auto header = reinterpret_cast<OverflowBlock*>(memory);
+	header->next = overflow;
+	overflow = header;
+
+	overflowBytes += bytes;
+	overflowCount++;
+	liveCount++;
+	highWater = std::max(highWater, bytesUsed());
+	return memory + headerSize;
+}
+
+void LinearArena::releaseOverflow()
+{
+	while (overflow != nullptr)
+	{
+		auto next = overflow->next;
+		::operator delete(overflow);
+		overflow = next;
+	}
+	overflowBytes = 0;
+	overflowCount = 0;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+// A bump allocator: allocating moves a pointer forward, and everything is released at once by reset().
+// Individual deallocations are ignored, except for the most recent allocation which is rolled back,
+// so temporaries that are freed in reverse order give their memory back right away.
+//
+// When the block runs out, further allocations fall back to overflow blocks from the heap. The next
+// reset() frees them and grows the block to the high-water mark, so a steady workload stops touching
+// the heap after the first few resets.
+class LinearArena
+{
+public:
+	explicit LinearArena(size_t capacity);
+	~LinearArena();
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+	void deallocate(void* ptr, size_t bytes);
+
+	// Invalidates every allocation made since the last reset
+	void reset();
+
+	inline size_t capacity() const { return blockSize; }
+	inline size_t bytesUsed() const { return used + overflowBytes; }
+	inline size_t highWaterMark() const { return highWater; }
+	// Allocations since the last reset that didn't fit in the block
+	inline size_t numOverflows() const { return overflowCount; }
+	// Times the block was reallocated because the previous resets overflowed
+	inline size_t numGrowths() const { return growthCount; }
+	// Allocations since the last reset that haven't been deallocated yet
+	inline size_t numLiveAllocations() const { return liveCount; }
+
+private:
+	struct OverflowBlock
+	{
+		OverflowBlock* next;
+	};
+
+	void* allocateOverflow(size_t bytes);
+	void releaseOverflow();
+
+	char* block;
+	size_t blockSize;
+	size_t used;
+	size_t lastOffset; // start of the most recent allocation, for rolling it back
+
+	OverflowBlock* overflow;
+	size_t overflowBytes;
+	size_t overflowCount;
+
+	size_t highWater;
+	size_t growthCount;
+	size_t liveCount;
+};
+
+// STL allocator that takes its memory from a LinearArena. Containers using it must not outlive the
+// next reset of the arena.
+template<class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	template<class U>
+	struct rebind
+	{
+		using other = ArenaAllocator<U>;
+	};
+
+	ArenaAllocator(LinearArena& arena) noexcept : arena(&arena) {}
+
+	template<class U>
+	ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+	T* allocate(size_t n)
+	{
+		if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_alloc();
+		return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		arena->deallocate(ptr, n * sizeof(T));
+	}
+
+	template<class U>
+	bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+	template<class U>
+	bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+
+private:
+	template<class U>
+	friend class ArenaAllocator;
+
+	LinearArena* arena;
+};
+
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
@@ -58,10 +58,28 @@ void ParticleSystem::drawParticles(const mat3& projection, const vec2& cameraPos
 		}
 }
 
+std::shared_ptr<ParticleEmitter> ParticleSystem::createEmitter(EmitterType type, int particlesPerSecond)
+{
+	switch (type)
+	{
+	case EmitterType::BLUE_COTTON_CANDY:
+		return std::make_shared<BlueCottonCandyEmitter>(particlesPerSecond);
+	case EmitterType::RAIN:
+		return std::make_shared<RainEmitter>(particlesPerSecond);
+	case EmitterType::CONFETTI:
+		return std::make_shared<ConfettiEmitter>();
+	case EmitterType::SPARKLE:
+		return std::make_shared<SparkleEmitter>(particlesPerSecond);
+	default:
+		return std::make_shared<BasicEmitter>(particlesPerSecond);
+	}
+}
+
 void ParticleSystem::onAddedEmitterEvent(const AddEmitterEvent& event)
 {
-	newEmitters.emplace(event.label, event.emitter);
-	event.emitter->initEmitter();
+	auto emitter = createEmitter(event.type, event.particlesPerSecond);
+	newEmitters.emplace(event.label, emitter);
+	emitter->initEmitter();
 }
 
 void ParticleSystem::onDeleteEmitterEvent(const DeleteEmitterEvent& event) {
@@ -81,6 +99,16 @@ void ParticleSystem::step(float elapsed_ms)
 	
 }
 
+int ParticleSystem::numParticles() const
+{
+	int count = 0;
+	for (const auto& emitter : newEmitters)
+	{
+		count += emitter.second->numParticles();
+	}
+	return count;
+}
+
 void ParticleSystem::initParticles()
 {
 	
@@ -13,9 +13,13 @@
 
 class ParticleEmitter;
 
+enum class EmitterType { BASIC, BLUE_COTTON_CANDY, RAIN, CONFETTI, SPARKLE };
+
+// The ParticleSystem creates the emitter itself, so that the code adding one doesn't depend on its GL resources
 struct AddEmitterEvent {
 	std::string label;
-	std::shared_ptr<ParticleEmitter> emitter;
+	EmitterType type;
+	int particlesPerSecond = 0; // Ignored by the confetti emitter
 };
 
 struct DeleteEmitterEvent {
@@ -44,6 +48,10 @@ public:
 		void step(float elapsed_ms);
 		void initParticles();
 
+		// Live particles of all the emitters, and how many emitters there are
+		int numParticles() const;
+		inline size_t numEmitters() const { return newEmitters.size(); }
+
 
 		static const int MaxParticles = 100;
 		//All of the emitters
@@ -86,6 +94,7 @@ private:
 
 		float secSinceLastParticleSpawn;
 
+		static std::shared_ptr<ParticleEmitter> createEmitter(EmitterType type, int particlesPerSecond);
 		void onAddedEmitterEvent(const AddEmitterEvent& event);
 		void onDeleteEmitterEvent(const DeleteEmitterEvent& event);
 		void onDeleteAllEmitterEvent(const DeleteAllEmittersEvent& event);
@@ -101,6 +110,7 @@ public:
 		virtual void createParticle(int index)=0;
 		void step(float elapsedMs);
 		void drawParticles(GLuint vertexBuffer, GLuint cameraRightWorldspaceID, GLuint cameraUpWorldspaceID,GLuint projectionMatrixID, const mat3& projection, const vec2& cameraPos);
+		inline int numParticles() const { return particlesCount; }
 protected:
 		GLuint particlesCenterPositionAndSizeBuffer;
 		GLuint particlesColorBuffer;
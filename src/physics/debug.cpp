@@ -10,11 +10,11 @@
 namespace DebugSystem 
 {
 	void createLine(vec2 position, vec2 scale) {
-		auto entity = ECS::Entity();
+		auto entity = ECS::Entity::create();
 
 		std::string key = "thick_line";
 		ShadedMesh& resource = cacheResource(key);
-		if (resource.effect.program.resource == 0) {
+		if (resource.effect.program == 0) {
 			// create a procedural circle
 			constexpr float z = -0.1f;
 			vec3 red = { 0.8,0.1,0.1 };
@@ -46,17 +46,17 @@ namespace DebugSystem
 		}
 
 		// Store a reference to the potentially re-used mesh object (the value is stored in the resource cache)
-		ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+		ECS::registry<ShadedMeshRef>().emplace(entity, resource);
 		entity.emplace<RenderableComponent>(RenderLayer::DEBUG);
 
 		// Create motion
-		auto& motion = ECS::registry<Motion>.emplace(entity);
+		auto& motion = ECS::registry<Motion>().emplace(entity);
 		motion.angle = 0.f;
 		motion.velocity = { 0, 0 };
 		motion.position = position;
 		motion.scale = scale;
 
-		ECS::registry<DebugComponent>.emplace(entity);
+		ECS::registry<DebugComponent>().emplace(entity);
 	}
 
 	void createBox(vec2 position, vec2 size)
@@ -126,8 +126,8 @@ namespace DebugSystem
 
 	void clearDebugComponents() {
 		// Clear old debugging visualizations
-		while (!ECS::registry<DebugComponent>.entities.empty()) {
-			ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<DebugComponent>.entities.back());
+		while (!ECS::registry<DebugComponent>().entities.empty()) {
+			ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<DebugComponent>().entities.back());
 		}
 	}
 
@@ -73,7 +73,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 	// having entities move at different speed based on the machine.
 	float step_seconds = 1.0f * (elapsed_ms / 1000.f);
 
-	for (auto entity : ECS::registry<Motion>.entities)
+	for (auto entity : ECS::registry<Motion>().entities)
 	{
 		auto& motion = entity.get<Motion>();
 
@@ -99,7 +99,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 				{
 					FinishedMovementEvent event;
 					event.entity = entity;
-					EventSystem<FinishedMovementEvent>::instance().sendEvent(event);
+					EventSystem<FinishedMovementEvent>::instance().queueEvent(event);
 
 					motion.velocity = { 0.f, 0.f };
 				}
@@ -137,7 +137,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 		}
 
 		// Camera follows the moving entity
-		if ((entity.has<PlayerComponent>() || entity.has<AISystem::MobComponent>()) && ECS::registry<CameraDelayedMoveComponent>.entities.empty()) {
+		if ((entity.has<PlayerComponent>() || entity.has<AISystem::MobComponent>()) && ECS::registry<CameraDelayedMoveComponent>().entities.empty()) {
 			// Move camera to the entity's position if entity is out of view and is moving
 			if (!CameraSystem::isPositionInView(motion.position, window_size_in_game_units) && (motion.velocity.x != 0 && motion.velocity.y != 0)) {
 				CameraSystem::viewPosition(motion.position, window_size_in_game_units);
@@ -151,7 +151,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 
 		// Position active arrow above active entity
 		if (entity.has<TurnSystem::TurnComponentIsActive>()) {
-			for (auto activeArrow : ECS::registry<ActiveArrow>.entities) {
+			for (auto activeArrow : ECS::registry<ActiveArrow>().entities) {
 				auto& offset = activeArrow.get<ActiveArrow>().offset;
 				activeArrow.get<Motion>().position = motion.position + offset;
 			}
@@ -159,11 +159,11 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 
 		//If the entity also has a stats component then move their HP bar
 		if (entity.has<StatsComponent>()) {
-			auto& statsComp = ECS::registry<StatsComponent>.get(entity);
+			auto& statsComp = ECS::registry<StatsComponent>().get(entity);
 			//make sure the stats component's hpbar has a motion component and is valid
 			if (statsComp.healthBar.has<Motion>()) {
-				auto& hpBarMotion = ECS::registry<Motion>.get(statsComp.healthBar);
-				auto& hpBar = ECS::registry<HPBar>.get(statsComp.healthBar);
+				auto& hpBarMotion = ECS::registry<Motion>().get(statsComp.healthBar);
+				auto& hpBar = ECS::registry<HPBar>().get(statsComp.healthBar);
 				hpBarMotion.position = motion.position + hpBar.offset;
 			}
 		}
@@ -173,12 +173,12 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 	// Visualization for debugging the position and scale of objects
 	if (DebugSystem::in_debug_mode)
 	{
-		int numEntities = ECS::registry<Motion>.entities.size();
+		int numEntities = ECS::registry<Motion>().entities.size();
 
 		for (int i = 0; i < numEntities; i++)
 		{
-			auto& entity = ECS::registry<Motion>.entities[i];
-			auto& motion = ECS::registry<Motion>.components[i];
+			auto& entity = ECS::registry<Motion>().entities[i];
+			auto& motion = ECS::registry<Motion>().components[i];
 
 			if (entity.has<DebugComponent>())
 			{
@@ -203,7 +203,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 
 
 	// Check for collisions between projectiles and all moving entities
-	for (auto projectileEntity : ECS::registry<ProjectileComponent>.entities)
+	for (auto projectileEntity : ECS::registry<ProjectileComponent>().entities)
 	{
 		if (!projectileEntity.has<Motion>())
 		{
@@ -215,7 +215,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 		BoundingBox projectileBoundingBox = getBoundingBox(projectileEntity, projectileMotion);
 
 		// Check whether the projectile collides with any Motion entities
-		for (auto targetEntity : ECS::registry<Motion>.entities)
+		for (auto targetEntity : ECS::registry<Motion>().entities)
 		{
 			// Ignore if targetEntity is dead or is a projectile itself
 			if (targetEntity.has<DeathTimer>() || targetEntity.has<ProjectileComponent>())
@@ -231,7 +231,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 			if (collides(projectileBoundingBox, targetBoundingBox))
 			{
 				// Log the collision
-				ECS::registry<Collision>.emplaceWithDuplicates(projectileEntity, targetEntity);
+				ECS::registry<Collision>().emplaceWithDuplicates(projectileEntity, targetEntity);
 			}
 		}
 	}
@@ -239,7 +239,7 @@ void PhysicsSystem::step(float elapsed_ms, vec2 window_size_in_game_units)
 
 void PhysicsSystem::blendMotionData(float alpha)
 {
-	for (auto& motion : ECS::registry<Motion>.components)
+	for (auto& motion : ECS::registry<Motion>().components)
 	{
 		// Blend prev and curr position unless prev is uninitialized
 		motion.renderPosition = motion.prevPosition == vec2(FLOAT_MIN) ?
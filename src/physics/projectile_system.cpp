@@ -31,9 +31,9 @@ void ProjectileSystem::step(float elapsed_ms)
 	const float elapsed_s = elapsed_ms / 1000.f;
 
 	// Update the projectile velocities and remove any projectiles that have finished
-	for (int i = ECS::registry<ProjectileComponent>.entities.size() - 1; i >= 0; i--)
+	for (int i = ECS::registry<ProjectileComponent>().entities.size() - 1; i >= 0; i--)
 	{
-		auto& projEntity = ECS::registry<ProjectileComponent>.entities[i];
+		auto& projEntity = ECS::registry<ProjectileComponent>().entities[i];
 		auto& projComponent = projEntity.get<ProjectileComponent>();
 
 		projComponent.timeSinceLaunch += elapsed_s;
@@ -154,14 +154,14 @@ void ProjectileSystem::updateCurvedTrajectory(float elapsed_s, ECS::Entity projE
 
 void ProjectileSystem::onLaunchEvent(const LaunchEvent& event)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ProjectileParams params = ProjectileParams::create(event.skillParams.projectileType);
 	auto instigator = event.skillParams.instigator;
 
 	// Create rendering primitives
 	ShadedMesh& resource = cacheResource(params.spritePath);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, spritePath(params.spritePath + ".png"), "textured");
 	}
@@ -0,0 +1,251 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_HAS_TSC 1
+#endif
+
+namespace
+{
+	// Taken at static initialization, so every sample comes after them
+	const uint64_t startTicks = Profiler::now();
+	const auto startTime = std::chrono::steady_clock::now();
+
+	std::atomic<uint32_t> nextThreadId(0);
+	thread_local uint32_t threadId = nextThreadId++;
+
+	// Jobs nest when a thread waiting on a counter runs other jobs
+	const int MAX_JOB_DEPTH = 32;
+	thread_local uint64_t jobBegins[MAX_JOB_DEPTH];
+	thread_local int jobDepth = 0;
+
+	void writeEscaped(std::ostream& out, const std::string& text)
+	{
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+				out << '\\';
+			out << c;
+		}
+	}
+}
+
+Profiler::Profiler()
+	: enabled(false)
+	, nextSample(0)
+	, slots(new Slot[MAX_SAMPLES])
+{
+	for (size_t i = 0; i < MAX_SAMPLES; i++)
+	{
+		slots[i].sequence = 0;
+	}
+}
+
+uint64_t Profiler::now()
+{
+#ifdef PROFILER_HAS_TSC
+	return __rdtsc();
+#else
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+double Profiler::ticksPerMicrosecond() const
+{
+#ifdef PROFILER_HAS_TSC
+	const uint64_t ticks = now() - startTicks;
+	const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+	return microseconds > 0.0 ? ticks / microseconds : 1.0;
+#else
+	return 1000.0;
+#endif
+}
+
+void Profiler::record(const char* name, uint64_t begin, uint64_t end)
+{
+	record(name, begin, end, threadId);
+}
+
+void Profiler::record(const char* name, uint64_t begin, uint64_t end, uint32_t track)
+{
+	if (!isEnabled())
+		return;
+
+	const uint64_t index = nextSample.fetch_add(1, std::memory_order_relaxed);
+	Slot& slot = slots[index % MAX_SAMPLES];
+	slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.begin.store(begin, std::memory_order_relaxed);
+	slot.end.store(end, std::memory_order_relaxed);
+	slot.threadId.store(track, std::memory_order_relaxed);
+	slot.sequence.store(2 * (index + 1), std::memory_order_release);
+}
+
+void Profiler::recordCounter(const char* name, uint64_t value)
+{
+	record(name, now(), value, COUNTER_TRACK);
+}
+
+const char* Profiler::intern(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return names.insert(name).first->c_str();
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& threadName : threadNames)
+	{
+		if (threadName.first == threadId)
+		{
+			threadName.second = name;
+			return;
+		}
+	}
+	threadNames.push_back({ threadId, name });
+}
+
+uint32_t Profiler::addTrack(const std::string& name)
+{
+	const uint32_t track = nextThreadId++;
+	std::lock_guard<std::mutex> lock(mutex);
+	threadNames.push_back({ track, name });
+	return track;
+}
+
+std::vector<Profiler::Sample> Profiler::samples() const
+{
+	std::vector<Sample> result;
+	result.reserve(MAX_SAMPLES);
+	Sample sample;
+	for (size_t i = 0; i < MAX_SAMPLES; i++)
+	{
+		if (readSlot(i, 0, sample))
+			result.push_back(sample);
+	}
+
+	std::sort(result.begin(), result.end(), [](const Sample& a, const Sample& b) { return a.begin < b.begin; });
+	return result;
+}
+
+uint64_t Profiler::samplesSince(uint64_t first, std::vector<Sample>& out) const
+{
+	const uint64_t last = numRecorded();
+	if (last > MAX_SAMPLES)
+		first = std::max(first, last - MAX_SAMPLES);
+
+	Sample sample;
+	for (uint64_t index = first; index < last; index++)
+	{
+		if (readSlot(index % MAX_SAMPLES, 2 * (index + 1), sample))
+			out.push_back(sample);
+	}
+	return last;
+}
+
+bool Profiler::readSlot(size_t index, uint64_t expectedSequence, Sample& sample) const
+{
+	const Slot& slot = slots[index];
+	const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+	if (sequence == 0 || sequence % 2 == 1 || (expectedSequence != 0 && sequence != expectedSequence))
+		return false;
+
+	sample.name = slot.name.load(std::memory_order_relaxed);
+	sample.begin = slot.begin.load(std::memory_order_relaxed);
+	sample.end = slot.end.load(std::memory_order_relaxed);
+	sample.threadId = slot.threadId.load(std::memory_order_relaxed);
+
+	// Skip the slot if a writer started overwriting it while it was copied
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const
+{
+	const auto recorded = samples();
+	const double ticksPerUs = ticksPerMicrosecond();
+
+	std::ofstream file(path);
+	if (!file)
+	{
+		std::cout << "Profiler: can't write " << path << std::endl;
+		return false;
+	}
+
+	// Complete ("X") and counter ("C") events, in microseconds since startup
+	file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool isFirst = true;
+	for (const auto& sample : recorded)
+	{
+		file << (isFirst ? "\n" : ",\n") << "{\"name\":\"";
+		writeEscaped(file, sample.name);
+		const double timestamp = static_cast<double>(static_cast<int64_t>(sample.begin - startTicks)) / ticksPerUs;
+		if (sample.threadId == COUNTER_TRACK)
+		{
+			file << "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << timestamp << ",\"args\":{\"value\":" << sample.end << "}}";
+		}
+		else
+		{
+			file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << sample.threadId << ",\"ts\":" << timestamp
+				<< ",\"dur\":" << static_cast<double>(sample.end - sample.begin) / ticksPerUs << "}";
+		}
+		isFirst = false;
+	}
+
+	// Metadata events naming the threads
+	std::vector<uint32_t> threadIds;
+	for (const auto& sample : recorded)
+	{
+		if (sample.threadId != COUNTER_TRACK)
+			threadIds.push_back(sample.threadId);
+	}
+	std::sort(threadIds.begin(), threadIds.end());
+	threadIds.erase(std::unique(threadIds.begin(), threadIds.end()), threadIds.end());
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (uint32_t id : threadIds)
+		{
+			std::string name = "thread " + std::to_string(id);
+			for (const auto& threadName : threadNames)
+			{
+				if (threadName.first == id)
+					name = threadName.second;
+			}
+			file << (isFirst ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+				<< ",\"args\":{\"name\":\"";
+			writeEscaped(file, name);
+			file << "\"}}";
+			isFirst = false;
+		}
+	}
+	file << "\n]}\n";
+
+	std::cout << "Profiler: wrote " << recorded.size() << " samples to " << path << std::endl;
+	return true;
+}
+
+void Profiler::onJobBegin()
+{
+	if (jobDepth < MAX_JOB_DEPTH)
+		jobBegins[jobDepth] = now();
+	jobDepth++;
+}
+
+void Profiler::onJobEnd()
+{
+	jobDepth--;
+	if (jobDepth < MAX_JOB_DEPTH)
+		instance().record("job", jobBegins[jobDepth], now());
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Records how long named scopes take on every thread, e.g. the step of every system, into a ring
+// buffer that keeps the last MAX_SAMPLES samples. Recording never locks or allocates, so the timers
+// can stay in release builds. The samples are written out as a Chrome trace, which opens in
+// chrome://tracing or https://ui.perfetto.dev.
+//
+// Time is measured in ticks of the CPU's time stamp counter on x86 (constant rate on every CPU of
+// the last decade), and of the steady clock elsewhere. Nothing is recorded until setEnabled(true).
+class Profiler
+{
+public:
+	struct Sample
+	{
+		// A string literal, or a name returned by intern()
+		const char* name;
+		uint64_t begin;
+		uint64_t end;
+		uint32_t threadId;
+	};
+
+	// About a minute of frames
+	static const size_t MAX_SAMPLES = 1 << 17;
+	// The threadId of the samples of recordCounter(), whose end is the value
+	static const uint32_t COUNTER_TRACK = UINT32_MAX;
+
+	static Profiler& instance()
+	{
+		static Profiler profiler;
+		return profiler;
+	}
+
+	static uint64_t now();
+	// From the ticks of now() to microseconds, measured against the steady clock since startup
+	double ticksPerMicrosecond() const;
+
+	inline void setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+	inline bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	void record(const char* name, uint64_t begin, uint64_t end);
+	// On a track of its own rather than the calling thread's, e.g. for the GPU
+	void record(const char* name, uint64_t begin, uint64_t end, uint32_t track);
+	uint32_t addTrack(const std::string& name);
+	// A value over time rather than a scope, e.g. the GL calls of the frame, shown as a graph
+	void recordCounter(const char* name, uint64_t value);
+	// Returns a copy of the name that lives as long as the profiler, for names built at runtime
+	const char* intern(const std::string& name);
+	// Shown in the trace instead of "thread <id>"
+	void setThreadName(const std::string& name);
+
+	// The samples still in the ring buffer, oldest first
+	std::vector<Sample> samples() const;
+	// The index the next sample will get, i.e. how many were recorded so far
+	inline uint64_t numRecorded() const { return nextSample.load(std::memory_order_acquire); }
+	// Appends the samples recorded from the given index on that are still in the ring buffer, e.g.
+	// for the overlay to sum up the last few frames. Returns the index to continue from next time.
+	uint64_t samplesSince(uint64_t first, std::vector<Sample>& out) const;
+	// Writes the samples in the Chrome trace_event format, returns false if the file can't be written
+	bool writeChromeTrace(const std::string& path) const;
+
+	// For JobSystem::setJobHooks, records a "job" sample around every job
+	static void onJobBegin();
+	static void onJobEnd();
+
+private:
+	// The fields are written and read with relaxed atomics; the sequence tells the reader whether
+	// a writer was busy with the slot (odd) or which sample it holds (2 * (index + 1))
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence;
+		std::atomic<const char*> name;
+		std::atomic<uint64_t> begin;
+		std::atomic<uint64_t> end;
+		std::atomic<uint32_t> threadId;
+	};
+
+	Profiler();
+
+	// False if the slot doesn't hold a complete sample, or not the expected one (unless it's 0)
+	bool readSlot(size_t index, uint64_t expectedSequence, Sample& sample) const;
+
+	std::atomic<bool> enabled;
+	std::atomic<uint64_t> nextSample;
+	std::unique_ptr<Slot[]> slots;
+
+	mutable std::mutex mutex;
+	std::unordered_set<std::string> names;
+	std::vector<std::pair<uint32_t, std::string>> threadNames;
+};
+
+// Records the time between its construction and destruction
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* name) : name(name), begin(Profiler::now()) {}
+	~ProfileScope() { Profiler::instance().record(name, begin, Profiler::now()); }
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	const char* name;
+	uint64_t begin;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+// Times the rest of the enclosing scope, e.g. PROFILE_SCOPE("draw: text");
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
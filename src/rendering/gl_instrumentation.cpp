@@ -0,0 +1,226 @@
+#include "gl_instrumentation.hpp"
+
+#include "profiling/profiler.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+GLInstrumentation::Counters GLInstrumentation::counters;
+GLInstrumentation::BoundState GLInstrumentation::bound;
+
+namespace
+{
+	GLInstrumentation::Counters lastFrameCounters;
+	// PER_CALL until init() knows what the context supports
+	GLInstrumentation::ErrorChecks errorCheckMode = GLInstrumentation::ErrorChecks::PER_CALL;
+	// The first error the debug callback got since it was last thrown
+	std::string debugOutputError;
+
+	const char* CALL_NAMES[] = {
+		"draws", "program binds", "texture binds", "vertex array binds", "buffer binds", "framebuffer binds",
+		"state changes", "uniforms", "location lookups", "vertex attributes", "buffer uploads", "glGetError"
+	};
+	static_assert(sizeof(CALL_NAMES) / sizeof(CALL_NAMES[0]) == static_cast<int>(GLCall::COUNT), "a GLCall has no name");
+
+	const GLCall BIND_CALLS[] = {
+		GLCall::USE_PROGRAM, GLCall::BIND_TEXTURE, GLCall::BIND_VERTEX_ARRAY, GLCall::BIND_BUFFER, GLCall::BIND_FRAMEBUFFER
+	};
+
+#ifndef NDEBUG
+	void APIENTRY onDebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+		const GLchar* message, const void* userParam)
+	{
+		(void)source; (void)id; (void)length; (void)userParam;
+		if (type == GL_DEBUG_TYPE_ERROR)
+		{
+			std::cerr << "OpenGL: " << message << std::endl;
+			if (debugOutputError.empty())
+				debugOutputError = message;
+		}
+		else if (severity == GL_DEBUG_SEVERITY_HIGH || severity == GL_DEBUG_SEVERITY_MEDIUM)
+		{
+			// Performance and portability warnings, e.g. a buffer being recreated every frame
+			std::cerr << "OpenGL warning: " << message << std::endl;
+		}
+	}
+
+	// Only debug contexts (GLFW_OPENGL_DEBUG_CONTEXT) of GL 4.3 or KHR_debug have the callback
+	bool hasDebugOutput()
+	{
+		if (gl3wDebugMessageCallback == nullptr || gl3wDebugMessageControl == nullptr)
+			return false;
+		GLint flags = 0;
+		glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+		return (flags & GL_CONTEXT_FLAG_DEBUG_BIT) != 0;
+	}
+#endif
+}
+
+GLInstrumentation::BoundState::BoundState()
+{
+	for (int i = 0; i < MAX_TEXTURE_UNITS; i++)
+	{
+		textures2D[i] = UNKNOWN;
+		textures2DArray[i] = UNKNOWN;
+	}
+}
+
+size_t GLInstrumentation::Counters::binds() const
+{
+	size_t total = 0;
+	for (GLCall call : BIND_CALLS)
+		total += calls[static_cast<int>(call)];
+	return total;
+}
+
+size_t GLInstrumentation::Counters::redundantBinds() const
+{
+	size_t total = 0;
+	for (GLCall call : BIND_CALLS)
+		total += redundant[static_cast<int>(call)];
+	return total;
+}
+
+void GLInstrumentation::init()
+{
+	errorCheckMode = ErrorChecks::PER_FRAME;
+	if (std::getenv("AMBROSIA_GL_CHECKS") != nullptr)
+		errorCheckMode = ErrorChecks::PER_CALL;
+#ifndef NDEBUG
+	else if (hasDebugOutput())
+	{
+		// Synchronous, so that the callback runs inside the call that failed and gl_has_errors() right
+		// after it throws at the same place as before
+		glEnable(GL_DEBUG_OUTPUT);
+		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+		glDebugMessageCallback(onDebugMessage, nullptr);
+		errorCheckMode = ErrorChecks::DEBUG_OUTPUT;
+	}
+#endif
+
+	const char* modeNames[] = { "after every call", "once per frame", "with KHR_debug" };
+	std::cout << "OpenGL errors are checked " << modeNames[static_cast<int>(errorCheckMode)] << std::endl;
+}
+
+void GLInstrumentation::endFrame()
+{
+	lastFrameCounters = counters;
+	counters = Counters();
+
+	auto& profiler = Profiler::instance();
+	if (profiler.isEnabled())
+	{
+		profiler.recordCounter("gl: draws", lastFrameCounters[GLCall::DRAW]);
+		profiler.recordCounter("gl: binds", lastFrameCounters.binds());
+		profiler.recordCounter("gl: redundant binds", lastFrameCounters.redundantBinds());
+		profiler.recordCounter("gl: state changes", lastFrameCounters[GLCall::STATE]);
+		profiler.recordCounter("gl: uniforms", lastFrameCounters[GLCall::UNIFORM]);
+		profiler.recordCounter("gl: location lookups", lastFrameCounters[GLCall::LOCATION_LOOKUP]);
+	}
+}
+
+const GLInstrumentation::Counters& GLInstrumentation::lastFrame()
+{
+	return lastFrameCounters;
+}
+
+const char* GLInstrumentation::callName(GLCall call)
+{
+	return CALL_NAMES[static_cast<int>(call)];
+}
+
+GLInstrumentation::ErrorChecks GLInstrumentation::errorChecks()
+{
+	return errorCheckMode;
+}
+
+void GLInstrumentation::checkErrors(const char* where)
+{
+	GLenum error = glGetError();
+
+	if (error == GL_NO_ERROR)
+		return;
+
+	const char* error_str = "";
+	while (error != GL_NO_ERROR)
+	{
+		switch (error)
+		{
+		case GL_INVALID_OPERATION:
+			error_str = "INVALID_OPERATION";
+			break;
+		case GL_INVALID_ENUM:
+			error_str = "INVALID_ENUM";
+			break;
+		case GL_INVALID_VALUE:
+			error_str = "INVALID_VALUE";
+			break;
+		case GL_OUT_OF_MEMORY:
+			error_str = "OUT_OF_MEMORY";
+			break;
+		case GL_INVALID_FRAMEBUFFER_OPERATION:
+			error_str = "INVALID_FRAMEBUFFER_OPERATION";
+			break;
+		}
+
+		std::cerr << "OpenGL:" << error_str << std::endl;
+		error = glGetError();
+	}
+	throw std::runtime_error("last OpenGL error in " + std::string(where) + ":" + std::string(error_str));
+}
+
+void GLInstrumentation::throwDebugOutputError()
+{
+	if (debugOutputError.empty())
+		return;
+
+	const std::string error = debugOutputError;
+	debugOutputError.clear();
+	throw std::runtime_error("OpenGL error: " + error);
+}
+
+void GLInstrumentation::checkCall()
+{
+	switch (errorCheckMode)
+	{
+	case ErrorChecks::PER_CALL:
+		checkErrors("a call");
+		break;
+	case ErrorChecks::DEBUG_OUTPUT:
+		throwDebugOutputError();
+		break;
+	case ErrorChecks::PER_FRAME:
+		break;
+	}
+}
+
+void GLInstrumentation::checkFrame()
+{
+	if (errorCheckMode == ErrorChecks::DEBUG_OUTPUT)
+		throwDebugOutputError();
+	else
+		checkErrors("the frame");
+}
+
+GLuint* GLInstrumentation::boundTexture(GLenum target)
+{
+	if (bound.activeTexture >= static_cast<GLuint>(MAX_TEXTURE_UNITS))
+		return nullptr;
+	if (target == GL_TEXTURE_2D)
+		return &bound.textures2D[bound.activeTexture];
+	if (target == GL_TEXTURE_2D_ARRAY)
+		return &bound.textures2DArray[bound.activeTexture];
+	return nullptr;
+}
+
+GLboolean* GLInstrumentation::enabledState(GLenum capability)
+{
+	if (capability == GL_BLEND)
+		return &bound.blend;
+	if (capability == GL_DEPTH_TEST)
+		return &bound.depthTest;
+	return nullptr;
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <gl3w.h>
+
+#include <cstddef>
+
+// The kinds of GL calls that are counted
+enum class GLCall
+{
+	DRAW,
+	USE_PROGRAM,
+	BIND_TEXTURE,
+	BIND_VERTEX_ARRAY,
+	BIND_BUFFER,
+	BIND_FRAMEBUFFER,
+	STATE, // glEnable, glDisable, glBlendFunc*
+	UNIFORM,
+	LOCATION_LOOKUP, // glGetUniformLocation, glGetAttribLocation
+	VERTEX_ATTRIBUTE,
+	BUFFER_UPLOAD,
+	GET_ERROR,
+	COUNT
+};
+
+// Counts the GL calls of every frame by kind, and the binds and state changes that set what was
+// already set. The functions at the end of this file replace the gl3w macros of the calls they count,
+// so every file that includes render_components.hpp goes through them. Only the main thread makes GL
+// calls, so the counters aren't atomic.
+//
+// It also decides how OpenGL errors are checked: gl_has_errors() used to call glGetError, a round
+// trip to the driver, after nearly every call. Now:
+//   - debug builds with KHR_debug get the driver's errors from a synchronous debug callback, and
+//     gl_has_errors() throws on the first one without calling glGetError
+//   - otherwise RenderSystem::draw checks once per frame, unless AMBROSIA_GL_CHECKS is set, which
+//     brings back the check after every call to find where an error comes from
+class GLInstrumentation
+{
+public:
+	enum class ErrorChecks { PER_CALL, PER_FRAME, DEBUG_OUTPUT };
+
+	struct Counters
+	{
+		size_t calls[static_cast<int>(GLCall::COUNT)] = {};
+		size_t redundant[static_cast<int>(GLCall::COUNT)] = {};
+
+		inline size_t operator[](GLCall call) const { return calls[static_cast<int>(call)]; }
+		size_t binds() const;
+		size_t redundantBinds() const;
+	};
+
+	// Once the GL functions are loaded
+	static void init();
+	// Called once per frame, keeps the counters of the frame and sends them to the Profiler
+	static void endFrame();
+	static const Counters& lastFrame();
+	static const char* callName(GLCall call);
+
+	static ErrorChecks errorChecks();
+	// Drains glGetError, throws std::runtime_error if there was an error
+	static void checkErrors(const char* where);
+	// Throws the error the debug callback got since the last call, if any
+	static void throwDebugOutputError();
+	// What gl_has_errors() does in the current mode
+	static void checkCall();
+	// Once the frame is drawn, catches what the per frame mode didn't check after the calls
+	static void checkFrame();
+
+	// Used by the wrappers below
+	static const int MAX_TEXTURE_UNITS = 16;
+	static const GLuint UNKNOWN = ~0u;
+	struct BoundState
+	{
+		GLuint program = UNKNOWN;
+		GLuint activeTexture = 0;
+		GLuint textures2D[MAX_TEXTURE_UNITS];
+		GLuint textures2DArray[MAX_TEXTURE_UNITS];
+		GLuint vertexArray = UNKNOWN;
+		GLuint arrayBuffer = UNKNOWN;
+		GLuint elementArrayBuffer = UNKNOWN; // part of the vertex array's state
+		GLuint framebuffer = UNKNOWN;
+		GLboolean blend = 2; // neither GL_TRUE nor GL_FALSE
+		GLboolean depthTest = 2;
+		GLenum blendFunc[4] = { UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+
+		BoundState();
+	};
+	static Counters counters;
+	static BoundState bound;
+
+	static inline void count(GLCall call)
+	{
+		counters.calls[static_cast<int>(call)]++;
+	}
+	static inline void countChange(GLCall call, GLuint& current, GLuint value)
+	{
+		count(call);
+		if (current == value)
+			counters.redundant[static_cast<int>(call)]++;
+		current = value;
+	}
+	static GLuint* boundTexture(GLenum target);
+	static GLboolean* enabledState(GLenum capability);
+};
+
+namespace InstrumentedGL
+{
+	inline void drawArrays(GLenum mode, GLint first, GLsizei count)
+	{
+		GLInstrumentation::count(GLCall::DRAW);
+		gl3wDrawArrays(mode, first, count);
+	}
+	inline void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+	{
+		GLInstrumentation::count(GLCall::DRAW);
+		gl3wDrawElements(mode, count, type, indices);
+	}
+	inline void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+	{
+		GLInstrumentation::count(GLCall::DRAW);
+		gl3wDrawArraysInstanced(mode, first, count, instances);
+	}
+
+	inline void useProgram(GLuint program)
+	{
+		GLInstrumentation::countChange(GLCall::USE_PROGRAM, GLInstrumentation::bound.program, program);
+		gl3wUseProgram(program);
+	}
+	inline void activeTexture(GLenum unit)
+	{
+		GLInstrumentation::bound.activeTexture = unit - GL_TEXTURE0;
+		gl3wActiveTexture(unit);
+	}
+	inline void bindTexture(GLenum target, GLuint texture)
+	{
+		GLuint* bound = GLInstrumentation::boundTexture(target);
+		if (bound != nullptr)
+			GLInstrumentation::countChange(GLCall::BIND_TEXTURE, *bound, texture);
+		else
+			GLInstrumentation::count(GLCall::BIND_TEXTURE);
+		gl3wBindTexture(target, texture);
+	}
+	inline void bindVertexArray(GLuint vertexArray)
+	{
+		auto& bound = GLInstrumentation::bound;
+		if (bound.vertexArray != vertexArray)
+			bound.elementArrayBuffer = GLInstrumentation::UNKNOWN;
+		GLInstrumentation::countChange(GLCall::BIND_VERTEX_ARRAY, bound.vertexArray, vertexArray);
+		gl3wBindVertexArray(vertexArray);
+	}
+	inline void bindBuffer(GLenum target, GLuint buffer)
+	{
+		auto& bound = GLInstrumentation::bound;
+		if (target == GL_ARRAY_BUFFER)
+			GLInstrumentation::countChange(GLCall::BIND_BUFFER, bound.arrayBuffer, buffer);
+		else if (target == GL_ELEMENT_ARRAY_BUFFER)
+			GLInstrumentation::countChange(GLCall::BIND_BUFFER, bound.elementArrayBuffer, buffer);
+		else
+			GLInstrumentation::count(GLCall::BIND_BUFFER);
+		gl3wBindBuffer(target, buffer);
+	}
+	inline void bindFramebuffer(GLenum target, GLuint framebuffer)
+	{
+		if (target == GL_FRAMEBUFFER)
+			GLInstrumentation::countChange(GLCall::BIND_FRAMEBUFFER, GLInstrumentation::bound.framebuffer, framebuffer);
+		else
+			GLInstrumentation::count(GLCall::BIND_FRAMEBUFFER);
+		gl3wBindFramebuffer(target, framebuffer);
+	}
+
+	inline void setEnabled(GLenum capability, GLboolean isEnabled)
+	{
+		GLInstrumentation::count(GLCall::STATE);
+		GLboolean* state = GLInstrumentation::enabledState(capability);
+		if (state != nullptr)
+		{
+			if (*state == isEnabled)
+				GLInstrumentation::counters.redundant[static_cast<int>(GLCall::STATE)]++;
+			*state = isEnabled;
+		}
+	}
+	inline void enable(GLenum capability)
+	{
+		setEnabled(capability, GL_TRUE);
+		gl3wEnable(capability);
+	}
+	inline void disable(GLenum capability)
+	{
+		setEnabled(capability, GL_FALSE);
+		gl3wDisable(capability);
+	}
+	inline void setBlendFunc(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+	{
+		GLInstrumentation::count(GLCall::STATE);
+		GLenum* current = GLInstrumentation::bound.blendFunc;
+		if (current[0] == srcRGB && current[1] == dstRGB && current[2] == srcAlpha && current[3] == dstAlpha)
+			GLInstrumentation::counters.redundant[static_cast<int>(GLCall::STATE)]++;
+		current[0] = srcRGB;
+		current[1] = dstRGB;
+		current[2] = srcAlpha;
+		current[3] = dstAlpha;
+	}
+	inline void blendFunc(GLenum src, GLenum dst)
+	{
+		setBlendFunc(src, dst, src, dst);
+		gl3wBlendFunc(src, dst);
+	}
+	inline void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+	{
+		setBlendFunc(srcRGB, dstRGB, srcAlpha, dstAlpha);
+		gl3wBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+	}
+
+	inline void uniform1f(GLint location, GLfloat v0)
+	{
+		GLInstrumentation::count(GLCall::UNIFORM);
+		gl3wUniform1f(location, v0);
+	}
+	inline void uniform1i(GLint location, GLint v0)
+	{
+		GLInstrumentation::count(GLCall::UNIFORM);
+		gl3wUniform1i(location, v0);
+	}
+	inline void uniform2f(GLint location, GLfloat v0, GLfloat v1)
+	{
+		GLInstrumentation::count(GLCall::UNIFORM);
+		gl3wUniform2f(location, v0, v1);
+	}
+	inline void uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+	{
+		GLInstrumentation::count(GLCall::UNIFORM);
+		gl3wUniform3f(location, v0, v1, v2);
+	}
+	inline void uniform3fv(GLint location, GLsizei count, const GLfloat* value)
+	{
+		GLInstrumentation::count(GLCall::UNIFORM);
+		gl3wUniform3fv(location, count, value);
+	}
+	inline void uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+	{
+		GLInstrumentation::count(GLCall::UNIFORM);
+		gl3wUniformMatrix3fv(location, count, transpose, value);
+	}
+	inline void uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+	{
+		GLInstrumentation::count(GLCall::UNIFORM);
+		gl3wUniformMatrix4fv(location, count, transpose, value);
+	}
+	inline GLint getUniformLocation(GLuint program, const GLchar* name)
+	{
+		GLInstrumentation::count(GLCall::LOCATION_LOOKUP);
+		return gl3wGetUniformLocation(program, name);
+	}
+	inline GLint getAttribLocation(GLuint program, const GLchar* name)
+	{
+		GLInstrumentation::count(GLCall::LOCATION_LOOKUP);
+		return gl3wGetAttribLocation(program, name);
+	}
+
+	inline void vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+	{
+		GLInstrumentation::count(GLCall::VERTEX_ATTRIBUTE);
+		gl3wVertexAttribPointer(index, size, type, normalized, stride, pointer);
+	}
+	inline void enableVertexAttribArray(GLuint index)
+	{
+		GLInstrumentation::count(GLCall::VERTEX_ATTRIBUTE);
+		gl3wEnableVertexAttribArray(index);
+	}
+	inline void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+	{
+		GLInstrumentation::count(GLCall::BUFFER_UPLOAD);
+		gl3wBufferData(target, size, data, usage);
+	}
+	inline void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+	{
+		GLInstrumentation::count(GLCall::BUFFER_UPLOAD);
+		gl3wBufferSubData(target, offset, size, data);
+	}
+
+	inline GLenum getError()
+	{
+		GLInstrumentation::count(GLCall::GET_ERROR);
+		return gl3wGetError();
+	}
+}
+
+#undef glDrawArrays
+#undef glDrawElements
+#undef glDrawArraysInstanced
+#undef glUseProgram
+#undef glActiveTexture
+#undef glBindTexture
+#undef glBindVertexArray
+#undef glBindBuffer
+#undef glBindFramebuffer
+#undef glEnable
+#undef glDisable
+#undef glBlendFunc
+#undef glBlendFuncSeparate
+#undef glUniform1f
+#undef glUniform1i
+#undef glUniform2f
+#undef glUniform3f
+#undef glUniform3fv
+#undef glUniformMatrix3fv
+#undef glUniformMatrix4fv
+#undef glGetUniformLocation
+#undef glGetAttribLocation
+#undef glVertexAttribPointer
+#undef glEnableVertexAttribArray
+#undef glBufferData
+#undef glBufferSubData
+#undef glGetError
+
+#define glDrawArrays InstrumentedGL::drawArrays
+#define glDrawElements InstrumentedGL::drawElements
+#define glDrawArraysInstanced InstrumentedGL::drawArraysInstanced
+#define glUseProgram InstrumentedGL::useProgram
+#define glActiveTexture InstrumentedGL::activeTexture
+#define glBindTexture InstrumentedGL::bindTexture
+#define glBindVertexArray InstrumentedGL::bindVertexArray
+#define glBindBuffer InstrumentedGL::bindBuffer
+#define glBindFramebuffer InstrumentedGL::bindFramebuffer
+#define glEnable InstrumentedGL::enable
+#define glDisable InstrumentedGL::disable
+#define glBlendFunc InstrumentedGL::blendFunc
+#define glBlendFuncSeparate InstrumentedGL::blendFuncSeparate
+#define glUniform1f InstrumentedGL::uniform1f
+#define glUniform1i InstrumentedGL::uniform1i
+#define glUniform2f InstrumentedGL::uniform2f
+#define glUniform3f InstrumentedGL::uniform3f
+#define glUniform3fv InstrumentedGL::uniform3fv
+#define glUniformMatrix3fv InstrumentedGL::uniformMatrix3fv
+#define glUniformMatrix4fv InstrumentedGL::uniformMatrix4fv
+#define glGetUniformLocation InstrumentedGL::getUniformLocation
+#define glGetAttribLocation InstrumentedGL::getAttribLocation
+#define glVertexAttribPointer InstrumentedGL::vertexAttribPointer
+#define glEnableVertexAttribArray InstrumentedGL::enableVertexAttribArray
+#define glBufferData InstrumentedGL::bufferData
+#define glBufferSubData InstrumentedGL::bufferSubData
+#define glGetError InstrumentedGL::getError
@@ -0,0 +1,94 @@
+#include "gpu_timer.hpp"
+#include "render.hpp"
+
+#include "profiling/profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+GpuTimer::~GpuTimer()
+{
+	if (!isInitialized)
+		return;
+	for (auto& frame : frames)
+		glDeleteQueries(MAX_PASSES, frame.queries);
+}
+
+void GpuTimer::init()
+{
+	for (auto& frame : frames)
+		glGenQueries(MAX_PASSES, frame.queries);
+	gl_has_errors();
+
+	track = Profiler::instance().addTrack("GPU");
+	isInitialized = true;
+}
+
+void GpuTimer::beginFrame()
+{
+	if (!isInitialized)
+		return;
+
+	currentFrame = (currentFrame + 1) % FRAMES_IN_FLIGHT;
+	Frame& frame = frames[currentFrame];
+	if (frame.numPasses > 0)
+		collect(frame);
+	frame.numPasses = 0;
+}
+
+void GpuTimer::collect(Frame& frame)
+{
+	// The passes finish in order, so the others are done if the last one is
+	GLuint isAvailable = GL_FALSE;
+	glGetQueryObjectuiv(frame.queries[frame.numPasses - 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+	if (isAvailable == GL_FALSE)
+	{
+		droppedFrames++;
+		return;
+	}
+
+	Profiler& profiler = Profiler::instance();
+	const double ticksPerNs = profiler.ticksPerMicrosecond() / 1000.0;
+	uint64_t gpuEnd = 0;
+
+	lastResults.numPasses = frame.numPasses;
+	lastResults.totalMs = 0.f;
+	for (int i = 0; i < frame.numPasses; i++)
+	{
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds);
+
+		const float ms = static_cast<float>(nanoseconds / 1e6);
+		lastResults.passes[i] = { frame.names[i], ms };
+		lastResults.totalMs += ms;
+
+		// The GPU starts a pass once it's issued and the previous pass is done
+		const uint64_t gpuBegin = std::max(frame.issuedAt[i], gpuEnd);
+		gpuEnd = gpuBegin + static_cast<uint64_t>(nanoseconds * ticksPerNs);
+		profiler.record(frame.names[i], gpuBegin, gpuEnd, track);
+	}
+	gl_has_errors();
+}
+
+void GpuTimer::begin(const char* name)
+{
+	assert(!isInPass);
+	Frame& frame = frames[currentFrame];
+	if (!isInitialized || frame.numPasses == MAX_PASSES)
+		return;
+
+	frame.names[frame.numPasses] = name;
+	frame.issuedAt[frame.numPasses] = Profiler::now();
+	glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.numPasses]);
+	isInPass = true;
+}
+
+void GpuTimer::end()
+{
+	if (!isInPass)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	frames[currentFrame].numPasses++;
+	isInPass = false;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "render_components.hpp"
+
+#include <cstdint>
+
+// Times the render passes on the GPU with GL_TIME_ELAPSED queries. Every frame in flight has its own
+// set of queries, and a frame's results are only read FRAMES_IN_FLIGHT frames later, once the GPU is
+// done with them, so reading them never stalls the CPU. Results that still aren't available by then
+// are dropped.
+//
+// The passes go to the Profiler on a "GPU" track, lined up back to back from the time the CPU issued
+// them, and lastFrame() keeps the latest times for the overlay. Queries of this kind can't nest.
+class GpuTimer
+{
+public:
+	static const int FRAMES_IN_FLIGHT = 2;
+	static const int MAX_PASSES = 8;
+
+	struct PassTime
+	{
+		const char* name;
+		float ms;
+	};
+
+	struct FrameTimes
+	{
+		PassTime passes[MAX_PASSES];
+		int numPasses = 0;
+		float totalMs = 0.f;
+	};
+
+	GpuTimer() = default;
+	~GpuTimer();
+	GpuTimer(const GpuTimer&) = delete;
+	GpuTimer& operator=(const GpuTimer&) = delete;
+
+	// Creates the queries, once the GL functions are loaded
+	void init();
+
+	// Reads the results of the oldest frame in flight and starts reusing its queries
+	void beginFrame();
+	void begin(const char* name);
+	void end();
+
+	// The most recent frame whose results came back
+	inline const FrameTimes& lastFrame() const { return lastResults; }
+	inline size_t numDroppedFrames() const { return droppedFrames; }
+
+	// Times the passes drawn during its lifetime
+	class Scope
+	{
+	public:
+		Scope(GpuTimer& timer, const char* name) : timer(timer) { timer.begin(name); }
+		~Scope() { timer.end(); }
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		GpuTimer& timer;
+	};
+
+private:
+	struct Frame
+	{
+		GLuint queries[MAX_PASSES] = {};
+		const char* names[MAX_PASSES] = {};
+		// Profiler ticks at which the CPU issued every pass
+		uint64_t issuedAt[MAX_PASSES] = {};
+		int numPasses = 0;
+	};
+
+	void collect(Frame& frame);
+
+	Frame frames[FRAMES_IN_FLIGHT];
+	int currentFrame = 0;
+	bool isInPass = false;
+	bool isInitialized = false;
+	uint32_t track = 0;
+
+	FrameTimes lastResults;
+	size_t droppedFrames = 0;
+};
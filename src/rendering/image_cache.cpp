@@ -0,0 +1,129 @@
+#include "image_cache.hpp"
+#include "render_components.hpp"
+
+#include "profiling/profiler.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <cassert>
+#include <iostream>
+#include <sys/stat.h>
+
+namespace
+{
+	// Returns -1 if the file doesn't exist
+	long long modificationTime(const std::string& path)
+	{
+		struct stat buffer;
+		if (stat(path.c_str(), &buffer) != 0)
+			return -1;
+		return static_cast<long long>(buffer.st_mtime);
+	}
+}
+
+std::shared_ptr<const DecodedImage> ImageCache::load(const std::string& path)
+{
+	const long long mtime = modificationTime(path);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = entries.find(path);
+		if (it != entries.end() && it->second.mtime == mtime)
+		{
+			// Mark as most recently used
+			lru.splice(lru.begin(), lru, it->second.lruIt);
+			hits++;
+			return it->second.image;
+		}
+		misses++;
+	}
+
+	// Decode without holding the lock, so that background prefetches don't stall the main thread
+	PROFILE_SCOPE("decode image");
+	auto image = std::make_shared<DecodedImage>();
+	image->pixels.reset(stbi_load(path.c_str(), &image->size.x, &image->size.y, nullptr, 4));
+	if (image->pixels == nullptr)
+		throw std::runtime_error("data == NULL, failed to load texture " + path);
+	image->bytes = static_cast<size_t>(image->size.x) * image->size.y * 4;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = entries.find(path);
+	if (it != entries.end())
+	{
+		// Another thread decoded the same file in the meantime
+		if (it->second.mtime == mtime)
+			return it->second.image;
+
+		// The file changed on disk, drop the stale pixels
+		bytesUsed -= it->second.image->bytes;
+		lru.erase(it->second.lruIt);
+		entries.erase(it);
+	}
+
+	lru.push_front(path);
+	entries.emplace(path, Entry{ image, mtime, lru.begin() });
+	bytesUsed += image->bytes;
+	evictToBudget();
+
+	return image;
+}
+
+void ImageCache::setBudget(size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	budgetBytes = bytes;
+	evictToBudget();
+}
+
+void ImageCache::resetCounters()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+void ImageCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+	lru.clear();
+	bytesUsed = 0;
+}
+
+void ImageCache::printStats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::cout << "ImageCache: " << entries.size() << " images, "
+		<< bytesUsed / (1024 * 1024) << "/" << budgetBytes / (1024 * 1024) << " MB, "
+		<< hits << " hits, " << misses << " misses, " << evictions << " evictions" << std::endl;
+}
+
+void ImageCache::evictToBudget()
+{
+	// Never evict the most recently used image, even if it alone exceeds the budget
+	while (bytesUsed > budgetBytes && lru.size() > 1)
+	{
+		auto it = entries.find(lru.back());
+		assert(it != entries.end());
+		bytesUsed -= it->second.image->bytes;
+		entries.erase(it);
+		lru.pop_back();
+		evictions++;
+	}
+}
+
+// Declared with Texture, but it only deals with file names, so it stays with the image decoding
+std::string Texture::framePath(const std::string& path, int frame)
+{
+	std::string framePath = path + "_00" + std::to_string(frame) + ".png";
+	if (frame >= 10)
+	{
+		framePath = path + "_0" + std::to_string(frame) + ".png";
+	}
+	if (frame >= 100)
+	{
+		framePath = path + "_" + std::to_string(frame) + ".png";
+	}
+	return framePath;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "game/common.hpp"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "stb_image.h"
+
+// RGBA8 pixels decoded from an image file
+struct DecodedImage
+{
+	ivec2 size = { 0, 0 };
+	size_t bytes = 0;
+	std::unique_ptr<stbi_uc, void(*)(void*)> pixels{ nullptr, stbi_image_free };
+};
+
+// Process-wide cache of decoded images, so that textures recreated after a map
+// transition (or shared between several meshes) don't hit the disk and zlib again.
+// Entries are keyed by path and invalidated when the file's modification time changes.
+// Once the byte budget is exceeded, the least recently used images are evicted.
+// load() may be called from worker threads.
+class ImageCache
+{
+public:
+	static constexpr size_t DEFAULT_BUDGET_BYTES = 256u * 1024u * 1024u;
+
+	// Returns the singleton instance of this cache
+	static ImageCache& instance()
+	{
+		static ImageCache imageCache;
+		return imageCache;
+	}
+
+	// Returns the decoded image at `path`, decoding it on a miss. Throws if the file can't be decoded.
+	// The returned pointer stays valid even if the entry is evicted in the meantime.
+	std::shared_ptr<const DecodedImage> load(const std::string& path);
+
+	void setBudget(size_t bytes);
+	inline size_t getBudget() const { return budgetBytes; }
+	inline size_t getBytesUsed() const { return bytesUsed; }
+	inline size_t size() const { return entries.size(); }
+
+	inline size_t getHits() const { return hits; }
+	inline size_t getMisses() const { return misses; }
+	inline size_t getEvictions() const { return evictions; }
+	void resetCounters();
+
+	void clear();
+	void printStats() const;
+
+private:
+	ImageCache() = default;
+	ImageCache(const ImageCache&) = delete;
+	ImageCache& operator=(const ImageCache&) = delete;
+
+	struct Entry
+	{
+		std::shared_ptr<const DecodedImage> image;
+		long long mtime;
+		std::list<std::string>::iterator lruIt;
+	};
+
+	void evictToBudget();
+
+	mutable std::mutex mutex;
+	std::unordered_map<std::string, Entry> entries;
+	std::list<std::string> lru; // most recently used at the front
+
+	size_t budgetBytes = DEFAULT_BUDGET_BYTES;
+	size_t bytesUsed = 0;
+	size_t hits = 0;
+	size_t misses = 0;
+	size_t evictions = 0;
+};
@@ -0,0 +1,437 @@
+#include "perf_overlay.hpp"
+#include "render.hpp"
+#include "gpu_timer.hpp"
+#include "gl_instrumentation.hpp"
+#include "image_cache.hpp"
+#include "resource_manager.hpp"
+#include "text.hpp"
+
+#include "memory/allocation_counter.hpp"
+#include "particles/particle_system.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <typeinfo>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+bool PerfOverlay::isVisible = false;
+
+namespace
+{
+	// In pixels of the framebuffer, from the top left corner
+	const vec2 PANEL_POSITION = { 10.f, 10.f };
+	const float PANEL_WIDTH = 560.f;
+	const float PADDING = 6.f;
+	const float GRAPH_HEIGHT = 60.f;
+	// The top of the graph
+	const float GRAPH_MAX_MS = 50.f;
+	const float TARGET_FRAME_MS = 16.67f;
+
+	const int TEXT_WIDTH = 548;
+	const int TEXT_HEIGHT = 352;
+	const float LINE_HEIGHT = 16.f;
+	const float TEXT_SCALE = 0.28f;
+	const vec3 TEXT_COLOR = { 1.f, 1.f, 1.f };
+	const vec3 HEADING_COLOR = { 1.f, 0.85f, 0.4f };
+	const vec3 OVER_BUDGET_COLOR = { 1.f, 0.4f, 0.35f };
+
+	// What the overlay itself may cost per frame, on the CPU and on the GPU
+	const float BUDGET_MS = 0.2f;
+
+	// The profiled scopes are listed in two columns of this many rows
+	const int SCOPE_ROWS = 9;
+	const int NUM_COMPONENT_COUNTS = 6;
+
+	// Background, target frame time line and the bars
+	const int NUM_QUADS = 2 + 120;
+
+	const vec3 BACKGROUND_COLOR = { 0.08f, 0.08f, 0.1f };
+	const vec3 TARGET_COLOR = { 0.35f, 0.35f, 0.4f };
+
+	void setQuad(std::vector<ColoredVertex>& vertices, int quad, vec2 topLeft, vec2 bottomRight, vec3 color)
+	{
+		ColoredVertex* v = &vertices[quad * 4];
+		v[0].position = { topLeft.x, topLeft.y, 0.f };
+		v[1].position = { bottomRight.x, topLeft.y, 0.f };
+		v[2].position = { bottomRight.x, bottomRight.y, 0.f };
+		v[3].position = { topLeft.x, bottomRight.y, 0.f };
+		for (int i = 0; i < 4; i++)
+			v[i].color = color;
+	}
+
+	vec3 frameTimeColor(float ms)
+	{
+		if (ms <= TARGET_FRAME_MS * 1.1f)
+			return { 0.3f, 0.8f, 0.3f };
+		if (ms <= TARGET_FRAME_MS * 2.f)
+			return { 0.9f, 0.8f, 0.2f };
+		return { 0.9f, 0.25f, 0.2f };
+	}
+}
+
+PerfOverlay::~PerfOverlay()
+{
+	if (textFrameBuffer != 0)
+		glDeleteFramebuffers(1, &textFrameBuffer);
+	if (textTexture != 0)
+		glDeleteTextures(1, &textTexture);
+}
+
+void PerfOverlay::init()
+{
+	static_assert(NUM_QUADS == 2 + FRAME_HISTORY, "one bar per recorded frame");
+
+	graph.mesh.vertices.resize(NUM_QUADS * 4);
+	graph.mesh.vertex_indices.reserve(NUM_QUADS * 6);
+	for (int quad = 0; quad < NUM_QUADS; quad++)
+	{
+		const uint16_t first = static_cast<uint16_t>(quad * 4);
+		for (uint16_t index : { 0, 1, 2, 0, 2, 3 })
+			graph.mesh.vertex_indices.push_back(first + index);
+	}
+	RenderSystem::createColoredMesh(graph, "colored_mesh");
+
+	// The quad comes with the sprite, the texture is the target of the text
+	RenderSystem::createSprite(textQuad, "", "textured");
+	glGenTextures(1, &textTexture);
+	glBindTexture(GL_TEXTURE_2D, textTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TEXT_WIDTH, TEXT_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+	glGenFramebuffers(1, &textFrameBuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, textFrameBuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textTexture, 0);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		throw std::runtime_error("glCheckFramebufferStatus(GL_FRAMEBUFFER) for the performance overlay");
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	gl_has_errors();
+
+	font = Font::load(fontPath("Noto/NotoSans-Regular.ttf"));
+	isInitialized = true;
+}
+
+void PerfOverlay::recordFrame()
+{
+	const uint64_t now = Profiler::now();
+	if (lastFrameTicks != 0)
+	{
+		const float ms = static_cast<float>((now - lastFrameTicks) / Profiler::instance().ticksPerMicrosecond() / 1000.0);
+		frameTimes[frameIndex] = ms;
+		frameIndex = (frameIndex + 1) % FRAME_HISTORY;
+		msSinceRefresh += ms;
+		framesSinceRefresh++;
+	}
+	lastFrameTicks = now;
+
+	// Only the frames while it's shown are summed up
+	if (!isVisible)
+	{
+		firstSample = Profiler::instance().numRecorded();
+		framesSinceRefresh = 0;
+		msSinceRefresh = REFRESH_MS;
+	}
+}
+
+void PerfOverlay::draw(ivec2 frameBufferSize, const DrawStats& drawStats, const ParticleSystem& particles, const GpuTimer& gpuTimer)
+{
+	if (!isVisible || !isInitialized)
+		return;
+	const uint64_t start = Profiler::now();
+
+	// The pass that render() times around this call, read back a few frames later
+	const auto& gpuFrame = gpuTimer.lastFrame();
+	for (int i = 0; i < gpuFrame.numPasses; i++)
+	{
+		if (std::strcmp(gpuFrame.passes[i].name, "gpu: overlay") == 0)
+		{
+			cost.gpuMs += gpuFrame.passes[i].ms;
+			cost.worstGpuMs = std::max(cost.worstGpuMs, gpuFrame.passes[i].ms);
+			cost.gpuFrames++;
+		}
+	}
+
+	if (msSinceRefresh >= REFRESH_MS && framesSinceRefresh > 0)
+	{
+		PROFILE_SCOPE("overlay: refresh");
+		const uint64_t refreshStart = Profiler::now();
+		refreshText(drawStats, particles, gpuTimer);
+		renderText();
+		glViewport(0, 0, frameBufferSize.x, frameBufferSize.y);
+		msSinceRefresh = 0.f;
+		framesSinceRefresh = 0;
+		cost.refreshTicks = Profiler::now() - refreshStart;
+	}
+
+	// Pixels, from the top left corner
+	const float sx = 2.f / frameBufferSize.x;
+	const float sy = -2.f / frameBufferSize.y;
+	const mat3 projection = { { sx, 0.f, 0.f }, { 0.f, sy, 0.f }, { -1.f, 1.f, 1.f } };
+
+	glDisable(GL_DEPTH_TEST);
+	drawGraph(projection);
+	drawTextQuad(projection);
+
+	cost.cpuTicks += Profiler::now() - start;
+	cost.cpuFrames++;
+}
+
+void PerfOverlay::refreshText(const DrawStats& drawStats, const ParticleSystem& particles, const GpuTimer& gpuTimer)
+{
+	sumProfiledScopes();
+
+	size_t numLines = 0;
+	char buffer[160];
+	auto addLine = [&](vec2 position, vec3 color) {
+		if (numLines == lines.size())
+			lines.emplace_back();
+		Line& line = lines[numLines++];
+		line.content.assign(buffer);
+		line.position = position;
+		line.color = color;
+	};
+	float y = LINE_HEIGHT;
+	auto nextLine = [&]() { y += LINE_HEIGHT; };
+
+	float averageMs = 0.f;
+	float worstMs = 0.f;
+	for (float ms : frameTimes)
+	{
+		averageMs += ms / FRAME_HISTORY;
+		worstMs = std::max(worstMs, ms);
+	}
+	std::snprintf(buffer, sizeof(buffer), "%.2f ms per frame (%.0f fps), worst %.2f ms in the last %d frames",
+		averageMs, averageMs > 0.f ? 1000.f / averageMs : 0.f, worstMs, FRAME_HISTORY);
+	addLine({ 0.f, y }, HEADING_COLOR);
+	nextLine();
+
+	std::snprintf(buffer, sizeof(buffer), "drawn: %d sprites, %d texts    particles: %d in %zu emitters",
+		drawStats.sprites, drawStats.texts, particles.numParticles(), particles.numEmitters());
+	addLine({ 0.f, y }, TEXT_COLOR);
+	nextLine();
+
+	const auto& imageCache = ImageCache::instance();
+	std::snprintf(buffer, sizeof(buffer), "VRAM: %.1f MB    decoded images: %.1f of %.0f MB",
+		ResourceManager::instance().totalVRAM() / (1024.f * 1024.f),
+		imageCache.getBytesUsed() / (1024.f * 1024.f), imageCache.getBudget() / (1024.f * 1024.f));
+	addLine({ 0.f, y }, TEXT_COLOR);
+	nextLine();
+
+	std::snprintf(buffer, sizeof(buffer), "heap: %zu allocations last frame, %zu on the main thread",
+		AllocationCounter::lastFrameAllocations(), AllocationCounter::lastFrameMainThreadAllocations());
+	addLine({ 0.f, y }, TEXT_COLOR);
+	nextLine();
+
+	const auto& gpuFrame = gpuTimer.lastFrame();
+	std::snprintf(buffer, sizeof(buffer), "GPU: %.2f ms in %d passes, %zu frames not read back in time",
+		gpuFrame.totalMs, gpuFrame.numPasses, gpuTimer.numDroppedFrames());
+	addLine({ 0.f, y }, TEXT_COLOR);
+	nextLine();
+
+	const auto& glFrame = GLInstrumentation::lastFrame();
+	std::snprintf(buffer, sizeof(buffer), "GL: %zu draws, %zu binds (%zu redundant), %zu state changes (%zu redundant)",
+		glFrame[GLCall::DRAW], glFrame.binds(), glFrame.redundantBinds(), glFrame[GLCall::STATE],
+		glFrame.redundant[static_cast<int>(GLCall::STATE)]);
+	addLine({ 0.f, y }, TEXT_COLOR);
+	nextLine();
+	std::snprintf(buffer, sizeof(buffer), "GL: %zu uniforms, %zu location lookups, %zu buffer uploads, %zu glGetError",
+		glFrame[GLCall::UNIFORM], glFrame[GLCall::LOCATION_LOOKUP], glFrame[GLCall::BUFFER_UPLOAD], glFrame[GLCall::GET_ERROR]);
+	addLine({ 0.f, y }, TEXT_COLOR);
+	nextLine();
+
+	// This overlay, on average per frame since the last refresh, the refresh included
+	const double ticksPerMs = Profiler::instance().ticksPerMicrosecond() * 1000.0;
+	const float cpuMs = cost.cpuFrames > 0 ? static_cast<float>(cost.cpuTicks / ticksPerMs / cost.cpuFrames) : 0.f;
+	const float gpuMs = cost.gpuFrames > 0 ? cost.gpuMs / cost.gpuFrames : 0.f;
+	std::snprintf(buffer, sizeof(buffer), "overlay: CPU %.3f ms (refresh %.2f ms), GPU %.3f ms (worst %.3f ms), budget %.1f ms",
+		cpuMs, static_cast<float>(cost.refreshTicks / ticksPerMs), gpuMs, cost.worstGpuMs, BUDGET_MS);
+	addLine({ 0.f, y }, cpuMs > BUDGET_MS || gpuMs > BUDGET_MS ? OVER_BUDGET_COLOR : TEXT_COLOR);
+	nextLine();
+	cost = OverlayCost();
+
+	// The largest containers, three to a line
+	auto containers = ECS::ContainerInterface::allContainers();
+	std::sort(containers.begin(), containers.end(), [](ECS::ContainerInterface* a, ECS::ContainerInterface* b) {
+		return a->size() > b->size();
+	});
+	std::snprintf(buffer, sizeof(buffer), "%zu entities, %zu component types, the most common:",
+		ECS::EntityManager::numAlive(), containers.size());
+	addLine({ 0.f, y }, HEADING_COLOR);
+	nextLine();
+	for (int i = 0; i < NUM_COMPONENT_COUNTS && i < static_cast<int>(containers.size()); i++)
+	{
+		std::snprintf(buffer, sizeof(buffer), "%s %zu", componentName(*containers[i]).c_str(), containers[i]->size());
+		addLine({ (i % 3) * TEXT_WIDTH / 3.f, y }, TEXT_COLOR);
+		if (i % 3 == 2)
+			nextLine();
+	}
+	if (NUM_COMPONENT_COUNTS % 3 != 0)
+		nextLine();
+
+	std::snprintf(buffer, sizeof(buffer), "ms per frame, over the last %d frames:", framesSinceRefresh);
+	addLine({ 0.f, y }, HEADING_COLOR);
+	nextLine();
+	const double ticksPerFrameMs = ticksPerMs * framesSinceRefresh;
+	for (int i = 0; i < 2 * SCOPE_ROWS && i < static_cast<int>(scopeTicks.size()); i++)
+	{
+		std::snprintf(buffer, sizeof(buffer), "%.3f  %s", scopeTicks[i].second / ticksPerFrameMs, scopeTicks[i].first);
+		addLine({ (i / SCOPE_ROWS) * TEXT_WIDTH / 2.f, y + (i % SCOPE_ROWS) * LINE_HEIGHT }, TEXT_COLOR);
+	}
+
+	lines.erase(lines.begin() + numLines, lines.end());
+}
+
+void PerfOverlay::sumProfiledScopes()
+{
+	samples.clear();
+	firstSample = Profiler::instance().samplesSince(firstSample, samples);
+
+	// The same name may be a literal in several places
+	scopeTicks.clear();
+	for (const auto& sample : samples)
+	{
+		if (sample.threadId == Profiler::COUNTER_TRACK || std::strcmp(sample.name, "frame") == 0)
+			continue;
+
+		auto it = std::find_if(scopeTicks.begin(), scopeTicks.end(), [&sample](const std::pair<const char*, uint64_t>& scope) {
+			return std::strcmp(scope.first, sample.name) == 0;
+		});
+		if (it == scopeTicks.end())
+			scopeTicks.push_back({ sample.name, sample.end - sample.begin });
+		else
+			it->second += sample.end - sample.begin;
+	}
+
+	std::sort(scopeTicks.begin(), scopeTicks.end(), [](const std::pair<const char*, uint64_t>& a, const std::pair<const char*, uint64_t>& b) {
+		return a.second > b.second;
+	});
+}
+
+void PerfOverlay::renderText()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, textFrameBuffer);
+	glViewport(0, 0, TEXT_WIDTH, TEXT_HEIGHT);
+	glClearColor(0.f, 0.f, 0.f, 0.f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	// Premultiplied alpha, so that the glyphs keep their coverage once drawn onto the screen
+	glEnable(GL_BLEND);
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	for (const auto& line : lines)
+		drawText(Text(line.content, font, line.position, TEXT_SCALE, line.color), { TEXT_WIDTH, TEXT_HEIGHT });
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	gl_has_errors();
+}
+
+void PerfOverlay::drawGraph(const mat3& projection)
+{
+	auto& vertices = graph.mesh.vertices;
+	const float panelHeight = GRAPH_HEIGHT + TEXT_HEIGHT + 3 * PADDING;
+	setQuad(vertices, 0, PANEL_POSITION, PANEL_POSITION + vec2(PANEL_WIDTH, panelHeight), BACKGROUND_COLOR);
+
+	const vec2 graphBottomLeft = PANEL_POSITION + vec2(PADDING, PADDING + GRAPH_HEIGHT);
+	const float graphWidth = PANEL_WIDTH - 2 * PADDING;
+	const float targetY = graphBottomLeft.y - GRAPH_HEIGHT * TARGET_FRAME_MS / GRAPH_MAX_MS;
+	setQuad(vertices, 1, { graphBottomLeft.x, targetY }, { graphBottomLeft.x + graphWidth, targetY + 1.f }, TARGET_COLOR);
+
+	// Oldest on the left
+	const float barWidth = graphWidth / FRAME_HISTORY;
+	for (int i = 0; i < FRAME_HISTORY; i++)
+	{
+		const float ms = frameTimes[(frameIndex + i) % FRAME_HISTORY];
+		const float height = GRAPH_HEIGHT * std::min(ms / GRAPH_MAX_MS, 1.f);
+		const float x = graphBottomLeft.x + i * barWidth;
+		setQuad(vertices, 2 + i, { x, graphBottomLeft.y - height }, { x + barWidth - 1.f, graphBottomLeft.y }, frameTimeColor(ms));
+	}
+
+	const GLuint program = graph.effect.program;
+	glUseProgram(program);
+	glBindVertexArray(graph.mesh.vao);
+	glDisable(GL_BLEND);
+
+	glBindBuffer(GL_ARRAY_BUFFER, graph.mesh.vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(ColoredVertex) * vertices.size(), vertices.data());
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, graph.mesh.ibo);
+
+	const GLint in_position_loc = glGetAttribLocation(program, "in_position");
+	const GLint in_color_loc = glGetAttribLocation(program, "in_color");
+	glEnableVertexAttribArray(in_position_loc);
+	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(ColoredVertex), reinterpret_cast<void*>(0));
+	glEnableVertexAttribArray(in_color_loc);
+	glVertexAttribPointer(in_color_loc, 3, GL_FLOAT, GL_FALSE, sizeof(ColoredVertex), reinterpret_cast<void*>(sizeof(vec3)));
+
+	Transform transform;
+	glUniformMatrix3fv(glGetUniformLocation(program, "transform"), 1, GL_FALSE, (float*)&transform.mat);
+	glUniformMatrix3fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, (float*)&projection);
+
+	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(graph.mesh.vertex_indices.size()), GL_UNSIGNED_SHORT, nullptr);
+	glBindVertexArray(0);
+	gl_has_errors();
+}
+
+void PerfOverlay::drawTextQuad(const mat3& projection)
+{
+	const GLuint program = textQuad.effect.program;
+	glUseProgram(program);
+	glBindVertexArray(textQuad.mesh.vao);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+	glBindBuffer(GL_ARRAY_BUFFER, textQuad.mesh.vbo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, textQuad.mesh.ibo);
+	const GLint in_position_loc = glGetAttribLocation(program, "in_position");
+	const GLint in_texcoord_loc = glGetAttribLocation(program, "in_texcoord");
+	glEnableVertexAttribArray(in_position_loc);
+	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), reinterpret_cast<void*>(0));
+	glEnableVertexAttribArray(in_texcoord_loc);
+	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), reinterpret_cast<void*>(sizeof(vec3)));
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, textTexture);
+
+	// Below the graph. The texture was rendered bottom up, hence the negative height.
+	const vec2 size = { static_cast<float>(TEXT_WIDTH), static_cast<float>(TEXT_HEIGHT) };
+	Transform transform;
+	transform.translate(PANEL_POSITION + vec2(PADDING, GRAPH_HEIGHT + 2 * PADDING) + size / 2.f);
+	transform.scale({ size.x, -size.y });
+
+	glUniformMatrix3fv(glGetUniformLocation(program, "transform"), 1, GL_FALSE, (float*)&transform.mat);
+	glUniformMatrix3fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, (float*)&projection);
+	glUniform3f(glGetUniformLocation(program, "fcolor"), 1.f, 1.f, 1.f);
+	glUniform1f(glGetUniformLocation(program, "colourShift"), 0.f);
+	glUniform1i(glGetUniformLocation(program, "doesBob"), 0);
+
+	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
+	glBindVertexArray(0);
+	gl_has_errors();
+}
+
+const std::string& PerfOverlay::componentName(ECS::ContainerInterface& container)
+{
+	auto it = componentNames.find(container.getTypeId());
+	if (it != componentNames.end())
+		return it->second;
+
+	// e.g. "ECS::ComponentContainer<Motion>"
+	std::string name = typeid(container).name();
+#ifdef __GNUG__
+	int status = 0;
+	char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+	if (status == 0 && demangled != nullptr)
+		name = demangled;
+	std::free(demangled);
+#endif
+	const size_t open = name.find('<');
+	const size_t close = name.rfind('>');
+	if (open != std::string::npos && close != std::string::npos && close > open)
+		name = name.substr(open + 1, close - open - 1);
+
+	return componentNames.emplace(container.getTypeId(), name).first->second;
+}
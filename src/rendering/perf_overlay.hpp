@@ -0,0 +1,104 @@
+#pragma once
+#include "render_components.hpp"
+
+#include "entities/tiny_ecs.hpp"
+#include "profiling/profiler.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class ParticleSystem;
+class GpuTimer;
+class Font;
+
+// A panel in the top left corner with the frame time graph, the time spent per frame in every
+// profiled scope (the systems, the draw phases and the GPU passes), what was drawn, the entity and
+// component counts, the particles, the GL calls, VRAM and heap allocations. Toggled with F2.
+//
+// The text path draws one quad per glyph, so the text is only laid out every REFRESH_MS, into a
+// texture that is drawn as a single quad in between. The graph is a colored mesh updated every frame.
+// The overlay reports its own cost too, on the CPU and on the GPU ("gpu: overlay"), against a budget
+// of 0.2 ms per frame with the refreshes spread over the frames in between.
+class PerfOverlay
+{
+public:
+	// What the RenderSystem drew in the last frame
+	struct DrawStats
+	{
+		int sprites = 0;
+		int texts = 0;
+	};
+
+	static bool isVisible;
+
+	PerfOverlay() = default;
+	~PerfOverlay();
+	PerfOverlay(const PerfOverlay&) = delete;
+	PerfOverlay& operator=(const PerfOverlay&) = delete;
+
+	// Creates the GL resources, once the GL functions are loaded
+	void init();
+
+	// Called every frame, also while hidden so that the graph has a history when it's shown
+	void recordFrame();
+	// Draws onto the bound framebuffer, which is frameBufferSize pixels
+	void draw(ivec2 frameBufferSize, const DrawStats& drawStats, const ParticleSystem& particles, const GpuTimer& gpuTimer);
+
+private:
+	struct Line
+	{
+		std::string content;
+		vec2 position;
+		vec3 color;
+	};
+
+	// What draw() cost since the last refresh
+	struct OverlayCost
+	{
+		uint64_t cpuTicks = 0;
+		int cpuFrames = 0;
+		// Of the last refresh alone
+		uint64_t refreshTicks = 0;
+		float gpuMs = 0.f;
+		float worstGpuMs = 0.f;
+		int gpuFrames = 0;
+	};
+
+	static const int FRAME_HISTORY = 120;
+	static constexpr float REFRESH_MS = 250.f;
+
+	void refreshText(const DrawStats& drawStats, const ParticleSystem& particles, const GpuTimer& gpuTimer);
+	void sumProfiledScopes();
+	void renderText();
+	void drawGraph(const mat3& projection);
+	void drawTextQuad(const mat3& projection);
+	const std::string& componentName(ECS::ContainerInterface& container);
+
+	bool isInitialized = false;
+
+	// Frame times in ms, oldest first from frameIndex on
+	float frameTimes[FRAME_HISTORY] = {};
+	int frameIndex = 0;
+	uint64_t lastFrameTicks = 0;
+
+	// The graph and the background, as quads of colored vertices
+	ShadedMesh graph;
+
+	// The text, rendered into a texture that the quad shows
+	GLuint textTexture = 0;
+	GLuint textFrameBuffer = 0;
+	ShadedMesh textQuad;
+	std::shared_ptr<Font> font;
+	std::vector<Line> lines;
+
+	// Since the last refresh
+	float msSinceRefresh = REFRESH_MS;
+	int framesSinceRefresh = 0;
+	uint64_t firstSample = 0;
+	std::vector<Profiler::Sample> samples;
+	std::vector<std::pair<const char*, uint64_t>> scopeTicks;
+	OverlayCost cost;
+
+	std::unordered_map<unsigned int, std::string> componentNames;
+};
@@ -11,14 +11,16 @@
 #include "game/camera.hpp"
 #include "game/game_state_system.hpp"
 #include "maps/map_objects.hpp"
+#include "memory/frame_arena.hpp"
+#include "profiling/profiler.hpp"
 
 #include <iostream>
 
 void RenderSystem::drawTexturedMesh(ECS::Entity entity, const mat3& projection)
 {
 	assert(entity.has<Motion>());
-	auto& motion = ECS::registry<Motion>.get(entity);
-	auto& texmesh = *ECS::registry<ShadedMeshRef>.get(entity).reference_to_cache;
+	auto& motion = ECS::registry<Motion>().get(entity);
+	auto& texmesh = *ECS::registry<ShadedMeshRef>().get(entity).reference_to_cache;
 	// Transformation code, see Rendering and Transformation in the template specification for more info
 	// Incrementally updates transformation matrix, thus ORDER IS IMPORTANT
 	Transform transform;
@@ -26,7 +28,7 @@ void RenderSystem::drawTexturedMesh(ECS::Entity entity, const mat3& projection)
 			transform.translate(motion.renderPosition);
 	}
 	else {
-			auto camera = ECS::registry<CameraComponent>.entities[0];
+			auto camera = ECS::registry<CameraComponent>().entities[0];
 			auto& cameraComponent = camera.get<CameraComponent>();
 			// Multiply camera positon by scroll rate for parallax entities
 			if (entity.has<ParallaxComponent>()) {
@@ -250,7 +252,7 @@ void RenderSystem::drawAnimatedMesh(ECS::Entity entity, const mat3& projection)
 		transform.translate(motion.renderPosition);
 	}
 	else {
-		auto camera = ECS::registry<CameraComponent>.entities[0];
+		auto camera = ECS::registry<CameraComponent>().entities[0];
 		auto& cameraComponent = camera.get<CameraComponent>();
 		// Add skill fx offset to translate
 		if (entity.has<SkillFXData>()) {
@@ -312,9 +314,9 @@ void RenderSystem::drawAnimatedMesh(ECS::Entity entity, const mat3& projection)
 	}
 
 	// add animation offset
-	transform.translate(anims.currAnimData->offset);
+	transform.translate(anims.displayedAnimData->offset);
 
-	float frame = (float)anims.currAnimData->currFrame;
+	float frame = (float)anims.displayedAnimData->currFrame;
 	glUniform1f(frame_uloc, frame);
 
 	// texture_id stores a 2d array texture instead
@@ -395,7 +397,7 @@ void RenderSystem::drawToScreen()
 	GLuint time_uloc       = glGetUniformLocation(screen_sprite.effect.program, "time");
 	GLuint dead_timer_uloc = glGetUniformLocation(screen_sprite.effect.program, "darken_screen_factor");
 	glUniform1f(time_uloc, static_cast<float>(glfwGetTime() * 10.0f));
-	auto& screen = ECS::registry<ScreenState>.get(screen_state_entity);
+	auto& screen = ECS::registry<ScreenState>().get(screen_state_entity);
 	glUniform1f(dead_timer_uloc, screen.darken_screen_factor);
 	gl_has_errors();
 
@@ -466,6 +468,11 @@ void RenderSystem::draw(vec2 window_size_in_game_units)
 	ivec2 frame_buffer_size; // in pixels
 	glfwGetFramebufferSize(&window, &frame_buffer_size.x, &frame_buffer_size.y);
 
+	GLInstrumentation::endFrame();
+	gpuTimer.beginFrame();
+	overlay.recordFrame();
+	drawStats = PerfOverlay::DrawStats();
+
 	// First render to the custom framebuffer
 	glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
 	gl_has_errors();
@@ -491,39 +498,48 @@ void RenderSystem::draw(vec2 window_size_in_game_units)
 	mat3 projection_2D{ { sx, 0.f, 0.f },{ 0.f, sy, 0.f },{ tx, ty, 1.f } };
 
 	// List of entities to render
-	std::vector<ECS::Entity> entities = ECS::registry<RenderableComponent>.entities;
-	// Sort the entities depending on their render layer
-	std::sort(entities.begin(), entities.end(), CompareRenderableEntity());
+	const auto& renderables = ECS::registry<RenderableComponent>().entities;
+	FrameVector<ECS::Entity> entities(renderables.begin(), renderables.end());
+	{
+		PROFILE_SCOPE("draw: sort");
+		// Sort the entities depending on their render layer
+		std::sort(entities.begin(), entities.end(), CompareRenderableEntity());
+	}
 
-	for (ECS::Entity entity : entities)
 	{
-		if (!entity.has<Motion>())
-		{
-			continue;
-		}
-		if (entity.has<VisibilityComponent>())
+		PROFILE_SCOPE("draw: sprites");
+		GpuTimer::Scope gpuScope(gpuTimer, "gpu: sprites");
+		for (ECS::Entity entity : entities)
 		{
-			if (!entity.get<VisibilityComponent>().isVisible)
+			if (!entity.has<Motion>())
 			{
 				continue;
 			}
-		}
+			if (entity.has<VisibilityComponent>())
+			{
+				if (!entity.get<VisibilityComponent>().isVisible)
+				{
+					continue;
+				}
+			}
 
-		// Animated Meshes
-		if (entity.has<AnimationsComponent>())
-		{ 
-			drawAnimatedMesh(entity, projection_2D);
-		}
-		else // normal textured mesh
-		{
-			drawTexturedMesh(entity, projection_2D);
-		}
+			// Animated Meshes
+			if (entity.has<AnimationsComponent>())
+			{ 
+				drawAnimatedMesh(entity, projection_2D);
+			}
+			else // normal textured mesh
+			{
+				drawTexturedMesh(entity, projection_2D);
+			}
+			drawStats.sprites++;
 
-		gl_has_errors();
+			gl_has_errors();
+		}
 	}
 
-	assert(!ECS::registry<CameraComponent>.entities.empty());
-	auto camera = ECS::registry<CameraComponent>.entities[0];
+	assert(!ECS::registry<CameraComponent>().entities.empty());
+	auto camera = ECS::registry<CameraComponent>().entities[0];
 	auto& cameraComponent = camera.get<CameraComponent>();
 
 	// Draw text components to the screen
@@ -532,54 +548,46 @@ void RenderSystem::draw(vec2 window_size_in_game_units)
 	// for nearly all use cases. If you need text to appear behind meshes,
 	// consider using a depth buffer during rendering and adding a
 	// Z-component or depth index to all renderable components.
-	for (auto entity : ECS::registry<Text>.entities) {
-		Text& text = entity.get<Text>();
-		// Prevent damage numbers moving with the camera
-		if (entity.has<DamageNumberComponent>()) {
-			text.offset = -cameraComponent.position;
+	{
+		PROFILE_SCOPE("draw: text");
+		GpuTimer::Scope gpuScope(gpuTimer, "gpu: text");
+		for (auto entity : ECS::registry<Text>().entities) {
+			Text& text = entity.get<Text>();
+			// Prevent damage numbers moving with the camera
+			if (entity.has<DamageNumberComponent>()) {
+				text.offset = -cameraComponent.position;
+			}
+			drawText(text, window_size_in_game_units);
+			drawStats.texts++;
 		}
-		drawText(text, window_size_in_game_units);
 	}
 
-	particleSystem->drawParticles(projection_2D, cameraComponent.position);
-	// Truely render to the screen
-	drawToScreen();
+	{
+		PROFILE_SCOPE("draw: particles");
+		GpuTimer::Scope gpuScope(gpuTimer, "gpu: particles");
+		particleSystem->drawParticles(projection_2D, cameraComponent.position);
+	}
+	{
+		PROFILE_SCOPE("draw: post");
+		GpuTimer::Scope gpuScope(gpuTimer, "gpu: post");
+		// Truely render to the screen
+		drawToScreen();
+	}
+	if (PerfOverlay::isVisible)
+	{
+		PROFILE_SCOPE("draw: overlay");
+		GpuTimer::Scope gpuScope(gpuTimer, "gpu: overlay");
+		overlay.draw(frame_buffer_size, drawStats, *particleSystem, gpuTimer);
+	}
+
+	GLInstrumentation::checkFrame();
 
 	// flicker-free display with a double buffer
+	PROFILE_SCOPE("draw: swap");
 	glfwSwapBuffers(&window);
 }
 
 void gl_has_errors()
 {
-	GLenum error = glGetError();
-
-	if (error == GL_NO_ERROR)
-		return;
-	
-	const char* error_str = "";
-	while (error != GL_NO_ERROR)
-	{
-		switch (error)
-		{
-		case GL_INVALID_OPERATION:
-			error_str = "INVALID_OPERATION";
-			break;
-		case GL_INVALID_ENUM:
-			error_str = "INVALID_ENUM";
-			break;
-		case GL_INVALID_VALUE:
-			error_str = "INVALID_VALUE";
-			break;
-		case GL_OUT_OF_MEMORY:
-			error_str = "OUT_OF_MEMORY";
-			break;
-		case GL_INVALID_FRAMEBUFFER_OPERATION:
-			error_str = "INVALID_FRAMEBUFFER_OPERATION";
-			break;
-		}
-
-		std::cerr << "OpenGL:" << error_str << std::endl;
-		error = glGetError();
-	}
-	throw std::runtime_error("last OpenGL error:" + std::string(error_str));
+	GLInstrumentation::checkCall();
 }
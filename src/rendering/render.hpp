@@ -1,5 +1,7 @@
 #pragma once
 #include "render_components.hpp"
+#include "gpu_timer.hpp"
+#include "perf_overlay.hpp"
 
 #include "game/common.hpp"
 #include "entities/tiny_ecs.hpp"
@@ -35,6 +37,9 @@ public:
 	// Animations
 	static void createAnimatedSprite(ShadedMesh& sprite, int maxFrames, const std::string& texture_path, const std::string& shader_name);
 
+	// GPU time of the render passes of a recent frame
+	inline const GpuTimer& getGpuTimer() const { return gpuTimer; }
+
 private:
 	// Initialize the screeen texture used as intermediate render target
 	// The draw loop first renders to this texture, then it is used for the water shader
@@ -56,4 +61,8 @@ private:
 	ShadedMesh screen_sprite;
 	GLResource<RENDER_BUFFER> depth_render_buffer_id;
 	ECS::Entity screen_state_entity;
+
+	GpuTimer gpuTimer;
+	PerfOverlay overlay;
+	PerfOverlay::DrawStats drawStats;
 };
@@ -1,7 +1,9 @@
 #include "render_components.hpp"
 #include "render.hpp"
+#include "shader_registry.hpp"
+#include "image_cache.hpp"
+#include "resource_manager.hpp"
 
-#define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 // stlib
@@ -12,23 +14,6 @@
 #include <cassert>
 #include <filesystem>
 
-void gl_compile_shader(GLuint shader)
-{
-	glCompileShader(shader);
-	GLint success = 0;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-	if (success == GL_FALSE)
-	{
-		GLint log_len;
-		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_len);
-		std::vector<char> log(log_len);
-		glGetShaderInfoLog(shader, log_len, &log_len, log.data());
-		glDeleteShader(shader);
-		
-		throw std::runtime_error("GLSL: " + std::string(log.data()));
-	}
-}
-
 // specialized destructors for all OpenGL resources that we support as of now
 template<> GLResource<BUFFER>::~GLResource() noexcept{
 	if (resource > 0)
@@ -57,45 +42,24 @@ template<> GLResource<SHADER>::~GLResource() noexcept {
 
 void Texture::loadFromFile(const std::string& path)
 {
-	stbi_uc* data;
-	if (texture_cache.count(path) > 0)
-		data = texture_cache[path];
-	else
-		data  = stbi_load(path.c_str(), &size.x, &size.y, nullptr, 4);
-
-	if (data == nullptr)
-		throw std::runtime_error("data == NULL, failed to load texture");
+	auto image = ImageCache::instance().load(path);
+	size = image->size;
 	gl_has_errors();
 
 	glGenTextures(1, texture_id.data());
 	glBindTexture(GL_TEXTURE_2D, texture_id);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, image->pixels.get());
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	stbi_image_free(data);
 	gl_has_errors();
 }
 
 void Texture::loadPlayerSpecificTextures(const std::string& path)
 {
-	stbi_uc* data;
 	const std::vector<std::string> players { "raoul", "taji", "chia", "ember" };
-	std::string placeholder = path + "/raoul.png";
 
 	// load initial texture to define texture size
-	if (texture_cache.count(placeholder) > 0)
-	{
-		data = texture_cache[placeholder];
-	}
-	else
-	{
-		data = stbi_load(placeholder.c_str(), &size.x, &size.y, nullptr, 4);
-	}
-	if (data == nullptr)
-	{
-		throw std::runtime_error("data == NULL, failed to load texture");
-	}
-	stbi_image_free(data);
+	size = ImageCache::instance().load(path + "/raoul.png")->size;
 	gl_has_errors();
 
 	glActiveTexture(GL_TEXTURE1);
@@ -110,24 +74,9 @@ void Texture::loadPlayerSpecificTextures(const std::string& path)
 	// put each frame into a sub image
 	for (int i = 0; i < players.size(); ++i)
 	{
-		std::string imagePath = path + "/" + players[i] + ".png";
-		stbi_uc* data;
-
-		if (texture_cache.count(imagePath) > 0)
-		{
-			data = texture_cache[imagePath];
-		}
-		else
-		{
-			data = stbi_load(imagePath.c_str(), &size.x, &size.y, nullptr, 4);
-		}
-		if (data == nullptr)
-		{
-			throw std::runtime_error("data == NULL, failed to load texture");
-		}
-		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, size.x, size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
-		
-		stbi_image_free(data);
+		auto image = ImageCache::instance().load(path + "/" + players[i] + ".png");
+		size = image->size;
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, size.x, size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, image->pixels.get());
 		gl_has_errors();
 	}
 
@@ -142,23 +91,8 @@ void Texture::loadPlayerSpecificTextures(const std::string& path)
 void Texture::loadArrayFromFile(const std::string& path, int maxFrames)
 {
 	// path is expected to include up to each animation frame's name, not including the "_{frame-count}.png"
-	stbi_uc* data;
-	std::string firstFrame = path + "_000.png";
-
 	// we just gotta do this one to initialize texture with the image size...
-	if (texture_cache.count(firstFrame) > 0)
-	{
-		data = texture_cache[firstFrame];
-	}
-	else
-	{
-		data = stbi_load(firstFrame.c_str(), &size.x, &size.y, nullptr, 4);
-	}
-	if (data == nullptr)
-	{
-		throw std::runtime_error("data == NULL, failed to load texture");
-	}
-	stbi_image_free(data);
+	size = ImageCache::instance().load(framePath(path, 0))->size;
 	gl_has_errors();
 	
 	glActiveTexture(GL_TEXTURE0);
@@ -173,33 +107,9 @@ void Texture::loadArrayFromFile(const std::string& path, int maxFrames)
 	// put each frame into a sub image
 	for (int i = 0; i < frames; ++i)
 	{
-		std::string framePath = path + "_00" + std::to_string(i) + ".png";
-		if (i >= 10) 
-		{
-			framePath = path + "_0" + std::to_string(i) + ".png";
-		}
-		if (i >= 100)
-		{
-			framePath = path + "_" + std::to_string(i) + ".png";
-		}
-
-		stbi_uc* data;
-		if (texture_cache.count(framePath) > 0)
-		{
-			data = texture_cache[framePath];
-		}
-		else
-		{
-			data = stbi_load(framePath.c_str(), &size.x, &size.y, nullptr, 4);
-		}
-		if (data == nullptr)
-		{
-			throw std::runtime_error("data == NULL, failed to load texture");
-		}
-
-		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, size.x, size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
-
-		stbi_image_free(data);
+		auto image = ImageCache::instance().load(framePath(path, i));
+		size = image->size;
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, size.x, size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, image->pixels.get());
 		gl_has_errors();
 	}
 
@@ -248,51 +158,7 @@ bool Texture::isValid() const
 
 void Effect::loadFromFile(const std::string& vs_path, const std::string& fs_path)
 {
-	// Opening files
-	std::ifstream vs_is(vs_path);
-	std::ifstream fs_is(fs_path);
-	if (!vs_is.good() || !fs_is.good())
-		throw("Failed to load shader files " + vs_path +", "+ fs_path);
-
-	// Reading sources
-	std::stringstream vs_ss, fs_ss;
-	vs_ss << vs_is.rdbuf();
-	fs_ss << fs_is.rdbuf();
-	std::string vs_str = vs_ss.str();
-	std::string fs_str = fs_ss.str();
-	const char* vs_src = vs_str.c_str();
-	const char* fs_src = fs_str.c_str();
-	GLsizei vs_len = (GLsizei)vs_str.size();
-	GLsizei fs_len = (GLsizei)fs_str.size();
-
-	vertex = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertex, 1, &vs_src, &vs_len);
-	fragment = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragment, 1, &fs_src, &fs_len);
-
-	// Compiling
-	gl_compile_shader(vertex);
-	gl_compile_shader(fragment);
-
-	// Linking
-	program = glCreateProgram();
-	glAttachShader(program, vertex);
-	glAttachShader(program, fragment);
-	glLinkProgram(program);
-	{
-		GLint is_linked = 0;
-		glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
-		if (is_linked == GL_FALSE)
-		{
-			GLint log_len;
-			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_len);
-			std::vector<char> log(log_len);
-			glGetProgramInfoLog(program, log_len, &log_len, log.data());
-
-			throw std::runtime_error("Link error: "+ std::string(log.data()));
-		}
-	}
-	gl_has_errors();
+	program = ShaderRegistry::instance().getProgram(vs_path, fs_path);
 }
 
 namespace {
@@ -401,29 +267,3 @@ void Mesh::loadFromOBJFile(const std::string& obj_path) {
 		pos.position = ((pos.position - min_position) / extent) - vec3(0.5f, 0.5f, 0.0f);
 	}
 }
-
-// Returns a resource for every key, initializing with zero on the first query
-ShadedMesh& cacheResource(std::string key)
-{
-	static std::unordered_map<std::string, ShadedMesh> resource_cache;
-	const auto it = resource_cache.find(key);
-	if (it == resource_cache.end())
-	{
-		const auto it_succeeded = resource_cache.emplace(key, ShadedMesh{});
-		assert(it_succeeded.second);
-		return it_succeeded.first->second;
-	}
-	return it->second;
-}
-
-ShadedMeshRef::ShadedMeshRef(ShadedMesh& mesh) : 
-	reference_to_cache(&mesh) 
-{};
-
-RenderableComponent::RenderableComponent(RenderLayer layer) {
-	this->layer = layer;
-}
-
-void DeathTimer::CustomDeathTimer(float counter_ms) {
-	this->counter_ms = counter_ms;
-}
\ No newline at end of file
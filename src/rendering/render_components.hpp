@@ -1,5 +1,6 @@
 #pragma once
 #include "game/common.hpp"
+#include "gl_instrumentation.hpp"
 
 #include <vector>
 #include <unordered_map>
@@ -111,16 +112,16 @@ struct Texture
 	void loadArrayFromFile(const std::string& path, int maxFrames);
 	void loadPlayerSpecificTextures(const std::string& path);
 
-	std::unordered_map<std::string, stbi_uc*> texture_cache;
+	// File name of one frame of an animation, i.e. path + "_{frame-count}.png"
+	static std::string framePath(const std::string& path, int frame);
 };
 
 // Effect component for Vertex and Fragment shader, which are then put(linked) together in a
 // single program that is then bound to the pipeline.
+// The program itself is owned (and shared between effects) by the ShaderRegistry.
 struct Effect
 {
-	GLResource<SHADER> vertex;
-	GLResource<SHADER> fragment;
-	GLResource<PROGRAM> program;
+	GLuint program = 0;
 
 	void loadFromFile(const std::string& vs_path, const std::string& fs_path); // load shaders from files and link into program
 };
@@ -151,14 +152,44 @@ struct ShadedMesh
 	Texture texture;
 };
 
+// Interned key of a cached resource, resolved once (e.g. into a function-local static) so that
+// looking the resource up afterwards is a plain array index, without hashing strings
+struct ResourceId
+{
+	static constexpr uint32_t INVALID = ~0u;
+	uint32_t index = INVALID;
+
+	bool isValid() const { return index != INVALID; }
+	bool operator==(const ResourceId& other) const { return index == other.index; }
+	bool operator!=(const ResourceId& other) const { return index != other.index; }
+};
+
+// Returns the id for a resource key, registering it on the first query
+ResourceId internResource(const std::string& key);
+
 // Cache for ShadedMesh resources (mesh consisting of vertex and index buffer, the vertex and fragment shaders, and the texture)
-ShadedMesh& cacheResource(std::string key);
+// The resources are owned by the ResourceManager, see resource_manager.hpp
+ShadedMesh& cacheResource(ResourceId id);
+ShadedMesh& cacheResource(const std::string& key);
+
+struct ResourceEntry;
 
 // A wrapper that points to the ShadedMesh in the resource_cache
+// Holds a reference on the cached resource, so that it isn't evicted while in use
 struct ShadedMeshRef
 {
-	ShadedMesh* reference_to_cache;
+	ShadedMesh* reference_to_cache = nullptr;
+
+	ShadedMeshRef() = default;
+	ShadedMeshRef(ResourceId id);
 	ShadedMeshRef(ShadedMesh& mesh);
+	ShadedMeshRef(const ShadedMeshRef& other);
+	ShadedMeshRef(ShadedMeshRef&& other) noexcept;
+	ShadedMeshRef& operator=(ShadedMeshRef other) noexcept;
+	~ShadedMeshRef();
+
+private:
+	ResourceEntry* entry = nullptr;
 };
 
 // A struct to refer to debugging graphics in the ECS
@@ -171,7 +202,7 @@ struct DebugComponent
 struct DeathTimer
 {
 	float counter_ms = 1500;
-	void CustomDeathTimer(float counter_ms);
+	void CustomDeathTimer(float counter_ms) { this->counter_ms = counter_ms; }
 };
 
 struct ColourShift
@@ -189,7 +220,7 @@ struct VisibilityComponent
 struct RenderableComponent
 {
 	RenderLayer layer;
-	RenderableComponent(RenderLayer layer);
+	RenderableComponent(RenderLayer layer) : layer(layer) {}
 };
 
 struct DistendableComponent
@@ -1,5 +1,6 @@
 #include "render.hpp"
 #include "render_components.hpp"
+#include "resource_manager.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -16,6 +17,7 @@ RenderSystem::RenderSystem(GLFWwindow& window, ParticleSystem* particle) :
 
 	// Load OpenGL function pointers
 	gl3w_init();
+	GLInstrumentation::init();
 
 	// Create a frame buffer
 	frame_buffer = 0;
@@ -24,6 +26,8 @@ RenderSystem::RenderSystem(GLFWwindow& window, ParticleSystem* particle) :
 
 	initScreenTexture();
 	this->particleSystem->initParticles();
+	gpuTimer.init();
+	overlay.init();
 }
 
 RenderSystem::~RenderSystem()
@@ -32,10 +36,10 @@ RenderSystem::~RenderSystem()
 	glDeleteFramebuffers(1, &frame_buffer);
 
 	// remove all entities created by the render system
-	while (!ECS::registry<Motion>.entities.empty())
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<Motion>.entities.back());
-	while (!ECS::registry<ShadedMeshRef>.entities.empty())
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ShadedMeshRef>.entities.back());
+	while (!ECS::registry<Motion>().entities.empty())
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<Motion>().entities.back());
+	while (!ECS::registry<ShadedMeshRef>().entities.empty())
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ShadedMeshRef>().entities.back());
 }
 
 // Create a new sprite and register it with ECS
@@ -77,6 +81,9 @@ void RenderSystem::createSprite(ShadedMesh& sprite, const std::string& texture_p
 
 	// Loading shaders
 	sprite.effect.loadFromFile(shaderPath(shader_name) + ".vs.glsl", shaderPath(shader_name) + ".fs.glsl");
+
+	if (texture_path.length() > 0)
+		ResourceManager::instance().recordBuild(sprite, { ResourceBuildType::SPRITE, texture_path, shader_name });
 }
 
 void RenderSystem::createTexturedMesh(ShadedMesh& sprite, const std::string& texture_path, const std::string& shader_name)
@@ -156,6 +163,9 @@ void RenderSystem::createAnimatedSprite(ShadedMesh& sprite, int maxFrames, const
 	// Loading shaders
 	sprite.effect.loadFromFile(shaderPath(shader_name) + ".vs.glsl", shaderPath(shader_name) + ".fs.glsl");
 	gl_has_errors();
+
+	if (texture_path.length() > 0)
+		ResourceManager::instance().recordBuild(sprite, { ResourceBuildType::ANIMATED_SPRITE, texture_path, shader_name, maxFrames });
 }
 
 // Calls loadArrayFromFile to create a 2D Array texture instead
@@ -202,6 +212,9 @@ void RenderSystem::createPlayerSpecificMesh(ShadedMesh& sprite, const std::strin
 	// Loading shaders
 	sprite.effect.loadFromFile(shaderPath(shader_name) + ".vs.glsl", shaderPath(shader_name) + ".fs.glsl");
 	gl_has_errors();
+
+	if (texture_path.length() > 0)
+		ResourceManager::instance().recordBuild(sprite, { ResourceBuildType::PLAYER_SPECIFIC, texture_path, shader_name });
 }
 
 // Load a new mesh from disc and register it with ECS
@@ -241,5 +254,6 @@ void RenderSystem::initScreenTexture()
 
 	// Initialize the screen texture and its state
 	screen_sprite.texture.createFromScreen(&window, depth_render_buffer_id.data());
-	ECS::registry<ScreenState>.emplace(screen_state_entity);
+	screen_state_entity = ECS::Entity::create();
+	ECS::registry<ScreenState>().emplace(screen_state_entity);
 }
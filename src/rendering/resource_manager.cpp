@@ -0,0 +1,338 @@
+#include "resource_manager.hpp"
+#include "render.hpp"
+
+#include "profiling/profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+	// Per thread, since every thread creates the entities of its own world
+	thread_local std::vector<std::string> groupStack;
+}
+
+ResourceManager::ScopedGroup::ScopedGroup(const std::string& group)
+{
+	groupStack.push_back(group);
+}
+
+ResourceManager::ScopedGroup::~ScopedGroup()
+{
+	groupStack.pop_back();
+}
+
+ResourceId ResourceManager::intern(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto it = ids.find(key);
+	if (it != ids.end())
+		return it->second;
+
+	ResourceId id;
+	id.index = static_cast<uint32_t>(entries.size());
+	entries.push_back(std::make_unique<ResourceEntry>());
+	entries.back()->id = id;
+	entries.back()->key = key;
+	ids.emplace(key, id);
+	return id;
+}
+
+const std::string& ResourceManager::keyOf(ResourceId id) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return entries[id.index]->key;
+}
+
+ShadedMesh& ResourceManager::get(ResourceId id)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	assert(id.index < entries.size());
+	auto& entry = *entries[id.index];
+	tagWithCurrentGroup(entry);
+
+	// Either the first query or the resource was evicted; the caller is expected to (re)build it
+	return makeResident(entry);
+}
+
+void ResourceManager::tag(ResourceId id)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	assert(id.index < entries.size());
+	tagWithCurrentGroup(*entries[id.index]);
+}
+
+ShadedMesh& ResourceManager::getDeferred(ResourceId id)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	assert(id.index < entries.size());
+	return makeResident(*entries[id.index]);
+}
+
+bool ResourceManager::isBuilt(ResourceId id) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	assert(id.index < entries.size());
+	const auto& mesh = entries[id.index]->mesh;
+	return mesh && mesh->effect.program != 0;
+}
+
+ShadedMesh& ResourceManager::makeResident(ResourceEntry& entry)
+{
+	if (!entry.mesh)
+	{
+		entry.mesh = std::make_unique<ShadedMesh>();
+		entryByMesh[entry.mesh.get()] = &entry;
+	}
+	return *entry.mesh;
+}
+
+ResourceEntry* ResourceManager::acquire(ResourceId id)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	assert(id.index < entries.size() && entries[id.index]->mesh);
+	auto entry = entries[id.index].get();
+	entry->refCount++;
+	return entry;
+}
+
+ResourceEntry* ResourceManager::acquire(ShadedMesh& mesh)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto it = entryByMesh.find(&mesh);
+	if (it == entryByMesh.end())
+		return nullptr;
+
+	it->second->refCount++;
+	return it->second;
+}
+
+void ResourceManager::release(ResourceEntry* entry)
+{
+	if (entry == nullptr)
+		return;
+
+	assert(entry->refCount > 0);
+	entry->refCount--;
+}
+
+void ResourceManager::recordBuild(ShadedMesh& mesh, ResourceBuildInfo build)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto it = entryByMesh.find(&mesh);
+	if (it != entryByMesh.end())
+		it->second->build = std::move(build);
+}
+
+std::vector<std::string> ResourceManager::groupsForLevel(const json& level)
+{
+	std::vector<std::string> groups;
+	if (level.contains("map"))
+		groups.push_back("map:" + level["map"].get<std::string>());
+
+	if (level.contains("mobs"))
+	{
+		for (const auto& mob : level["mobs"])
+			groups.push_back("mob:" + mob["type"].get<std::string>());
+	}
+	return groups;
+}
+
+void ResourceManager::evictUnused(const std::vector<std::string>& neededGroups)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t numEvicted = 0;
+	size_t bytesEvicted = 0;
+
+	for (auto& entryPtr : entries)
+	{
+		auto& entry = *entryPtr;
+
+		// Only resources that can be rebuilt are ever evicted
+		if (!entry.mesh || entry.pinned || entry.refCount > 0 || entry.build.type == ResourceBuildType::NONE)
+			continue;
+		if (isNeeded(entry, neededGroups))
+			continue;
+
+		numEvicted++;
+		bytesEvicted += estimateVRAM(entry);
+		entryByMesh.erase(entry.mesh.get());
+		entry.mesh.reset();
+	}
+
+	std::cout << "ResourceManager::evictUnused: evicted " << numEvicted << " resources ("
+		<< bytesEvicted / 1024 << " KB)" << std::endl;
+}
+
+void ResourceManager::prefetch(const std::vector<std::string>& groups)
+{
+	PROFILE_SCOPE("prefetch resources");
+	// Not locked while building, since the RenderSystem records the build
+	std::vector<std::pair<ShadedMesh*, ResourceBuildInfo>> toBuild;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& entryPtr : entries)
+		{
+			auto& entry = *entryPtr;
+			if (entry.mesh || entry.build.type == ResourceBuildType::NONE || !isNeeded(entry, groups))
+				continue;
+			toBuild.push_back({ &makeResident(entry), entry.build });
+		}
+	}
+
+	for (auto& item : toBuild)
+	{
+		ShadedMesh& mesh = *item.first;
+		const ResourceBuildInfo& build = item.second;
+		switch (build.type)
+		{
+		case ResourceBuildType::SPRITE:
+			RenderSystem::createSprite(mesh, build.texturePath, build.shaderName);
+			break;
+		case ResourceBuildType::ANIMATED_SPRITE:
+			RenderSystem::createAnimatedSprite(mesh, build.frames, build.texturePath, build.shaderName);
+			break;
+		case ResourceBuildType::PLAYER_SPECIFIC:
+			RenderSystem::createPlayerSpecificMesh(mesh, build.texturePath, build.shaderName);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+size_t ResourceManager::estimateVRAM(const ResourceEntry& entry)
+{
+	if (!entry.mesh)
+		return 0;
+
+	const auto& texture = entry.mesh->texture;
+	size_t layers = entry.build.type == ResourceBuildType::PLAYER_SPECIFIC ? 4 : std::max(1, texture.frames);
+	size_t textureBytes = static_cast<size_t>(texture.size.x) * texture.size.y * 4 * layers;
+
+	// Sprites are a single quad; OBJ meshes keep a copy of their vertices on the CPU side
+	size_t meshBytes = entry.mesh->mesh.vertices.empty()
+		? 4 * sizeof(TexturedVertex) + 6 * sizeof(uint16_t)
+		: entry.mesh->mesh.vertices.size() * sizeof(ColoredVertex) + entry.mesh->mesh.vertex_indices.size() * sizeof(uint16_t);
+
+	return textureBytes + meshBytes;
+}
+
+size_t ResourceManager::totalVRAM() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t total = 0;
+	for (const auto& entry : entries)
+		total += estimateVRAM(*entry);
+	return total;
+}
+
+void ResourceManager::printResidency() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<const ResourceEntry*> resident;
+	size_t total = 0;
+	for (const auto& entry : entries)
+	{
+		if (entry->mesh)
+		{
+			resident.push_back(entry.get());
+			total += estimateVRAM(*entry);
+		}
+	}
+	std::sort(resident.begin(), resident.end(), [](const ResourceEntry* a, const ResourceEntry* b) {
+		return estimateVRAM(*a) > estimateVRAM(*b);
+	});
+
+	std::cout << "Resident GPU resources (" << resident.size() << " of " << entries.size() << "):\n";
+	for (auto entry : resident)
+	{
+		std::cout << "  " << std::setw(10) << estimateVRAM(*entry) / 1024 << " KB  refs " << std::setw(3) << entry->refCount
+			<< "  " << entry->key << (entry->pinned ? " [pinned]" : "");
+		for (const auto& group : entry->groups)
+			std::cout << " " << group;
+		std::cout << '\n';
+	}
+	std::cout << "  total: " << total / (1024 * 1024) << " MB" << std::endl;
+}
+
+bool ResourceManager::isNeeded(const ResourceEntry& entry, const std::vector<std::string>& neededGroups) const
+{
+	for (const auto& group : entry.groups)
+	{
+		if (std::find(neededGroups.begin(), neededGroups.end(), group) != neededGroups.end())
+			return true;
+	}
+	return false;
+}
+
+void ResourceManager::tagWithCurrentGroup(ResourceEntry& entry)
+{
+	if (entry.pinned)
+		return;
+
+	if (groupStack.empty())
+	{
+		entry.pinned = true;
+		entry.groups.clear();
+		return;
+	}
+
+	const auto& group = groupStack.back();
+	if (std::find(entry.groups.begin(), entry.groups.end(), group) == entry.groups.end())
+		entry.groups.push_back(group);
+}
+
+ResourceId internResource(const std::string& key)
+{
+	return ResourceManager::instance().intern(key);
+}
+
+// Returns a resource for every key, initializing with zero on the first query
+ShadedMesh& cacheResource(ResourceId id)
+{
+	return ResourceManager::instance().get(id);
+}
+
+ShadedMesh& cacheResource(const std::string& key)
+{
+	return ResourceManager::instance().get(internResource(key));
+}
+
+ShadedMeshRef::ShadedMeshRef(ResourceId id) :
+	entry(ResourceManager::instance().acquire(id))
+{
+	reference_to_cache = entry->mesh.get();
+}
+
+ShadedMeshRef::ShadedMeshRef(ShadedMesh& mesh) : 
+	reference_to_cache(&mesh),
+	entry(ResourceManager::instance().acquire(mesh))
+{};
+
+ShadedMeshRef::ShadedMeshRef(const ShadedMeshRef& other) :
+	reference_to_cache(other.reference_to_cache),
+	entry(other.entry)
+{
+	if (entry)
+		entry->refCount++;
+}
+
+ShadedMeshRef::ShadedMeshRef(ShadedMeshRef&& other) noexcept :
+	reference_to_cache(std::exchange(other.reference_to_cache, nullptr)),
+	entry(std::exchange(other.entry, nullptr))
+{}
+
+ShadedMeshRef& ShadedMeshRef::operator=(ShadedMeshRef other) noexcept
+{
+	std::swap(reference_to_cache, other.reference_to_cache);
+	std::swap(entry, other.entry);
+	return *this;
+}
+
+ShadedMeshRef::~ShadedMeshRef()
+{
+	ResourceManager::instance().release(entry);
+}
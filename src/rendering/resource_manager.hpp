@@ -0,0 +1,111 @@
+#pragma once
+#include "render_components.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// How a cached resource was built, so that it can be rebuilt after eviction
+enum class ResourceBuildType { NONE, SPRITE, ANIMATED_SPRITE, PLAYER_SPECIFIC };
+
+struct ResourceBuildInfo
+{
+	ResourceBuildType type = ResourceBuildType::NONE;
+	std::string texturePath;
+	std::string shaderName;
+	int frames = 1;
+};
+
+struct ResourceEntry
+{
+	ResourceId id;
+	std::string key;
+	std::unique_ptr<ShadedMesh> mesh; // null while evicted
+	std::atomic<int> refCount{ 0 }; // ShadedMeshRefs are copied and destroyed without locking
+	bool pinned = false;
+	std::vector<std::string> groups;
+	ResourceBuildInfo build;
+};
+
+// Owns the ShadedMesh resources handed out by cacheResource() and decides which of them
+// stay resident in GPU memory.
+//
+// Every resource is tagged with the groups that were active when it was requested, e.g.
+// "map:bbq" or "mob:egg" (see ScopedGroup). Resources requested outside of any group are
+// pinned and never evicted. On a map transition, resources that are no longer referenced
+// by any ShadedMeshRef and aren't needed by the new (or next) level are released, and the
+// next level's resources are prefetched so that its creation doesn't stall on disk loads.
+//
+// The resources are shared by every ECS::World, so the manager is locked for battles simulated on
+// other threads. Building a resource returned by cacheResource() isn't: a batch of simulated battles
+// plays one of them alone first, so that the others only find built resources.
+class ResourceManager
+{
+public:
+	// Tags every resource requested on the calling thread during its lifetime with the given group
+	struct ScopedGroup
+	{
+		ScopedGroup(const std::string& group);
+		~ScopedGroup();
+	};
+
+	// Returns the singleton instance of this manager. It is intentionally never destroyed, so that
+	// components destroyed during static destruction can still drop their references safely.
+	static ResourceManager& instance()
+	{
+		static ResourceManager* resourceManager = new ResourceManager();
+		return *resourceManager;
+	}
+
+	// Returns the id for `key`, registering it on the first query
+	ResourceId intern(const std::string& key);
+	const std::string& keyOf(ResourceId id) const;
+
+	// Returns the resource for `id`, creating an empty one on the first query or after eviction
+	ShadedMesh& get(ResourceId id);
+
+	// For resources that are built some time after being requested (see AnimationLoader):
+	// tag() records the current group up front, and getDeferred() is get() without the tagging.
+	void tag(ResourceId id);
+	ShadedMesh& getDeferred(ResourceId id);
+	bool isBuilt(ResourceId id) const;
+
+	// Reference counting, used by ShadedMeshRef. Meshes that aren't managed here are ignored.
+	ResourceEntry* acquire(ResourceId id);
+	ResourceEntry* acquire(ShadedMesh& mesh);
+	void release(ResourceEntry* entry);
+
+	// Called by the RenderSystem::create* functions once a mesh has been built
+	void recordBuild(ShadedMesh& mesh, ResourceBuildInfo build);
+
+	// Groups needed by a level from data/levels/*.json
+	static std::vector<std::string> groupsForLevel(const json& level);
+
+	// Releases every unreferenced resource that isn't needed by the given groups
+	void evictUnused(const std::vector<std::string>& neededGroups);
+	// Rebuilds evicted resources belonging to the given groups
+	void prefetch(const std::vector<std::string>& groups);
+
+	// Estimated GPU memory used by a resident resource
+	static size_t estimateVRAM(const ResourceEntry& entry);
+	size_t totalVRAM() const;
+	void printResidency() const;
+
+private:
+	ResourceManager() = default;
+	ResourceManager(const ResourceManager&) = delete;
+	ResourceManager& operator=(const ResourceManager&) = delete;
+
+	ShadedMesh& makeResident(ResourceEntry& entry);
+	bool isNeeded(const ResourceEntry& entry, const std::vector<std::string>& neededGroups) const;
+	void tagWithCurrentGroup(ResourceEntry& entry);
+
+	// Dense storage indexed by ResourceId; the entries themselves never move
+	std::vector<std::unique_ptr<ResourceEntry>> entries;
+	std::unordered_map<std::string, ResourceId> ids;
+	std::unordered_map<const ShadedMesh*, ResourceEntry*> entryByMesh;
+	mutable std::mutex mutex;
+};
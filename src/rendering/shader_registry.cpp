@@ -0,0 +1,259 @@
+#include "shader_registry.hpp"
+#include "render.hpp"
+
+// stlib
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+namespace
+{
+	const uint32_t BINARY_CACHE_MAGIC = 0x53424d41; // "AMBS"
+	const uint32_t BINARY_CACHE_VERSION = 1;
+
+	// Written in front of every cached program binary
+	struct BinaryCacheHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;
+		uint32_t format;
+		uint32_t length;
+	};
+
+	inline std::string shaderCachePath() { return dataPath() + "/shader_cache"; }
+
+	// 64-bit FNV-1a, which is plenty for telling shader sources apart
+	uint64_t hashString(const std::string& str, uint64_t hash = 14695981039346656037ull)
+	{
+		for (unsigned char c : str)
+		{
+			hash ^= c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	std::string toHex(uint64_t value)
+	{
+		std::stringstream ss;
+		ss << std::hex << value;
+		return ss.str();
+	}
+
+	std::string readFile(const std::string& path)
+	{
+		std::ifstream is(path);
+		if (!is.good())
+			throw std::runtime_error("Failed to load shader file " + path);
+
+		std::stringstream ss;
+		ss << is.rdbuf();
+		return ss.str();
+	}
+
+	void makeDirectory(const std::string& path)
+	{
+#ifdef _WIN32
+		_mkdir(path.c_str());
+#else
+		mkdir(path.c_str(), 0755);
+#endif
+	}
+
+	void gl_compile_shader(GLuint shader)
+	{
+		glCompileShader(shader);
+		GLint success = 0;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+		if (success == GL_FALSE)
+		{
+			GLint log_len;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_len);
+			std::vector<char> log(log_len);
+			glGetShaderInfoLog(shader, log_len, &log_len, log.data());
+
+			throw std::runtime_error("GLSL: " + std::string(log.data()));
+		}
+	}
+
+	// Drains the GL error queue, used when a failed binary upload is expected and recoverable
+	void gl_clear_errors()
+	{
+		while (glGetError() != GL_NO_ERROR) {}
+	}
+}
+
+GLuint ShaderRegistry::getProgram(const std::string& vs_path, const std::string& fs_path)
+{
+	const std::string key = vs_path + "|" + fs_path;
+	const auto it = programs.find(key);
+	if (it != programs.end())
+		return it->second;
+
+	const std::string vs_src = readFile(vs_path);
+	const std::string fs_src = readFile(fs_path);
+	const uint64_t source_hash = hashString(fs_src, hashString(vs_src));
+
+	GLuint program = 0;
+	std::string cache_path;
+	if (binaryCacheSupported())
+	{
+		cache_path = binaryCachePath(vs_src, fs_src);
+		program = loadBinary(cache_path, source_hash);
+	}
+
+	if (program == 0)
+	{
+		program = compileAndLink(vs_src, fs_src);
+		if (!cache_path.empty())
+			saveBinary(cache_path, source_hash, program);
+	}
+
+	gl_has_errors();
+	return programs.emplace(key, program).first->second;
+}
+
+void ShaderRegistry::clear()
+{
+	programs.clear();
+}
+
+GLuint ShaderRegistry::compileAndLink(const std::string& vs_src, const std::string& fs_src)
+{
+	const char* vs_c_str = vs_src.c_str();
+	const char* fs_c_str = fs_src.c_str();
+	GLsizei vs_len = (GLsizei)vs_src.size();
+	GLsizei fs_len = (GLsizei)fs_src.size();
+
+	// The shader objects are only needed until the program is linked
+	GLResource<SHADER> vertex = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(vertex, 1, &vs_c_str, &vs_len);
+	GLResource<SHADER> fragment = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(fragment, 1, &fs_c_str, &fs_len);
+
+	// Compiling
+	gl_compile_shader(vertex);
+	gl_compile_shader(fragment);
+
+	// Linking
+	GLResource<PROGRAM> program = glCreateProgram();
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	if (binaryCacheSupported())
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(program);
+	{
+		GLint is_linked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+		if (is_linked == GL_FALSE)
+		{
+			GLint log_len;
+			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_len);
+			std::vector<char> log(log_len);
+			glGetProgramInfoLog(program, log_len, &log_len, log.data());
+
+			throw std::runtime_error("Link error: " + std::string(log.data()));
+		}
+	}
+	glDetachShader(program, vertex);
+	glDetachShader(program, fragment);
+	gl_has_errors();
+
+	return std::exchange(program.resource, 0);
+}
+
+bool ShaderRegistry::binaryCacheSupported()
+{
+	if (binary_cache_support < 0)
+	{
+		GLint num_formats = 0;
+		if (gl3wGetProgramBinary != nullptr && gl3wProgramBinary != nullptr)
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+		gl_clear_errors();
+
+		binary_cache_support = num_formats > 0 ? 1 : 0;
+		if (binary_cache_support)
+		{
+			// Binaries are only valid for the exact driver that produced them
+			driver_string = std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + "|" +
+				std::string(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) + "|" +
+				std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+			makeDirectory(shaderCachePath());
+		}
+	}
+	return binary_cache_support == 1;
+}
+
+std::string ShaderRegistry::binaryCachePath(const std::string& vs_src, const std::string& fs_src)
+{
+	uint64_t hash = hashString(driver_string);
+	hash = hashString(vs_src, hash);
+	hash = hashString(fs_src, hash);
+	return shaderCachePath() + "/" + toHex(hash) + ".bin";
+}
+
+GLuint ShaderRegistry::loadBinary(const std::string& cache_path, uint64_t source_hash)
+{
+	std::ifstream is(cache_path, std::ios::binary);
+	if (!is.good())
+		return 0;
+
+	BinaryCacheHeader header;
+	is.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!is || header.magic != BINARY_CACHE_MAGIC || header.version != BINARY_CACHE_VERSION ||
+		header.sourceHash != source_hash || header.length == 0)
+	{
+		return 0;
+	}
+
+	std::vector<char> binary(header.length);
+	is.read(binary.data(), header.length);
+	if (!is)
+		return 0;
+
+	GLResource<PROGRAM> program = glCreateProgram();
+	glProgramBinary(program, header.format, binary.data(), header.length);
+
+	// A driver update can silently invalidate a binary, in which case we just recompile
+	GLint is_linked = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+	if (is_linked == GL_FALSE)
+	{
+		gl_clear_errors();
+		std::cout << "ShaderRegistry: stale program binary " << cache_path << ", recompiling" << std::endl;
+		return 0;
+	}
+
+	return std::exchange(program.resource, 0);
+}
+
+void ShaderRegistry::saveBinary(const std::string& cache_path, uint64_t source_hash, GLuint program)
+{
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+	{
+		gl_clear_errors();
+		return;
+	}
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(program, length, &length, &format, binary.data());
+	gl_has_errors();
+
+	std::ofstream os(cache_path, std::ios::binary | std::ios::trunc);
+	if (!os.good())
+		return;
+
+	BinaryCacheHeader header { BINARY_CACHE_MAGIC, BINARY_CACHE_VERSION, source_hash, format, (uint32_t)length };
+	os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	os.write(binary.data(), length);
+}
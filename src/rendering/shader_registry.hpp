@@ -0,0 +1,49 @@
+#pragma once
+#include "render_components.hpp"
+
+#include <string>
+#include <unordered_map>
+
+// Owns every linked shader program in the game. Programs are deduplicated by their
+// (vertex shader, fragment shader) path pair, so the many ShadedMesh resources that use
+// e.g. "textured" or "animated_sprite" all share a single GL program.
+//
+// Linked program binaries are also persisted to disk (keyed by the driver string and a
+// hash of the shader sources), so that subsequent launches can skip compilation entirely.
+class ShaderRegistry
+{
+public:
+	// Returns the singleton instance of this registry
+	static ShaderRegistry& instance()
+	{
+		static ShaderRegistry shaderRegistry;
+		return shaderRegistry;
+	}
+
+	// Returns the program linked from the given shader pair, loading it on first request
+	GLuint getProgram(const std::string& vs_path, const std::string& fs_path);
+
+	// Deletes all programs; any Effect still referring to them becomes invalid
+	void clear();
+
+	inline size_t size() const { return programs.size(); }
+
+private:
+	ShaderRegistry() = default;
+	~ShaderRegistry() = default;
+	ShaderRegistry(const ShaderRegistry&) = delete;
+	ShaderRegistry& operator=(const ShaderRegistry&) = delete;
+
+	// Compiles and links the sources from scratch
+	GLuint compileAndLink(const std::string& vs_src, const std::string& fs_src);
+
+	// Program binary cache on disk
+	bool binaryCacheSupported();
+	std::string binaryCachePath(const std::string& vs_src, const std::string& fs_src);
+	GLuint loadBinary(const std::string& cache_path, uint64_t source_hash);
+	void saveBinary(const std::string& cache_path, uint64_t source_hash, GLuint program);
+
+	std::unordered_map<std::string, GLResource<PROGRAM>> programs;
+	std::string driver_string;
+	int binary_cache_support = -1; // -1 = not yet queried
+};
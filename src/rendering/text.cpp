@@ -1,13 +1,13 @@
 #include "text.hpp"
+#include "text_layout.hpp"
 
 #include "common.hpp"
 #include "render.hpp"
 #include "game/achievement_system.hpp"
+#include "memory/frame_arena.hpp"
 
-#include <codecvt>
 #include <iomanip>
 #include <iostream>
-#include <locale>
 #include <map>
 #include <sstream>
 
@@ -226,7 +226,7 @@ public:
     // any fonts destroyed after main() exists still point to a valid
     // font library. Otherwise, the static font library might be destroyed
     // before other static objects that still need it (such as Font objects
-    // being used by Text objects in ECS::registry<Text>)
+    // being used by Text objects in ECS::registry<Text>())
     // See Static Initialization Order Fiasco for details:
     // https://en.cppreference.com/w/cpp/language/siof
 
@@ -422,30 +422,10 @@ const Font::Character& Font::getCharacter(std::uint32_t codePoint) {
 }
 
 
-/**
- * Helper function to convert a UTF-8 encoded std::string to a
- * UTF-32 string containing complete code points.
- * 
- * NOTE: ASCII strings are valid UTF-8 strings because UTF-8
- * is backwards-compatible with ASCII.
- * 
- * NOTE: UTF-8-encode std::strings can be constructed using
- * the `u8` string literal prefix, as in `u8"some international text"`.
- * See https://en.cppreference.com/w/cpp/language/string_literal
- */
-std::u32string utf8ToUtf32(const std::string& str) {
-    // NOTE: std::wstring_convert was introduced in C++11 and then
-    // spontaneously deprecated in C++17 without any replacement.
-    // Non-ASCII handling in C++ sucks in general. This will hopefully
-    // improve in C++23 but who can say.
-    using convert_t = std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t>;
-    return convert_t{}.from_bytes(str);
-}
-
 void drawText(const Text& text, glm::vec2 gameUnitSize) {
     assert(text.font);
 
-    // The on-screen baseline origin of the current glyph being drawn
+    // The on-screen baseline origin of the first glyph
     auto cursor = text.position + text.offset;
 
     // invert y-axis to place origin at top-left corner for consistency
@@ -491,44 +471,18 @@ void drawText(const Text& text, glm::vec2 gameUnitSize) {
     gl_has_errors();
 
 
-    // Convert ASCII/UTF-8 text to Unicode code points
-    const auto u32str = utf8ToUtf32(text.content);
-
-    // For each Unicode code point
-	for (const auto& c : u32str) {
+    // Convert ASCII/UTF-8 text to Unicode code points, and draw every glyph in its quad
+    layoutText(utf8ToUtf32(text.content), cursor, text.scale,
         // get (or create) the character from the font
-		const auto& ch = text.font->getCharacter(c);
-		
-        // compute the on-screen texture coordinates from the cursor's
-        // baseline origin
-		const auto xpos = cursor.x + ch.Bearing.x * text.scale;
-		const auto ypos = cursor.y + (ch.Bearing.y - ch.Size.y) * text.scale;
-
-		const auto w = ch.Size.x * text.scale;
-		const auto h = ch.Size.y * text.scale;
-
-        // Two triangles for the top and bottom halves of a quad
-		float vertices[6][4] = {
-			{ xpos,     ypos + h, 0.0f, 0.0f },
-			{ xpos,     ypos,     0.0f, 1.0f },
-			{ xpos + w, ypos,     1.0f, 1.0f },
-			{ xpos,     ypos + h, 0.0f, 0.0f },
-			{ xpos + w, ypos,     1.0f, 1.0f },
-			{ xpos + w, ypos + h, 1.0f, 0.0f }
-		};
-
-        // draw the texture in the quad
-		glBindTexture(GL_TEXTURE_2D, ch.Texture);
-		glBindBuffer(GL_ARRAY_BUFFER, ctx.vbo());
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-        
-        gl_has_errors();
-
-        // Move the cursor to the next glyph position.
-        // NOTE: advance is in units of 1/64 pixels
-		cursor.x += ch.Advance / 64.0f * text.scale;
-	}
+        [&text](char32_t c) -> const Font::Character& { return text.font->getCharacter(c); },
+        [&ctx](const Font::Character& ch, const float (&vertices)[6][4]) {
+            glBindTexture(GL_TEXTURE_2D, ch.Texture);
+            glBindBuffer(GL_ARRAY_BUFFER, ctx.vbo());
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+
+            gl_has_errors();
+        });
 	glBindVertexArray(0);
 	glBindTexture(GL_TEXTURE_2D, 0);
         
@@ -545,7 +499,7 @@ void addText(ECS::Entity entity, const std::string& text, vec2 position,
 ECS::Entity createText(const std::string& text, vec2 position,
 											 float scale, vec3 color)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 	addText(entity, text, position, scale, color);
 	return entity;
 }
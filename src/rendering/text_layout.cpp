@@ -0,0 +1,62 @@
+#include "text_layout.hpp"
+
+/**
+ * Helper function to convert a UTF-8 encoded std::string to a
+ * UTF-32 string containing complete code points.
+ * 
+ * NOTE: ASCII strings are valid UTF-8 strings because UTF-8
+ * is backwards-compatible with ASCII.
+ * 
+ * NOTE: UTF-8-encode std::strings can be constructed using
+ * the `u8` string literal prefix, as in `u8"some international text"`.
+ * See https://en.cppreference.com/w/cpp/language/string_literal
+ *
+ * NOTE: this runs for every text on every frame, so it decodes by
+ * hand into a FrameArena string instead of going through
+ * std::wstring_convert, which allocates on the heap. Malformed
+ * sequences become U+FFFD instead of throwing.
+ */
+FrameU32String utf8ToUtf32(const std::string& str) {
+    FrameU32String result;
+    result.reserve(str.size());
+
+    size_t i = 0;
+    while (i < str.size()) {
+        const auto lead = static_cast<unsigned char>(str[i]);
+
+        // Number of continuation bytes, and the payload bits of the lead byte
+        size_t length;
+        char32_t codePoint;
+        if (lead < 0x80) {
+            length = 0;
+            codePoint = lead;
+        } else if ((lead & 0xE0) == 0xC0) {
+            length = 1;
+            codePoint = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 2;
+            codePoint = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 3;
+            codePoint = lead & 0x07;
+        } else {
+            result.push_back(U'\uFFFD');
+            i++;
+            continue;
+        }
+
+        size_t j = 1;
+        for (; j <= length && i + j < str.size(); j++) {
+            const auto next = static_cast<unsigned char>(str[i + j]);
+            if ((next & 0xC0) != 0x80) {
+                break;
+            }
+            codePoint = (codePoint << 6) | (next & 0x3F);
+        }
+
+        result.push_back(j == length + 1 ? codePoint : U'\uFFFD');
+        i += j;
+    }
+
+    return result;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "game/common.hpp"
+#include "memory/frame_arena.hpp"
+
+#include <string>
+
+// The part of drawText that doesn't need OpenGL or FreeType, so that ambrosia_microbench can measure
+// the layout of the texts headless.
+
+/**
+ * Convert a UTF-8 encoded std::string to a UTF-32 string of complete
+ * code points, in the FrameArena. Malformed sequences become U+FFFD.
+ */
+FrameU32String utf8ToUtf32(const std::string& str);
+
+/**
+ * Place the glyphs of `codePoints` one after the other, starting at the
+ * on-screen baseline origin `cursor` (with y up), and pass each glyph and
+ * the two triangles of its quad (x, y, u, v) to `emit`.
+ * `getGlyph(codePoint)` returns the glyph's Size, Bearing and Advance,
+ * as Font::Character has them.
+ */
+template <class GetGlyph, class Emit>
+void layoutText(const FrameU32String& codePoints, vec2 cursor, float scale, GetGlyph&& getGlyph, Emit&& emit) {
+    for (const auto& c : codePoints) {
+        const auto& ch = getGlyph(c);
+
+        // compute the on-screen texture coordinates from the cursor's
+        // baseline origin
+        const auto xpos = cursor.x + ch.Bearing.x * scale;
+        const auto ypos = cursor.y + (ch.Bearing.y - ch.Size.y) * scale;
+
+        const auto w = ch.Size.x * scale;
+        const auto h = ch.Size.y * scale;
+
+        // Two triangles for the top and bottom halves of a quad
+        const float vertices[6][4] = {
+            { xpos,     ypos + h, 0.0f, 0.0f },
+            { xpos,     ypos,     0.0f, 1.0f },
+            { xpos + w, ypos,     1.0f, 1.0f },
+            { xpos,     ypos + h, 0.0f, 0.0f },
+            { xpos + w, ypos,     1.0f, 1.0f },
+            { xpos + w, ypos + h, 1.0f, 0.0f }
+        };
+        emit(ch, vertices);
+
+        // Move the cursor to the next glyph position.
+        // NOTE: advance is in units of 1/64 pixels
+        cursor.x += ch.Advance / 64.0f * scale;
+    }
+}
@@ -0,0 +1,254 @@
+#include "input_replay.hpp"
+
+#include "entities/tiny_ecs.hpp"
+
+#include "../ext/nlohmann/json.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace
+{
+	// The fixed timestep of the game and of HeadlessBattle. A recording made with another one would
+	// replay differently.
+	const float STEP_MS = 16.67f;
+
+	const char* typeName(InputEvent::Type type)
+	{
+		switch (type)
+		{
+		case InputEvent::Type::KEY: return "key";
+		case InputEvent::Type::MOUSE_CLICK: return "click";
+		default: return "hover";
+		}
+	}
+
+	InputEvent::Type typeFromName(const std::string& name)
+	{
+		if (name == "key")
+			return InputEvent::Type::KEY;
+		if (name == "click")
+			return InputEvent::Type::MOUSE_CLICK;
+		if (name == "hover")
+			return InputEvent::Type::MOUSE_HOVER;
+		throw std::runtime_error("unknown input event type " + name);
+	}
+
+	// See InputReplay::seedWorld
+	struct WorldSeed
+	{
+		bool isSet = false;
+		unsigned int seed = 0;
+	};
+
+	unsigned int deriveSeed(unsigned int seed, const char* name)
+	{
+		// FNV-1a, which unlike std::hash is the same with every standard library
+		uint32_t hash = 2166136261u;
+		for (const char* c = name; *c != '\0'; c++)
+		{
+			hash ^= static_cast<unsigned char>(*c);
+			hash *= 16777619u;
+		}
+		std::seed_seq sequence = { seed, hash };
+		uint32_t result;
+		sequence.generate(&result, &result + 1);
+		return result;
+	}
+}
+
+InputReplay::InputReplay()
+	: mode(Mode::OFF)
+	, mapIndex(0)
+	, seed(0)
+	, step(0)
+	, length(0)
+	, nextEventIndex(0)
+{
+}
+
+void InputReplay::startRecording(const std::string& path, const std::string& recipe, int mapIndex, unsigned int seed)
+{
+	this->path = path;
+	this->recipe = recipe;
+	this->mapIndex = mapIndex;
+	this->seed = seed;
+	step = 0;
+	events.clear();
+	mode = Mode::RECORDING;
+
+	// What still uses rand(), e.g. the particles
+	std::srand(seedFor("rand"));
+	std::cout << "Recording " << recipe << " map " << mapIndex << " to " << path << ", seed " << seed << std::endl;
+}
+
+void InputReplay::startReplay(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file)
+		throw std::runtime_error("can't read the recording " + path);
+	json recording;
+	file >> recording;
+
+	if (std::abs(recording.at("stepMs").get<float>() - STEP_MS) > 1e-4f)
+		throw std::runtime_error(path + " was recorded with another timestep");
+
+	this->path = path;
+	recipe = recording.at("recipe").get<std::string>();
+	mapIndex = recording.at("map").get<int>();
+	seed = recording.at("seed").get<unsigned int>();
+	length = recording.at("steps").get<long long>();
+	events.clear();
+	for (const auto& entry : recording.at("events"))
+	{
+		InputEvent event;
+		event.type = typeFromName(entry.at("type").get<std::string>());
+		event.step = entry.at("step").get<long long>();
+		if (event.type == InputEvent::Type::MOUSE_HOVER || event.type == InputEvent::Type::MOUSE_CLICK)
+			event.mousePos = { entry.at("x").get<float>(), entry.at("y").get<float>() };
+		if (event.type != InputEvent::Type::MOUSE_HOVER)
+		{
+			event.key = entry.at("key").get<int>();
+			event.action = entry.at("action").get<int>();
+			event.mods = entry.value("mods", 0);
+		}
+		events.push_back(event);
+	}
+	step = 0;
+	nextEventIndex = 0;
+	mode = Mode::REPLAYING;
+
+	std::srand(seedFor("rand"));
+	std::cout << "Replaying " << recipe << " map " << mapIndex << " from " << path << ": " << length << " steps, "
+		<< events.size() << " input events" << std::endl;
+}
+
+void InputReplay::startSeeded(unsigned int seed)
+{
+	path.clear();
+	recipe.clear();
+	mapIndex = 0;
+	this->seed = seed;
+	step = 0;
+	length = 0;
+	events.clear();
+	nextEventIndex = 0;
+	mode = Mode::SEEDED;
+
+	std::srand(seedFor("rand"));
+}
+
+bool InputReplay::save() const
+{
+	json recording;
+	recording["recipe"] = recipe;
+	recording["map"] = mapIndex;
+	recording["seed"] = seed;
+	recording["stepMs"] = STEP_MS;
+	recording["steps"] = step;
+	recording["events"] = json::array();
+	for (const auto& event : events)
+	{
+		json entry = { { "step", event.step }, { "type", typeName(event.type) } };
+		if (event.type != InputEvent::Type::MOUSE_HOVER)
+		{
+			entry["key"] = event.key;
+			entry["action"] = event.action;
+			entry["mods"] = event.mods;
+		}
+		if (event.type != InputEvent::Type::KEY)
+		{
+			entry["x"] = event.mousePos.x;
+			entry["y"] = event.mousePos.y;
+		}
+		recording["events"].push_back(entry);
+	}
+
+	std::ofstream file(path);
+	if (!file)
+	{
+		std::cout << "InputReplay: can't write " << path << std::endl;
+		return false;
+	}
+	file << recording.dump() << std::endl;
+	std::cout << "InputReplay: wrote " << step << " steps and " << events.size() << " input events to " << path << std::endl;
+	return true;
+}
+
+unsigned int InputReplay::seedFor(const char* name) const
+{
+	const auto& worldSeed = ECS::World::current().resource<WorldSeed>();
+	if (worldSeed.isSet)
+		return deriveSeed(worldSeed.seed, name);
+
+	if (mode == Mode::OFF)
+		return std::random_device()();
+	return deriveSeed(seed, name);
+}
+
+void InputReplay::seedWorld(unsigned int seed)
+{
+	auto& worldSeed = ECS::World::current().resource<WorldSeed>();
+	worldSeed.isSet = true;
+	worldSeed.seed = seed;
+}
+
+void InputReplay::recordKey(int key, int action, int mods)
+{
+	InputEvent event;
+	event.type = InputEvent::Type::KEY;
+	event.key = key;
+	event.action = action;
+	event.mods = mods;
+	record(event);
+}
+
+void InputReplay::recordMouseClick(int button, int action, int mods, vec2 mousePos)
+{
+	InputEvent event;
+	event.type = InputEvent::Type::MOUSE_CLICK;
+	event.key = button;
+	event.action = action;
+	event.mods = mods;
+	event.mousePos = mousePos;
+	record(event);
+}
+
+void InputReplay::recordMouseHover(vec2 mousePos)
+{
+	InputEvent event;
+	event.type = InputEvent::Type::MOUSE_HOVER;
+	event.mousePos = mousePos;
+	record(event);
+}
+
+void InputReplay::record(const InputEvent& event)
+{
+	if (mode != Mode::RECORDING)
+		return;
+
+	events.push_back(event);
+	events.back().step = step;
+}
+
+bool InputReplay::nextEvent(InputEvent& event)
+{
+	if (mode != Mode::REPLAYING || nextEventIndex == events.size() || events[nextEventIndex].step > step)
+		return false;
+
+	event = events[nextEventIndex++];
+	return true;
+}
+
+void InputReplay::endStep()
+{
+	if (mode != Mode::OFF)
+		step++;
+}
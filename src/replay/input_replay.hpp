@@ -0,0 +1,98 @@
+#pragma once
+
+#include "game/common.hpp"
+
+#include <string>
+#include <vector>
+
+// One input event of a recorded session, in the fixed update step it came in
+struct InputEvent
+{
+	enum class Type { KEY, MOUSE_CLICK, MOUSE_HOVER };
+
+	Type type;
+	long long step;
+	int key = 0; // The GLFW key, or mouse button for clicks
+	int action = 0;
+	int mods = 0;
+	vec2 mousePos = { 0.f, 0.f };
+};
+
+// Records a play session, to replay it frame for frame, e.g. to compare the performance of two builds
+// on the very same battle. A session starts on a recipe map. Its recording holds:
+//   - the seed that every random number generator of the game derives its own seed from (seedFor())
+//   - the input that WorldSystem receives (keys, mouse clicks and the cursor moves that become the
+//     RawMouseClickEvent and RawMouseHoverEvent), timestamped with the fixed update step it came in
+// The game replays it at the fixed timestep, one update step per frame, and so does ambrosia_headless
+// without the window (see HeadlessBattle::Config::replayInput). A seeded session has no input, only the
+// seed, so that ambrosia_bench plays the same autopilot battle on every run.
+//
+// Recordings are JSON: { "recipe", "map", "seed", "stepMs", "steps", "events": [...] }
+class InputReplay
+{
+public:
+	enum class Mode { OFF, RECORDING, REPLAYING, SEEDED };
+
+	static InputReplay& instance()
+	{
+		static InputReplay replay;
+		return replay;
+	}
+
+	// Before the systems are created, so that they get their seeds from the session
+	void startRecording(const std::string& path, const std::string& recipe, int mapIndex, unsigned int seed);
+	// Throws std::runtime_error if the file can't be read
+	void startReplay(const std::string& path);
+	// Only fixes the seeds, the input is live
+	void startSeeded(unsigned int seed);
+	// Writes the recording to the path it was started with, returns false if it can't
+	bool save() const;
+
+	inline Mode getMode() const { return mode; }
+	inline bool isRecording() const { return mode == Mode::RECORDING; }
+	inline bool isReplaying() const { return mode == Mode::REPLAYING; }
+	inline const std::string& getRecipe() const { return recipe; }
+	inline int getMapIndex() const { return mapIndex; }
+	// The seed of the session, 0 when it's off
+	inline unsigned int getSeed() const { return seed; }
+	// Update steps recorded or replayed so far
+	inline long long getStep() const { return step; }
+	// The length of the replayed session, in update steps
+	inline long long getLength() const { return length; }
+	inline bool isFinished() const { return isReplaying() && step >= length; }
+
+	// The seed of a named random number generator, e.g. "ai". Derived from the session's seed while
+	// recording, replaying or seeded, so that the generators don't depend on the order they're created in.
+	// From std::random_device otherwise.
+	unsigned int seedFor(const char* name) const;
+
+	// Gives the current ECS::World a seed of its own, which seedFor() then derives from in that world
+	// whatever the mode. For battles that play side by side, e.g. the games of ambrosia_simulate.
+	static void seedWorld(unsigned int seed);
+
+	// Recording, as the input comes in. Does nothing unless recording.
+	void recordKey(int key, int action, int mods);
+	void recordMouseClick(int button, int action, int mods, vec2 mousePos);
+	void recordMouseHover(vec2 mousePos);
+
+	// Replaying: the next event of the current step, false once there are no more
+	bool nextEvent(InputEvent& event);
+
+	// Called once every fixed update step has run
+	void endStep();
+
+private:
+	InputReplay();
+
+	void record(const InputEvent& event);
+
+	Mode mode;
+	std::string path;
+	std::string recipe;
+	int mapIndex;
+	unsigned int seed;
+	long long step;
+	long long length;
+	std::vector<InputEvent> events;
+	size_t nextEventIndex;
+};
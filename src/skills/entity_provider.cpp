@@ -1,4 +1,5 @@
 #include "entity_provider.hpp"
+#include "memory/frame_arena.hpp"
 
 namespace
 {
@@ -30,7 +31,7 @@ namespace
 		return closestPoint;
 	}
 
-	std::vector<ECS::Entity> getSortedEntities(std::vector<std::pair<ECS::Entity, float>>& entities)
+	std::vector<ECS::Entity> getSortedEntities(FrameVector<std::pair<ECS::Entity, float>>& entities)
 	{
 		// Sort so that the closest entities are at the front of the list
 		std::sort(entities.begin(), entities.end(), [](const auto& pair1, const auto& pair2) {
@@ -53,14 +54,14 @@ namespace
 std::vector<ECS::Entity> AllEntitiesProvider::getEntities(ECS::Entity instigator,
 																													vec2 targetPosition)
 {
-	return ECS::registry<Motion>.entities;
+	return ECS::registry<Motion>().entities;
 }
 
 std::vector<ECS::Entity> CircularProvider::getEntities(ECS::Entity instigator,
 																											 vec2 targetPosition)
 {
 	// Pairs of entities and their distances to the instigator
-	std::vector<std::pair<ECS::Entity, float>> entities;
+	FrameVector<std::pair<ECS::Entity, float>> entities;
 
 	assert(instigator.has<Motion>());
 	vec2 instigatorPosition = instigator.get<Motion>().position;
@@ -68,10 +69,10 @@ std::vector<ECS::Entity> CircularProvider::getEntities(ECS::Entity instigator,
 	// We should search in a circle around the center of the instigator
 	vec2 centerOfInstigator = getCenterOfEntity(instigator);
 
-	for (int i = 0; i < ECS::registry<Motion>.entities.size(); i++)
+	for (int i = 0; i < ECS::registry<Motion>().entities.size(); i++)
 	{
-		auto entity = ECS::registry<Motion>.entities[i];
-		auto& motion = ECS::registry<Motion>.components[i];
+		auto entity = ECS::registry<Motion>().entities[i];
+		auto& motion = ECS::registry<Motion>().components[i];
 
 		// Find all targets whose bounding box intersects with the circle
 		float dist = distance(centerOfInstigator,
@@ -98,16 +99,16 @@ std::vector<ECS::Entity> ConicalProvider::getEntities(ECS::Entity instigator,
 																											vec2 targetPosition)
 {
 	// Pairs of entities and their angular distance
-	std::vector<std::pair<ECS::Entity, float>> entities;
+	FrameVector<std::pair<ECS::Entity, float>> entities;
 
 	// We should search in a cone that starts at the center of the instigator
 	vec2 centerOfInstigator = getCenterOfEntity(instigator);
 	vec2 instigatorToTarget = normalize(targetPosition - centerOfInstigator);
 
-	for (int i = 0; i < ECS::registry<Motion>.entities.size(); i++)
+	for (int i = 0; i < ECS::registry<Motion>().entities.size(); i++)
 	{
-		auto entity = ECS::registry<Motion>.entities[i];
-		auto& motion = ECS::registry<Motion>.components[i];
+		auto entity = ECS::registry<Motion>().entities[i];
+		auto& motion = ECS::registry<Motion>().components[i];
 
 		// TODO: Update this function to check that the bounding box is within the cone
 		vec2 sourceToEntity = normalize(motion.position - centerOfInstigator);
@@ -126,15 +127,15 @@ std::vector<ECS::Entity> MouseClickProvider::getEntities(ECS::Entity instigator,
 																												 vec2 targetPosition)
 {
 	// Pairs of entities and their distance to the mouse click
-	std::vector<std::pair<ECS::Entity, float>> entities;
+	FrameVector<std::pair<ECS::Entity, float>> entities;
 
 	// We should search in a circle around the mouse click position
 	vec2 mouseClickPosition = targetPosition;
 
-	for (int i = 0; i < ECS::registry<Motion>.entities.size(); i++)
+	for (int i = 0; i < ECS::registry<Motion>().entities.size(); i++)
 	{
-		auto entity = ECS::registry<Motion>.entities[i];
-		auto& motion = ECS::registry<Motion>.components[i];
+		auto entity = ECS::registry<Motion>().entities[i];
+		auto& motion = ECS::registry<Motion>().components[i];
 
 		// Find all targets whose bounding box intersects with the circle
 		float dist = distance(mouseClickPosition,
@@ -39,6 +39,16 @@ std::shared_ptr<Skill> SkillComponent::getActiveSkill()
 	return skills[activeType].levels[getActiveSkillLevel() - 1];
 }
 
+std::shared_ptr<Skill> SkillComponent::getSkill(SkillType type)
+{
+	auto it = skills.find(type);
+	if (it == skills.end() || it->second.levels.empty())
+	{
+		return nullptr;
+	}
+	return it->second.levels[it->second.currLevel - 1];
+}
+
 SkillType SkillComponent::getActiveSkillType()
 {
 	return activeType;
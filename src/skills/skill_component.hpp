@@ -40,6 +40,7 @@ public:
 
 	void setActiveSkill(SkillType type);
 	std::shared_ptr<Skill> getActiveSkill();
+	std::shared_ptr<Skill> getSkill(SkillType type); // null if the entity doesn't have this skill
 	SkillType getActiveSkillType();
 
 	unsigned int getActiveSkillLevel();
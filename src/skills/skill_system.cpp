@@ -1,6 +1,7 @@
 #include "skill_system.hpp"
 #include "skill_component.hpp"
 #include "game/game_state_system.hpp"
+#include "memory/frame_arena.hpp"
 
 
 SkillSystem::SkillSystem()
@@ -39,7 +40,7 @@ void SkillSystem::step(float elapsed_ms)
 		return;
 	}
 	const float elapsed_s = elapsed_ms / 1000.f;
-	std::vector<int> toRemove;
+	FrameVector<int> toRemove;
 
 	// Go through the queued skills and execute the ones whose timer have reached zero. The purpose of the timer is to
 	// allow us to sync up the animation with the execution of the skill
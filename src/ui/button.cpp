@@ -5,20 +5,20 @@
 
 ECS::Entity Button::createButton(ButtonShape shape, vec2 position, const std::string& texture, void(*callback)())
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource(texture);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		resource = ShadedMesh();
 		RenderSystem::createSprite(resource, uiPath(texture + ".png"), "textured");
 	}
 
-	ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(entity, resource);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 
 	// Add clickable component to button depending on shape
@@ -81,19 +81,19 @@ ECS::Entity Button::createPlayerButton(PlayerType player, vec2 position, void(*c
 
 ECS::Entity SkillButton::createSkillButton(vec2 position, PlayerType player, SkillType skillType, const std::string& texture, void(*callback)())
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource(texture);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createPlayerSpecificMesh(resource, uiPath("skill_buttons/" + texture), "skill_button");
 	}
 
-	ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(entity, resource);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 
 	entity.emplace<ClickableCircleComponent>(position, resource.texture.size.x / 2, callback);
@@ -108,19 +108,20 @@ ECS::Entity SkillButton::createSkillButton(vec2 position, PlayerType player, Ski
 
 ECS::Entity SkillButton::createMoveButton(vec2 position, const std::string& texture, void(*callback)())
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
-	ShadedMesh& resource = cacheResource("move_button");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("move_button");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath(texture + ".png"), "dynamic_texture");
 	}
 
-	ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(entity, resourceId);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 
 	entity.emplace<ClickableCircleComponent>(position, resource.texture.size.x / 2, callback);
@@ -136,10 +137,10 @@ ECS::Entity SkillButton::createMoveButton(vec2 position, const std::string& text
 
 ECS::Entity UpgradeButton::createUpgradeButton(vec2 position, PlayerType player, SkillType skillType, const std::string& texture, void(*callback)())
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource(texture);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		if (skillType == SkillType::NONE) {
 			RenderSystem::createSprite(resource, uiPath("shop/" + texture + ".png"), "skill_button");
@@ -150,11 +151,11 @@ ECS::Entity UpgradeButton::createUpgradeButton(vec2 position, PlayerType player,
 		
 	}
 
-	ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(entity, resource);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 
 	entity.emplace<ClickableCircleComponent>(position, resource.texture.size.x / 2, callback);
@@ -168,20 +169,20 @@ ECS::Entity UpgradeButton::createUpgradeButton(vec2 position, PlayerType player,
 
 ECS::Entity Button::createPlayerUpgradeButton(ButtonShape shape, vec2 position, const std::string& texture, void(*callback)())
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	ShadedMesh& resource = cacheResource(texture);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		resource = ShadedMesh();
 		RenderSystem::createSprite(resource, uiPath("shop/" + texture + ".png"), "textured");
 	}
 
-	ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(entity, resource);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 
 	// Add clickable component to button depending on shape
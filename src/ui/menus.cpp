@@ -16,9 +16,9 @@ void StartMenu::createStartMenu(int frameBufferWidth, int frameBufferHeight)
 	EventSystem<PlayMusicEvent>::instance().sendEvent({MusicType::START_SCREEN});
 
 	// Background
-	auto background = ECS::Entity();
+	auto background = ECS::Entity::create();
 	ShadedMesh& splashResource = cacheResource("start_splash");
-	if (splashResource.effect.program.resource == 0)
+	if (splashResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(splashResource, uiPath("menus/start/start-splash.png"), "textured");
 	}
@@ -30,9 +30,9 @@ void StartMenu::createStartMenu(int frameBufferWidth, int frameBufferHeight)
 	mapComponent.mapSize = static_cast<vec2>(splashResource.texture.size);
 
 	// Glow
-	auto glow = ECS::Entity();
+	auto glow = ECS::Entity::create();
 	ShadedMesh& glowResource = cacheResource("start_glow");
-	if (glowResource.effect.program.resource == 0)
+	if (glowResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(glowResource, uiPath("menus/start/start-glow.png"), "fading");
 	}
@@ -40,9 +40,9 @@ void StartMenu::createStartMenu(int frameBufferWidth, int frameBufferHeight)
 	glow.emplace<RenderableComponent>(RenderLayer::MAP_OBJECT);
 	glow.emplace<Motion>().position = vec2(frameBufferWidth / 2, frameBufferHeight / 2);
 
-	auto logo = ECS::Entity();
+	auto logo = ECS::Entity::create();
 	ShadedMesh& logoResource = cacheResource("ambrosia_logo");
-	if (logoResource.effect.program.resource == 0)
+	if (logoResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(logoResource, uiPath("menus/start/title-button.png"), "distendable");
 	}
@@ -51,7 +51,7 @@ void StartMenu::createStartMenu(int frameBufferWidth, int frameBufferHeight)
 	logo.emplace<RenderableComponent>(RenderLayer::UI);
 	logo.emplace<Motion>().position = vec2(frameBufferWidth / 2 - 30, frameBufferHeight / 3 - 50);
 
-	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "sparkleEmitter",std::make_shared<SparkleEmitter>(SparkleEmitter(20)) });
+	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "sparkleEmitter", EmitterType::SPARKLE, 20 });
 
 	Button::createButton(ButtonShape::RECTANGLE,
 		{ frameBufferWidth - 250, frameBufferHeight / 2 + 50 }, "menus/start/start-button",
@@ -101,10 +101,10 @@ void StartMenu::createStartMenu(int frameBufferWidth, int frameBufferHeight)
 
 void Screens::createVictoryScreen(int frameBufferWidth, int frameBufferHeight, int type)
 {
-	auto background = ECS::Entity();
+	auto background = ECS::Entity::create();
 	const std::string key = "victory-" + std::to_string(type);
 	ShadedMesh& splashResource = cacheResource(key);
-	if (splashResource.effect.program.resource == 0)
+	if (splashResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(splashResource, uiPath("menus/" + key + ".png"), "textured");
 	}
@@ -115,9 +115,9 @@ void Screens::createVictoryScreen(int frameBufferWidth, int frameBufferHeight, i
 	mapComponent.name = key;
 	mapComponent.mapSize = static_cast<vec2>(splashResource.texture.size);
 
-	auto victoryLogo = ECS::Entity();
+	auto victoryLogo = ECS::Entity::create();
 	ShadedMesh& logoResource = cacheResource("victory_logo");
-	if (logoResource.effect.program.resource == 0)
+	if (logoResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(logoResource, uiPath("menus/victory-logo.png"), "distendable");
 	}
@@ -126,7 +126,7 @@ void Screens::createVictoryScreen(int frameBufferWidth, int frameBufferHeight, i
 	victoryLogo.emplace<RenderableComponent>(RenderLayer::MAP_OBJECT);
 	victoryLogo.emplace<Motion>().position = vec2(frameBufferWidth / 2, frameBufferHeight / 2 - 150);
 
-	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "confettiEmitter",std::make_shared<ConfettiEmitter>(ConfettiEmitter()) });
+	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "confettiEmitter", EmitterType::CONFETTI });
 
 	// TODO: Hook up 
 	Button::createButton(ButtonShape::RECTANGLE,
@@ -146,10 +146,10 @@ void Screens::createVictoryScreen(int frameBufferWidth, int frameBufferHeight, i
 
 void Screens::createDefeatScreen(int frameBufferWidth, int frameBufferHeight, int type)
 {
-	auto background = ECS::Entity();
+	auto background = ECS::Entity::create();
 	const std::string key = "defeat-" + std::to_string(type);
 	ShadedMesh& splashResource = cacheResource(key);
-	if (splashResource.effect.program.resource == 0)
+	if (splashResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(splashResource, uiPath("menus/" + key + ".png"), "textured");
 	}
@@ -160,9 +160,9 @@ void Screens::createDefeatScreen(int frameBufferWidth, int frameBufferHeight, in
 	mapComponent.name = key;
 	mapComponent.mapSize = static_cast<vec2>(splashResource.texture.size);
 
-	auto logo = ECS::Entity();
+	auto logo = ECS::Entity::create();
 	ShadedMesh& logoResource = cacheResource("defeat_logo");
-	if (logoResource.effect.program.resource == 0)
+	if (logoResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(logoResource, uiPath("menus/defeat-logo.png"), "distendable");
 	}
@@ -171,9 +171,9 @@ void Screens::createDefeatScreen(int frameBufferWidth, int frameBufferHeight, in
 	logo.emplace<RenderableComponent>(RenderLayer::MAP_OBJECT);
 	logo.emplace<Motion>().position = vec2(frameBufferWidth / 2, frameBufferHeight / 2 - 180);
 
-	auto tryAgain = ECS::Entity();
+	auto tryAgain = ECS::Entity::create();
 	ShadedMesh& tryagainResource = cacheResource("tryagain_logo");
-	if (tryagainResource.effect.program.resource == 0)
+	if (tryagainResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(tryagainResource, uiPath("menus/try-again.png"), "textured");
 	}
@@ -182,7 +182,7 @@ void Screens::createDefeatScreen(int frameBufferWidth, int frameBufferHeight, in
 	tryAgain.emplace<Motion>().position = vec2(frameBufferWidth / 2, frameBufferHeight / 2 + 20);
 
 	//Create the rain
-	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "rainEmitter",std::make_shared<RainEmitter>(RainEmitter(10)) });
+	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "rainEmitter", EmitterType::RAIN, 10 });
 
 	// TODO: Hook up 
 	Button::createButton(ButtonShape::RECTANGLE,
@@ -285,10 +285,10 @@ void Screens::createCreditsScreen(int frameBufferWidth, int frameBufferHeight, i
 
 void Screens::createShopScreen(int frameBufferWidth, int frameBufferHeight, ECS::Entity raoul, ECS::Entity chia, ECS::Entity ember, ECS::Entity taji)
 {
-	auto background = ECS::Entity();
+	auto background = ECS::Entity::create();
 	const std::string key = "shop";
 	ShadedMesh& splashResource = cacheResource(key);
-	if (splashResource.effect.program.resource == 0)
+	if (splashResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(splashResource, uiPath("menus/" + key + ".png"), "textured");
 	}
@@ -324,9 +324,9 @@ void Screens::createShopScreen(int frameBufferWidth, int frameBufferHeight, ECS:
 void Screens::createRecipeSelectScreen(int frameBufferWidth, int frameBufferHeight)
 {
 	// Background
-	auto background = ECS::Entity();
+	auto background = ECS::Entity::create();
 	ShadedMesh& splashResource = cacheResource("start_splash");
-	if (splashResource.effect.program.resource == 0)
+	if (splashResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(splashResource, uiPath("menus/start/start-splash.png"), "textured");
 	}
@@ -343,9 +343,9 @@ void Screens::createRecipeSelectScreen(int frameBufferWidth, int frameBufferHeig
 	createText(selectText, position, scale);
 
 	// Glow
-	auto glow = ECS::Entity();
+	auto glow = ECS::Entity::create();
 	ShadedMesh& glowResource = cacheResource("start_glow");
-	if (glowResource.effect.program.resource == 0)
+	if (glowResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(glowResource, uiPath("menus/start/start-glow.png"), "fading");
 	}
@@ -353,7 +353,7 @@ void Screens::createRecipeSelectScreen(int frameBufferWidth, int frameBufferHeig
 	glow.emplace<RenderableComponent>(RenderLayer::MAP_OBJECT);
 	glow.emplace<Motion>().position = vec2(frameBufferWidth / 2, frameBufferHeight / 2);
 
-	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "sparkleEmitter",std::make_shared<SparkleEmitter>(SparkleEmitter(20)) });
+	EventSystem<AddEmitterEvent>::instance().sendEvent(AddEmitterEvent{ "sparkleEmitter", EmitterType::SPARKLE, 20 });
 
 	Button::createButton(ButtonShape::RECTANGLE,
 		{ frameBufferWidth / 2, frameBufferHeight / 2 - 200 }, "recipe_select/tutorial-select",
@@ -86,10 +86,10 @@ void ShopSystem::executeShopEffect(SkillType skillType, PlayerType player, int i
 
 	ShopSystem::instance().selected = index;
 
-	ECS::registry<Motion>.get(ShopSystem::instance().activeFX).position = { ECS::registry<Motion>.get(buttons.at(index)).position };
+	ECS::registry<Motion>().get(ShopSystem::instance().activeFX).position = { ECS::registry<Motion>().get(buttons.at(index)).position };
 
 	// render upgrade description
-	ECS::registry<Text>.clear();
+	ECS::registry<Text>().clear();
 	printDescriptionText(descriptions[selected]);
 
 	// render labels
@@ -98,10 +98,10 @@ void ShopSystem::executeShopEffect(SkillType skillType, PlayerType player, int i
 
 int ShopSystem::getCost() {
 	if (selected_skill == SkillType::NONE) {
-		StatsComponent stats = ECS::registry<StatsComponent>.get(getPlayerEntity(selected_player));
+		StatsComponent stats = ECS::registry<StatsComponent>().get(getPlayerEntity(selected_player));
 		return (int)stats.getStatValue(StatType::LEVEL) * cost_multiplier;
 	} else {
-		SkillComponent component = ECS::registry<SkillComponent>.get(getPlayerEntity(selected_player));
+		SkillComponent component = ECS::registry<SkillComponent>().get(getPlayerEntity(selected_player));
 		return (int)component.getSkillLevel(selected_skill) * cost_multiplier;
 	}
 }
@@ -127,10 +127,10 @@ void ShopSystem::buySelectedSkill() {
 	std::cout << "Buying " << getPlayerName(selected_player) << "'s skill " << (int)selected_skill << std::endl;
 
 	if (selected_skill == SkillType::NONE) {
-		StatsComponent stats = ECS::registry<StatsComponent>.get(getPlayerEntity(selected_player));
+		StatsComponent stats = ECS::registry<StatsComponent>().get(getPlayerEntity(selected_player));
 		if (!stats.atMaxLevel()) {
 			if (checkIfAbleToBuy(stats.getStatValue(StatType::LEVEL))) {
-				ECS::registry<StatsComponent>.get(getPlayerEntity(selected_player)).levelUp();
+				ECS::registry<StatsComponent>().get(getPlayerEntity(selected_player)).levelUp();
 			};
 		}
 		else {
@@ -139,18 +139,18 @@ void ShopSystem::buySelectedSkill() {
 		}
 	}
 	else {
-		SkillComponent component = ECS::registry<SkillComponent>.get(getPlayerEntity(selected_player));
+		SkillComponent component = ECS::registry<SkillComponent>().get(getPlayerEntity(selected_player));
 		if (component.getSkillLevel(selected_skill) == component.getMaxLevel(selected_skill)) {
 			std::cout << "level maxed already!" << std::endl;
 			return;
 		}
 
 		if (checkIfAbleToBuy(component.getSkillLevel(selected_skill))) {
-			ECS::registry<SkillComponent>.get(getPlayerEntity(selected_player)).upgradeSkillLevel(selected_skill);
+			ECS::registry<SkillComponent>().get(getPlayerEntity(selected_player)).upgradeSkillLevel(selected_skill);
 		}
 	}
 
-	ECS::registry<Text>.clear();
+	ECS::registry<Text>().clear();
 	printDescriptionText(descriptions[selected]);
 
 	// render labels
@@ -357,10 +357,10 @@ void ShopSystem::renderLabels()
 {
 	for (int i = 0; i < buttons.size(); i++) {
 		auto e = buttons.at(i);
-		vec2 button_pos = ECS::registry<Motion>.get(e).position;
+		vec2 button_pos = ECS::registry<Motion>().get(e).position;
 		ECS::Entity player;
 		std::string text;
-		if (!ECS::registry<SkillInfoComponent>.has(e)) {
+		if (!ECS::registry<SkillInfoComponent>().has(e)) {
 			// player upgrades
 			switch ((i) / 4) {
 			case 0:
@@ -385,8 +385,8 @@ void ShopSystem::renderLabels()
 				text = "LVL. " + std::to_string((int)stats.getStatValue(StatType::LEVEL));
 			}
 		} else {
-			auto buttonInfo = ECS::registry<SkillInfoComponent>.get(e);
-			auto skillComponent = ECS::registry<SkillComponent>.get(getPlayerEntity(buttonInfo.player));
+			auto buttonInfo = ECS::registry<SkillInfoComponent>().get(e);
+			auto skillComponent = ECS::registry<SkillComponent>().get(getPlayerEntity(buttonInfo.player));
 
 			if (skillComponent.getSkillLevel(buttonInfo.skillType) == skillComponent.getMaxLevel(buttonInfo.skillType)) {
 				text = "MAX!";
@@ -55,9 +55,9 @@ class ShopSystem
 		std::vector<ECS::Entity> buttons;
 
 	public:
+		// Returns the instance of this system for the current ECS::World
 		static ShopSystem& instance() {
-			static ShopSystem shopSystem;
-			return shopSystem;
+			return ECS::World::current().resource<ShopSystem>();
 		}
 		void buySelectedSkill();
 		void initialize(ECS::Entity raoul, ECS::Entity chia, ECS::Entity ember, ECS::Entity taji);
@@ -162,9 +162,9 @@ void TutorialSystem::onShowHelp(const ShowHelpEvent& event)
 
 void TutorialSystem::onHideHelp(const HideHelpEvent& event)
 {
-	while (!ECS::registry<HelpOverlay>.entities.empty())
+	while (!ECS::registry<HelpOverlay>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<HelpOverlay>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<HelpOverlay>().entities.back());
 	}
 	GameStateSystem::instance().isInHelpScreen = false;
 };
@@ -172,19 +172,19 @@ void TutorialSystem::onHideHelp(const HideHelpEvent& event)
 
 void TutorialSystem::cleanTutorial()
 {
-	while (!ECS::registry<TutorialComponent>.entities.empty())
+	while (!ECS::registry<TutorialComponent>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<TutorialComponent>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<TutorialComponent>().entities.back());
 	}
 };
 
 ECS::Entity TutorialText::createTutorialText(vec2 position, int tutorialStage)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	std::string tutorialKey = "tutorial_" + std::to_string(tutorialStage);
 	ShadedMesh& resource = cacheResource(tutorialKey);
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("tutorial/text/" + tutorialKey + ".png"), "textured");
 	}
@@ -194,7 +194,7 @@ ECS::Entity TutorialText::createTutorialText(vec2 position, int tutorialStage)
 	entity.emplace<TutorialComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 
 	entity.emplace<TutorialText>();
@@ -205,10 +205,10 @@ ECS::Entity StoryScene::createStoryScene(vec2 screenSize, int storyStage, bool h
 {
 	assert(0 <= storyStage);
 
-	auto background = ECS::Entity();
+	auto background = ECS::Entity::create();
 	std::string key = "story-" + std::to_string(storyStage);
 	ShadedMesh& storyResource = cacheResource(key);
-	if (storyResource.effect.program.resource == 0)
+	if (storyResource.effect.program == 0)
 	{
 		RenderSystem::createSprite(storyResource, uiPath("story/" + key + ".png"), "textured");
 	}
@@ -223,9 +223,9 @@ ECS::Entity StoryScene::createStoryScene(vec2 screenSize, int storyStage, bool h
 	if (hasAmbrosia)
 	{
 		// Glow
-		auto glow = ECS::Entity();
+		auto glow = ECS::Entity::create();
 		ShadedMesh& glowResource = cacheResource("story-glow");
-		if (glowResource.effect.program.resource == 0)
+		if (glowResource.effect.program == 0)
 		{
 			RenderSystem::createSprite(glowResource, uiPath("story/glow.png"), "fading");
 		}
@@ -240,9 +240,9 @@ ECS::Entity StoryScene::createStoryScene(vec2 screenSize, int storyStage, bool h
 
 void TutorialSystem::onAdvanceStory(const AdvanceStoryEvent& event)
 {
-	while (!ECS::registry<StoryComponent>.entities.empty())
+	while (!ECS::registry<StoryComponent>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<StoryComponent>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<StoryComponent>().entities.back());
 	}
 
 	int storyStage = GameStateSystem::instance().currentStoryIndex;
@@ -262,6 +262,26 @@ void TutorialSystem::onAdvanceStory(const AdvanceStoryEvent& event)
 };
 
 
+void TutorialSystem::onKey(int key, int action)
+{
+	if (key == GLFW_KEY_H && action == GLFW_RELEASE)
+	{
+		if (GameStateSystem::instance().isInHelpScreen)
+		{
+			EventSystem<HideHelpEvent>::instance().sendEvent(HideHelpEvent{});
+		}
+		else if (!GameStateSystem::instance().isInTutorial)
+		{
+			EventSystem<ShowHelpEvent>::instance().sendEvent(ShowHelpEvent{});
+		}
+	}
+
+	if (key == GLFW_KEY_I && action == GLFW_RELEASE)
+	{
+		toggleInspectMode();
+	}
+}
+
 void TutorialSystem::toggleInspectMode()
 {
 	std::cout << "Inspect button clicked." << std::endl;
@@ -271,7 +291,7 @@ void TutorialSystem::toggleInspectMode()
 		return;
 	}
 
-	ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	ECS::Entity activeEntity = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 	if (!activeEntity.has<PlayerComponent>() || activeEntity.has<DeathTimer>())
 	{
 		std::cout << "Cannot inspect. The active entity is not a valid player." << std::endl;
@@ -306,9 +326,9 @@ void TutorialSystem::toggleInspectMode()
 void TutorialSystem::onMouseHover(const MouseHoverEvent& event)
 {
 	// Clear all mob cards regardless
-	while (!ECS::registry<MobCard>.entities.empty())
+	while (!ECS::registry<MobCard>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<MobCard>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<MobCard>().entities.back());
 	}
 
 	// Only handle Inspecting Mode
@@ -331,7 +351,7 @@ void TutorialSystem::onMouseHover(const MouseHoverEvent& event)
 	};
 
 	// Check if hovering over any alive mobs
-	for (auto& mob : ECS::registry<AISystem::MobComponent>.entities)
+	for (auto& mob : ECS::registry<AISystem::MobComponent>().entities)
 	{
 		if (mob.has<DeathTimer>() || !mob.has<Motion>())
 		{
@@ -15,6 +15,8 @@ public:
 
 	static void cleanTutorial();
 	static void toggleInspectMode();
+	// H shows or hides the help overlay, I toggles the inspect mode
+	static void onKey(int key, int action);
 
 private:
 	EventListenerInfo tutorialStartListener;
@@ -8,28 +8,29 @@
 
 ECS::Entity HPBar::createHPBar(vec2 position, vec2 scale)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
-	ShadedMesh& resource = cacheResource("hp_bar");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("hp_bar");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("hp_bar.png"), "hp_bar");
 	}
 
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 	entity.emplace<RenderableComponent>(RenderLayer::UI_ACTIVE_SKILL_FX);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 	motion.scale = scale;
 
-	ECS::registry<HPBar>.emplace(entity);
+	ECS::registry<HPBar>().emplace(entity);
 	return entity;
 }
 
 ECS::Entity ToolTip::createToolTip(PlayerType player, SkillType skillType, vec2 position)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	std::string skillString = "skill1";
 
@@ -49,16 +50,16 @@ ECS::Entity ToolTip::createToolTip(PlayerType player, SkillType skillType, vec2
 	}
 
 	ShadedMesh& resource = cacheResource(skillString + "_tooltip");
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createPlayerSpecificMesh(resource, uiPath("tooltips/" + skillString), "skill_button");
 	}
 
-	ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(entity, resource);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI_TOOLTIP);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position + vec2(resource.texture.size.x / 2.f, -resource.texture.size.y) / 2.f;
 
 	entity.emplace<SkillInfoComponent>(player, skillType);
@@ -71,20 +72,21 @@ ECS::Entity ToolTip::createToolTip(PlayerType player, SkillType skillType, vec2
 
 ECS::Entity ToolTip::createMoveToolTip(vec2 position)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 	entity.emplace<MoveToolTipComponent>();
 
-	ShadedMesh& resource = cacheResource("move_tooltip");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("move_tooltip");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("tooltips/move_tooltip.png"), "textured");
 	}
 
-	ECS::registry<ShadedMeshRef>.emplace(entity, resource);
+	ECS::registry<ShadedMeshRef>().emplace(entity, resourceId);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI_TOOLTIP);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position + vec2(resource.texture.size.x / 2.f, -resource.texture.size.y) / 2.f;
 	motion.angle = 0.f;
 	motion.velocity = { 0.f, 0.f };
@@ -101,24 +103,25 @@ ECS::Entity ToolTip::createMoveToolTip(vec2 position)
 
 ECS::Entity TajiHelper::createTajiHelper(vec2 position, vec2 scale)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
-	ShadedMesh& resource = cacheResource("tajihelper_static");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("tajihelper_static");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("tutorial/taji_help/taji_help_003.png"), "textured");
 	}
 
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 	entity.emplace<UIComponent>();
 	entity.emplace<TutorialComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI_TUTORIAL1);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 	motion.scale = scale;
 
-	auto effect_anim = AnimationData("tajihelper_anim", uiPath("tutorial/taji_help/taji_help"), 10);
+	static const AnimationClip effect_anim("tajihelper_anim", uiPath("tutorial/taji_help/taji_help"), 10);
 	AnimationsComponent& anims = entity.emplace<AnimationsComponent>(AnimationType::EFFECT, std::make_shared<AnimationData>(effect_anim));
 	entity.emplace<TajiHelper>();
 
@@ -127,7 +130,7 @@ ECS::Entity TajiHelper::createTajiHelper(vec2 position, vec2 scale)
 
 ECS::Entity ClickFilter::createClickFilter(vec2 position, bool doAbsorbClick, bool isLarge, vec2 scale)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	void(*callback)() = []() {
 		std::cout << "Mouse click detected within click filter." << std::endl;
@@ -153,7 +156,7 @@ ECS::Entity ClickFilter::createClickFilter(vec2 position, bool doAbsorbClick, bo
 	if (isLarge)
 	{
 		ShadedMesh& resource = cacheResource("clickfilter_large");
-		if (resource.effect.program.resource == 0)
+		if (resource.effect.program == 0)
 		{
 			RenderSystem::createSprite(resource, uiPath("tutorial/clickfilter-large.png"), "textured");
 		}
@@ -163,7 +166,7 @@ ECS::Entity ClickFilter::createClickFilter(vec2 position, bool doAbsorbClick, bo
 	else
 	{
 		ShadedMesh& resource = cacheResource("clickfilter_small");
-		if (resource.effect.program.resource == 0)
+		if (resource.effect.program == 0)
 		{
 			RenderSystem::createSprite(resource, uiPath("tutorial/clickfilter-small.png"), "textured");
 		}
@@ -177,7 +180,7 @@ ECS::Entity ClickFilter::createClickFilter(vec2 position, bool doAbsorbClick, bo
 	entity.emplace<TutorialComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI_TUTORIAL2);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 	motion.scale = scale;
 
@@ -187,19 +190,20 @@ ECS::Entity ClickFilter::createClickFilter(vec2 position, bool doAbsorbClick, bo
 
 ECS::Entity HelpOverlay::createHelpOverlay(vec2 scale)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
-	ShadedMesh& resource = cacheResource("help_overlay");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("help_overlay");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("tutorial/help-overlay.png"), "textured");
 	}
 
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI_TUTORIAL1);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.scale = scale;
 	motion.position = vec2(683.f, 450.f);
 
@@ -210,12 +214,12 @@ ECS::Entity HelpOverlay::createHelpOverlay(vec2 scale)
 ECS::Entity HelpButton::createHelpButton(vec2 position)
 {
 	// There should only ever be one of this type of entity
-	while (!ECS::registry<HelpButton>.entities.empty())
+	while (!ECS::registry<HelpButton>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<HelpButton>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<HelpButton>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	void(*callback)() = []() {
 		std::cout << "Help button clicked." << std::endl;
@@ -229,18 +233,19 @@ ECS::Entity HelpButton::createHelpButton(vec2 position)
 		}
 	};
 
-	ShadedMesh& resource = cacheResource("help_button");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("help_button");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("tutorial/help-button.png"), "textured");
 	}
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 	entity.emplace<ClickableRectangleComponent>(position, resource.texture.size.x, resource.texture.size.y, callback);
 	entity.emplace<Button>();
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::HELP_BUTTON);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 
 	entity.emplace<HelpButton>();
@@ -250,29 +255,30 @@ ECS::Entity HelpButton::createHelpButton(vec2 position)
 ECS::Entity InspectButton::createInspectButton(vec2 position)
 {
 	// There should only ever be one of this type of entity
-	while (!ECS::registry<InspectButton>.entities.empty())
+	while (!ECS::registry<InspectButton>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<InspectButton>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<InspectButton>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
 	void(*callback)() = []() {
 		TutorialSystem::toggleInspectMode();
 	};
 
-	ShadedMesh& resource = cacheResource("inspect_button");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("inspect_button");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("tutorial/inspect-button.png"), "textured");
 	}
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 	entity.emplace<ClickableRectangleComponent>(position, resource.texture.size.x, resource.texture.size.y, callback);
 	entity.emplace<Button>();
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::HELP_BUTTON);
 
-	ECS::registry<Motion>.emplace(entity).position = position;
+	ECS::registry<Motion>().emplace(entity).position = position;
 
 	entity.emplace<InspectButton>();
 	return entity;
@@ -281,41 +287,43 @@ ECS::Entity InspectButton::createInspectButton(vec2 position)
 ECS::Entity ActiveArrow::createActiveArrow(vec2 position, vec2 scale)
 {
 	// There should only ever be one of this type of entity
-	while (!ECS::registry<ActiveArrow>.entities.empty())
+	while (!ECS::registry<ActiveArrow>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ActiveArrow>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ActiveArrow>().entities.back());
 	}
 
-	auto entity = ECS::Entity();
-	ShadedMesh& resource = cacheResource("active_arrow");
-	if (resource.effect.program.resource == 0)
+	auto entity = ECS::Entity::create();
+	static const ResourceId resourceId = internResource("active_arrow");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("active_arrow.png"), "textured");
 	}
 
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 	entity.emplace<RenderableComponent>(RenderLayer::UI);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 	motion.scale = scale;
 
-	ECS::registry<ActiveArrow>.emplace(entity);
+	ECS::registry<ActiveArrow>().emplace(entity);
 	return entity;
 }
 
 ECS::Entity AmbrosiaIcon::createAmbrosiaIcon(vec2 position, vec2 scale)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 
-	ShadedMesh& resource = cacheResource("ambrosia_icon");
-	if (resource.effect.program.resource == 0)
+	static const ResourceId resourceId = internResource("ambrosia_icon");
+	ShadedMesh& resource = cacheResource(resourceId);
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("ambrosia-icon.png"), "textured");
 	}
-	entity.emplace<ShadedMeshRef>(resource);
+	entity.emplace<ShadedMeshRef>(resourceId);
 
-	auto& motion = ECS::registry<Motion>.emplace(entity);
+	auto& motion = ECS::registry<Motion>().emplace(entity);
 	motion.position = position;
 	motion.scale = scale;
 
@@ -326,9 +334,9 @@ ECS::Entity AmbrosiaIcon::createAmbrosiaIcon(vec2 position, vec2 scale)
 ECS::Entity AmbrosiaDisplay::createAmbrosiaDisplay()
 {
 	// There should only ever be one of this type of entity
-	while (!ECS::registry<AmbrosiaDisplay>.entities.empty())
+	while (!ECS::registry<AmbrosiaDisplay>().entities.empty())
 	{
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<AmbrosiaDisplay>.entities.back());
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<AmbrosiaDisplay>().entities.back());
 	}
 
 	static constexpr vec2 AMBROSIA_SCALE(0.8f);
@@ -343,9 +351,9 @@ ECS::Entity AmbrosiaDisplay::createAmbrosiaDisplay()
 
 ECS::Entity MobCard::createMobCard(vec2 position, const std::string& mobType)
 {
-	auto entity = ECS::Entity();
+	auto entity = ECS::Entity::create();
 	ShadedMesh& resource = cacheResource(mobType + "_card");
-	if (resource.effect.program.resource == 0)
+	if (resource.effect.program == 0)
 	{
 		RenderSystem::createSprite(resource, uiPath("mob_cards/" + mobType + ".png"), "textured");
 	}
@@ -354,7 +362,7 @@ ECS::Entity MobCard::createMobCard(vec2 position, const std::string& mobType)
 	entity.emplace<UIComponent>();
 	entity.emplace<RenderableComponent>(RenderLayer::UI_TUTORIAL1);
 
-	ECS::registry<Motion>.emplace(entity).position = position;
+	ECS::registry<Motion>().emplace(entity).position = position;
 
 	entity.emplace<MobCard>();
 	return entity;
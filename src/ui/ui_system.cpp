@@ -1,6 +1,7 @@
 #include "ui_system.hpp"
 #include "game/camera.hpp"
 #include "game/game_state_system.hpp"
+#include "entities/command_buffer.hpp"
 #include "rendering/text.hpp"
 #include <iostream>
 
@@ -82,7 +83,7 @@ UISystem::~UISystem()
 
 void UISystem::step(float elapsed_ms) {
 	// Remove damage number once timer expires
-	for (auto entity : ECS::registry<TimedUIComponent>.entities) {
+	for (auto entity : ECS::registry<TimedUIComponent>().entities) {
 		auto& timedUIComponent = entity.get<TimedUIComponent>();
 		timedUIComponent.timerMs -= elapsed_ms;
 
@@ -95,7 +96,7 @@ void UISystem::step(float elapsed_ms) {
 				launchAmbrosiaProjectile(entity, ambrosiaAmount);
 			}
 
-			ECS::ContainerInterface::removeAllComponentsOf(entity);
+			ECS::CommandBuffer::instance().destroy(entity);
 		}
 	}
 }
@@ -103,10 +104,7 @@ void UISystem::step(float elapsed_ms) {
 void UISystem::createCentralMessage(const std::string& text, float durationMS)
 {
 	// Only show the most current message at any one time
-	for (auto& entity : ECS::registry<CentralMessageComponent>.entities)
-	{
-		ECS::ContainerInterface::removeAllComponentsOf(entity);
-	}
+	ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<CentralMessageComponent>().entities);
 
 	auto str_len = text.length();
 	int firstUnprintedChar = 0;
@@ -172,10 +170,10 @@ void UISystem::onMouseClick(const RawMouseClickEvent& event)
 	playMouseClickFX(event.mousePos);
 
 	// Filters mouse clicks through ClickFilters first - only clicks within a filter can continue
-	if (!ECS::registry<ClickFilter>.entities.empty())
+	if (!ECS::registry<ClickFilter>().entities.empty())
 	{
 		bool didPassFilter = false;
-		for (auto entity : ECS::registry<ClickFilter>.entities)
+		for (auto entity : ECS::registry<ClickFilter>().entities)
 		{
 			// filters can "absorb" clicks, in which case they are handled by the filter callback and not passed further
 			// create a copy in case handling the click removes the filter
@@ -194,9 +192,9 @@ void UISystem::onMouseClick(const RawMouseClickEvent& event)
 	}
 
 	// When in help overlay, only listen for clicks on the help button
-	if (!ECS::registry<HelpOverlay>.entities.empty())
+	if (!ECS::registry<HelpOverlay>().entities.empty())
 	{
-		for (auto entity : ECS::registry<HelpButton>.entities)
+		for (auto entity : ECS::registry<HelpButton>().entities)
 		{
 			handleClick<ClickableRectangleComponent>(entity, event);
 		}
@@ -206,7 +204,7 @@ void UISystem::onMouseClick(const RawMouseClickEvent& event)
 	// When in inspect mode
 	if (GameStateSystem::instance().isInspecting)
 	{
-		for (auto entity : ECS::registry<InspectButton>.entities)
+		for (auto entity : ECS::registry<InspectButton>().entities)
 		{
 			handleClick<ClickableRectangleComponent>(entity, event);
 		}
@@ -214,7 +212,7 @@ void UISystem::onMouseClick(const RawMouseClickEvent& event)
 	}
 
 	// Handles if any button entities are clicked
-	for (auto entity : ECS::registry<Button>.entities) {
+	for (auto entity : ECS::registry<Button>().entities) {
 		if (handleClick<ClickableCircleComponent>(entity, event)) {
 			return;
 		}
@@ -223,38 +221,38 @@ void UISystem::onMouseClick(const RawMouseClickEvent& event)
 		}
 	}
 
-	for (auto entity : ECS::registry<SkillButton>.entities) {
+	for (auto entity : ECS::registry<SkillButton>().entities) {
 		if (handleClick<ClickableCircleComponent>(entity, event)) {
 			return;
 		}
 	}
 
-	for (auto entity : ECS::registry<UpgradeButton>.entities) {
+	for (auto entity : ECS::registry<UpgradeButton>().entities) {
 		if (handleClick<ClickableCircleComponent>(entity, event)) {
 			return;
 		}
 	}
 
 	// Sends a MouseClickEvent to event system if no buttons are clicked, takes into account the camera position
-	assert(!ECS::registry<CameraComponent>.entities.empty());
-	auto camera = ECS::registry<CameraComponent>.entities[0];
+	assert(!ECS::registry<CameraComponent>().entities.empty());
+	auto camera = ECS::registry<CameraComponent>().entities[0];
 	auto& cameraPos = camera.get<CameraComponent>().position;
 	EventSystem<MouseClickEvent>::instance().sendEvent(MouseClickEvent{ event.mousePos + cameraPos });
 }
 
 void UISystem::enableMoveButton(bool doEnable)
 {
-	auto& moveButtonState = ECS::registry<MoveButtonComponent>.entities.front().get<ButtonStateComponent>();
+	auto& moveButtonState = ECS::registry<MoveButtonComponent>().entities.front().get<ButtonStateComponent>();
 	moveButtonState.isDisabled = !doEnable;
 	moveButtonState.isActive = false;
-	assert(ECS::registry<ActiveSkillFX>.entities.size() > 0);
-	auto& activeFX = ECS::registry<ActiveSkillFX>.entities.front();
+	assert(ECS::registry<ActiveSkillFX>().entities.size() > 0);
+	auto& activeFX = ECS::registry<ActiveSkillFX>().entities.front();
 	activeFX.get<VisibilityComponent>().isVisible = false;
 }
 
 void UISystem::enableSkillButtons(bool doEnable)
 {
-	for (auto& entity : ECS::registry<SkillButton>.entities)
+	for (auto& entity : ECS::registry<SkillButton>().entities)
 	{
 		assert(entity.has<ButtonStateComponent>() && entity.has<SkillInfoComponent>());
 		auto& buttonState = entity.get<ButtonStateComponent>();
@@ -265,8 +263,8 @@ void UISystem::enableSkillButtons(bool doEnable)
 		}
 	}
 
-	assert(ECS::registry<ActiveSkillFX>.entities.size() > 0);
-	auto& activeFX = ECS::registry<ActiveSkillFX>.entities.front();
+	assert(ECS::registry<ActiveSkillFX>().entities.size() > 0);
+	auto& activeFX = ECS::registry<ActiveSkillFX>().entities.front();
 	activeFX.get<VisibilityComponent>().isVisible = false;
 }
 
@@ -284,7 +282,7 @@ void UISystem::updatePlayerSkillButton(ECS::Entity& entity)
 		}
 
 		// update the button textures to that player
-		for (auto& buttonInfo : ECS::registry<SkillInfoComponent>.components)
+		for (auto& buttonInfo : ECS::registry<SkillInfoComponent>().components)
 		{
 			buttonInfo.player = player;
 		}
@@ -317,8 +315,8 @@ void UISystem::onMoveFinished(const FinishedMovementEvent& event)
 	{
 		enableMoveButton(false);
 		enableSkillButtons(true);
-		assert(ECS::registry<ActiveSkillFX>.entities.size() > 0);
-		auto& activeFX = ECS::registry<ActiveSkillFX>.entities.front();
+		assert(ECS::registry<ActiveSkillFX>().entities.size() > 0);
+		auto& activeFX = ECS::registry<ActiveSkillFX>().entities.front();
 		activeFX.get<VisibilityComponent>().isVisible = false;
 	}
 }
@@ -331,14 +329,14 @@ void UISystem::onPlayerChange(const PlayerChangeEvent& event)
 	updatePlayerSkillButton(newPlayer);
 
 	// Go through all the buttons and update their animations
-	for (auto playerButton : ECS::registry<PlayerButtonComponent>.entities)
+	for (auto playerButton : ECS::registry<PlayerButtonComponent>().entities)
 	{
 		auto& animComponent = playerButton.get<AnimationsComponent>();
 		auto& playerButtonComponent = playerButton.get<PlayerButtonComponent>();
 
 		// Find the player associated with this button
 		bool playerFound = false;
-		for (auto player : ECS::registry<PlayerComponent>.entities)
+		for (auto player : ECS::registry<PlayerComponent>().entities)
 		{
 			auto& playerComponent = player.get<PlayerComponent>();
 
@@ -375,12 +373,12 @@ void UISystem::onPlayerChange(const PlayerChangeEvent& event)
 	}
 
 	// Create active arrow when a player is active
-	if (newPlayer.has<PlayerComponent>() && ECS::registry<ActiveArrow>.entities.empty()) {
+	if (newPlayer.has<PlayerComponent>() && ECS::registry<ActiveArrow>().entities.empty()) {
 		ActiveArrow::createActiveArrow();
 	}
 	// Remove active arrow when a mob is active
-	else if (!newPlayer.has<PlayerComponent>() && !ECS::registry<ActiveArrow>.entities.empty()) {
-		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ActiveArrow>.entities.back());
+	else if (!newPlayer.has<PlayerComponent>() && !ECS::registry<ActiveArrow>().entities.empty()) {
+		ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ActiveArrow>().entities.back());
 	}
 
 	int tutorialIndex = GameStateSystem::instance().currentTutorialIndex;
@@ -395,11 +393,11 @@ ECS::Entity& UISystem::getToolTip(SkillType skill)
 {
 	if (skill == SkillType::MOVE)
 	{
-		assert(ECS::registry<MoveToolTipComponent>.size() > 0);
-		return ECS::registry<MoveToolTipComponent>.entities.front();
+		assert(ECS::registry<MoveToolTipComponent>().size() > 0);
+		return ECS::registry<MoveToolTipComponent>().entities.front();
 	}
 
-	for (auto& entity : ECS::registry<ToolTip>.entities)
+	for (auto& entity : ECS::registry<ToolTip>().entities)
 	{
 		auto skillInfo = entity.get<SkillInfoComponent>();
 		if (skillInfo.skillType == skill)
@@ -409,13 +407,13 @@ ECS::Entity& UISystem::getToolTip(SkillType skill)
 	}
 
 	// temporary default tooltip
-	assert(ECS::registry<MoveToolTipComponent>.size() > 0);
-	return ECS::registry<MoveToolTipComponent>.entities.front();
+	assert(ECS::registry<MoveToolTipComponent>().size() > 0);
+	return ECS::registry<MoveToolTipComponent>().entities.front();
 }
 
 void UISystem::clearToolTips()
 {
-	for (auto entity : ECS::registry<ToolTip>.entities)
+	for (auto entity : ECS::registry<ToolTip>().entities)
 	{
 		if (entity.has<VisibilityComponent>())
 		{
@@ -423,17 +421,14 @@ void UISystem::clearToolTips()
 		}
 	}
 
-	for (auto entity : ECS::registry<ToolTipText>.entities)
-	{
-		ECS::ContainerInterface::removeAllComponentsOf(entity);
-	}
+	ECS::ContainerInterface::removeAllComponentsOf(ECS::registry<ToolTipText>().entities);
 }
 
 void UISystem::onMouseHover(const RawMouseHoverEvent& event)
 {
 	clearToolTips();
 	bool didTriggerTooltip = false;
-	for (auto entity : ECS::registry<SkillButton>.entities) {
+	for (auto entity : ECS::registry<SkillButton>().entities) {
 		assert(entity.has<ClickableCircleComponent>());
 
 		auto& clickableArea = entity.get<ClickableCircleComponent>();
@@ -453,15 +448,15 @@ void UISystem::onMouseHover(const RawMouseHoverEvent& event)
 	}
 
 	// Sends a MouseHoverEvent to event system that takes into account the camera position
-	assert(!ECS::registry<CameraComponent>.entities.empty());
-	auto camera = ECS::registry<CameraComponent>.entities[0];
+	assert(!ECS::registry<CameraComponent>().entities.empty());
+	auto camera = ECS::registry<CameraComponent>().entities[0];
 	auto& cameraPos = camera.get<CameraComponent>().position;
 	EventSystem<MouseHoverEvent>::instance().sendEvent(MouseHoverEvent{ event.mousePos + cameraPos });
 }
 
 void UISystem::renderToolTipNumbers(const SkillType& skillType)
 {
-	ECS::Entity activePlayer = ECS::registry<TurnSystem::TurnComponentIsActive>.entities[0];
+	ECS::Entity activePlayer = ECS::registry<TurnSystem::TurnComponentIsActive>().entities[0];
 
 	if (!activePlayer.has<PlayerComponent>() || activePlayer.has<DeathTimer>()
 		|| !activePlayer.has<SkillComponent>() || !activePlayer.has<StatsComponent>())
@@ -574,7 +569,7 @@ void UISystem::renderToolTipNumbers(const SkillType& skillType)
 
 void UISystem::activateSkillButton(const SkillType& skillType)
 {
-	for (auto& entity : ECS::registry<SkillButton>.entities)
+	for (auto& entity : ECS::registry<SkillButton>().entities)
 	{
 		assert(entity.has<SkillInfoComponent>() && entity.has<ButtonStateComponent>());
 		auto skillInfo = entity.get<SkillInfoComponent>();
@@ -583,8 +578,8 @@ void UISystem::activateSkillButton(const SkillType& skillType)
 		{
 			buttonState.isActive = true;
 
-			assert(ECS::registry<ActiveSkillFX>.entities.size() > 0);
-			auto& activeFX = ECS::registry<ActiveSkillFX>.entities.front();
+			assert(ECS::registry<ActiveSkillFX>().entities.size() > 0);
+			auto& activeFX = ECS::registry<ActiveSkillFX>().entities.front();
 			activeFX.get<Motion>().position = entity.get<Motion>().position;
 			activeFX.get<VisibilityComponent>().isVisible = true;
 		}
@@ -614,7 +609,7 @@ void UISystem::onSkillFinished(const FinishedSkillEvent& event)
 		return;
 	}
 
-	for (auto& entity : ECS::registry<SkillButton>.entities)
+	for (auto& entity : ECS::registry<SkillButton>().entities)
 	{
 		assert(entity.has<ButtonStateComponent>());
 		auto& buttonState = entity.get<ButtonStateComponent>();
@@ -622,8 +617,8 @@ void UISystem::onSkillFinished(const FinishedSkillEvent& event)
 		{
 			buttonState.isActive = false;
 
-			assert(ECS::registry<ActiveSkillFX>.entities.size() > 0);
-			auto& activeFX = ECS::registry<ActiveSkillFX>.entities.front();
+			assert(ECS::registry<ActiveSkillFX>().entities.size() > 0);
+			auto& activeFX = ECS::registry<ActiveSkillFX>().entities.front();
 			activeFX.get<VisibilityComponent>().isVisible = false;
 		}
 	}
@@ -690,7 +685,7 @@ void UISystem::createAmbrosiaNumber(ECS::Entity entity, int value)
 
 void UISystem::launchAmbrosiaProjectile(ECS::Entity entity, int value)
 {
-	if (ECS::registry<AmbrosiaDisplay>.entities.empty())
+	if (ECS::registry<AmbrosiaDisplay>().entities.empty())
 	{
 		return;
 	}
@@ -702,9 +697,9 @@ void UISystem::launchAmbrosiaProjectile(ECS::Entity entity, int value)
 
 	auto getAmbrosiaDisplayPos = []() -> vec2
 	{
-		if (!ECS::registry<CameraComponent>.entities.empty())
+		if (!ECS::registry<CameraComponent>().entities.empty())
 		{
-			auto camera = ECS::registry<CameraComponent>.entities.front();
+			auto camera = ECS::registry<CameraComponent>().entities.front();
 			auto cameraPos = camera.get<CameraComponent>().position;
 			return cameraPos + AMBROSIA_DISPLAY_OFFSET;
 		}
@@ -726,7 +721,7 @@ void UISystem::launchAmbrosiaProjectile(ECS::Entity entity, int value)
 
 void UISystem::playMouseClickFX(vec2 position)
 {
-	for (auto& entity : ECS::registry<MouseClickFX>.entities)
+	for (auto& entity : ECS::registry<MouseClickFX>().entities)
 	{
 		if (entity.has<AnimationsComponent>() && entity.has<Motion>())
 		{